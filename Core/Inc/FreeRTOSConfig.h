@@ -171,6 +171,35 @@ standard names. */
 /* 关闭时间片轮转 - 相同优先级的任务不会轮转执行 */
 #define configUSE_TIME_SLICING                   0
 
+/* 运行时间统计：使用hptimer的TIM2（1MHz 32位自由计数，调度器启动前已开启），计数回绕由统计方按差值处理 */
+#define configGENERATE_RUN_TIME_STATS            1
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  #include CMSIS_device_header
+  extern volatile uint32_t sysMonSwitchCount[];
+#endif
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()         (TIM2->CNT)
+/* 每个任务的切入次数，按TCB序号计数（sys_mon.c） */
+#define SYS_MON_SWITCH_SLOTS                     32
+#define traceTASK_SWITCHED_IN()                  sysMonSwitchCount[pxCurrentTCB->uxTCBNumber & (SYS_MON_SWITCH_SLOTS - 1)]++
+
+/* 堆分配统计（CMake HEAP_PROFILE），heap_4在挂起调度器期间调用 */
+#if HEAP_PROFILE
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  #include <stddef.h>
+  void HeapProf_OnMalloc(void *ptr, size_t size);
+  void HeapProf_OnFree(void *ptr, size_t size);
+#endif
+#define traceMALLOC(pvAddress, uiSize)           HeapProf_OnMalloc(pvAddress, uiSize)
+#define traceFREE(pvAddress, uiSize)             HeapProf_OnFree(pvAddress, uiSize)
+#endif
+
+/* 静态分配模式（CMake RTOS_STATIC_ALLOC）：约100KB任务栈、队列与数据包池移到.bss.rtos_static，堆相应缩小 */
+#if RTOS_STATIC_ALLOC
+#undef configTOTAL_HEAP_SIZE
+#define configTOTAL_HEAP_SIZE                    ((size_t)400*1024)
+#endif
+
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
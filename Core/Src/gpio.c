@@ -104,6 +104,8 @@ void MX_GPIO_Init(void)
 
 /* USER CODE BEGIN 2 */
 
+#if UWB_CHIP_TYPE_CX310
+/* DW1000 builds use the EXTI callback in User/Dw1000/platform/port.c */
 void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
 {
   if (GPIO_Pin == UWB_INT_Pin)
@@ -112,5 +114,6 @@ void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
     uwb_int_handler_wrapper();
   }
 }
+#endif
 
 /* USER CODE END 2 */
@@ -29,6 +29,7 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "elog.h"
+#include "hptimer.hpp"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -63,8 +64,8 @@ void MX_FREERTOS_Init(void);
 /* USER CODE BEGIN 0 */
 void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) {
     if (huart->Instance == huart8.Instance) {
-        extern osSemaphoreId_t elog_dma_lockHandle;
-        osSemaphoreRelease(elog_dma_lockHandle);
+        extern void elog_port_dma_tx_cplt(void);
+        elog_port_dma_tx_cplt();
     }
 }
 
@@ -115,7 +116,7 @@ int main(void)
 
   elog_start();
 
-  HAL_TIM_Base_Start(&htim2);
+  hal_hptimer_init();
 
   /* USER CODE END 2 */
 
@@ -0,0 +1,334 @@
+/**
+ * @file SpscRing.h
+ * @brief Lock-free single producer / single consumer rings
+ *
+ * SpscRing<T, N> passes trivially copyable items and ByteRing<N> passes a byte stream from one producer to one
+ * consumer without any kernel call or critical section. Either side may run in an ISR.
+ *
+ * The producer publishes by storing the head index with release ordering, the consumer frees by storing the tail
+ * index with release ordering. The indexes are free running 32-bit counters, so N must be a power of 2 and all N
+ * slots are usable.
+ *
+ * When the FreeRTOS headers are available the consumer task can optionally be woken by a task notification. The
+ * producer only notifies when it pushes into an empty ring, so a burst costs one kernel call instead of one per item.
+ * Without FreeRTOS (host builds) the rings are plain lock-free containers.
+ *
+ * @ingroup FreeRTOSCpp
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @def FREERTOSCPP_RING_NOTIFY
+ * If non-zero, the rings support waking the consumer task with a task notification.
+ * Defaults to 1 when the FreeRTOS headers can be found.
+ *
+ * @def FREERTOSCPP_CACHE_LINE
+ * Alignment used to keep the producer and consumer indexes apart. Cortex-M has no data cache, so only word
+ * alignment is used there to save RAM, hosts use 64 bytes to avoid false sharing between cores.
+ *
+ * @ingroup FreeRTOSCpp
+ */
+#ifndef FREERTOSCPP_RING_NOTIFY
+#if defined(__has_include)
+#if __has_include("FreeRTOS.h") && __has_include("task.h")
+#define FREERTOSCPP_RING_NOTIFY 1
+#endif
+#endif
+#endif
+#ifndef FREERTOSCPP_RING_NOTIFY
+#define FREERTOSCPP_RING_NOTIFY 0
+#endif
+
+#ifndef FREERTOSCPP_CACHE_LINE
+#if defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_6M__) || defined(__ARM_ARCH_8M_MAIN__)
+#define FREERTOSCPP_CACHE_LINE 4
+#else
+#define FREERTOSCPP_CACHE_LINE 64
+#endif
+#endif
+
+#if FREERTOSCPP_RING_NOTIFY
+#include "FreeRTOS.h"
+#include "task.h"
+#endif
+
+#ifndef FREERTOSCPP_USE_NAMESPACE
+#define FREERTOSCPP_USE_NAMESPACE 2
+#endif
+
+#if FREERTOSCPP_USE_NAMESPACE
+namespace FreeRTOScpp {
+#endif
+
+/**
+ * @brief Index handling shared by SpscRing and ByteRing.
+ *
+ * Producer side: freeSpace(), commit(). Consumer side: usedSpace(), release(), wait().
+ */
+class SpscRingBase {
+public:
+    SpscRingBase() {}
+    SpscRingBase(SpscRingBase const&) = delete;
+    SpscRingBase& operator=(SpscRingBase const&) = delete;
+
+#if FREERTOSCPP_RING_NOTIFY
+    /**
+     * @brief Set the task woken by the producer.
+     *
+     * @param task The consumer task, nullptr to stop notifications.
+     *
+     * The consumer uses the notification value of index 0 (ulTaskNotifyTake), it must not use it for anything else.
+     */
+    void setConsumer(TaskHandle_t task) { consumer = task; }
+
+    /**
+     * @brief Block the consumer task until the ring has data.
+     *
+     * Only call from the task given to setConsumer(), after it has drained the ring.
+     *
+     * @param delay Maximum time to wait in ticks.
+     * @return True if the ring has data.
+     */
+    bool wait(TickType_t delay = portMAX_DELAY) {
+        // pairs with the fence in commit(): either the producer sees the ring empty and notifies, or we see its data
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (head.load(std::memory_order_acquire) != tail.load(std::memory_order_relaxed)) {
+            return true;
+        }
+        ulTaskNotifyTake(pdTRUE, delay);
+        return head.load(std::memory_order_acquire) != tail.load(std::memory_order_relaxed);
+    }
+#endif
+
+protected:
+#if FREERTOSCPP_RING_NOTIFY
+    typedef BaseType_t* BaseTypeArg;
+#else
+    typedef void* BaseTypeArg;
+#endif
+
+    /// Free slots as seen by the producer.
+    uint32_t freeSpace(uint32_t size, uint32_t h) const { return size - (h - tail.load(std::memory_order_acquire)); }
+
+    /// Used slots as seen by the consumer.
+    uint32_t usedSpace(uint32_t t) const { return head.load(std::memory_order_acquire) - t; }
+
+    /**
+     * @brief Publish count slots written by the producer and wake the consumer if the ring was empty.
+     *
+     * @param wasWoken nullptr in task context, otherwise the ISR yield flag.
+     */
+    void commit(uint32_t h, uint32_t count, BaseTypeArg wasWoken) {
+        head.store(h + count, std::memory_order_release);
+#if FREERTOSCPP_RING_NOTIFY
+        TaskHandle_t task = consumer;
+        if (task == nullptr) {
+            return;
+        }
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (tail.load(std::memory_order_relaxed) == h) {
+            if (wasWoken) {
+                vTaskNotifyGiveFromISR(task, wasWoken);
+            } else {
+                xTaskNotifyGive(task);
+            }
+        }
+#else
+        (void)wasWoken;
+#endif
+    }
+
+    /// Free count slots read by the consumer.
+    void release(uint32_t t, uint32_t count) { tail.store(t + count, std::memory_order_release); }
+
+    alignas(FREERTOSCPP_CACHE_LINE) std::atomic<uint32_t> head{0}; ///< Written by the producer only.
+    alignas(FREERTOSCPP_CACHE_LINE) std::atomic<uint32_t> tail{0}; ///< Written by the consumer only.
+#if FREERTOSCPP_RING_NOTIFY
+    TaskHandle_t volatile consumer = nullptr;
+#endif
+};
+
+/**
+ * @brief Lock-free ring of items.
+ *
+ * @tparam T Item type, must be trivially copyable.
+ * @tparam N Number of items, must be a power of 2.
+ *
+ * push() must only be called by one producer and pop() by one consumer, each of them may be a task or an ISR.
+ * The _ISR variants only differ in how the consumer task is woken.
+ */
+template <class T, uint32_t N> class SpscRing : public SpscRingBase {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing size must be a power of 2");
+    static_assert(std::is_trivially_copyable<T>::value, "SpscRing items must be trivially copyable");
+
+public:
+    SpscRing() {}
+
+    /// @brief Push one item. @return False if the ring is full.
+    bool push(T const& item) { return push(&item, 1) == 1; }
+
+    /// @brief Push up to count items. @return The number of items pushed.
+    uint32_t push(T const* items, uint32_t count) { return pushItems(items, count, nullptr); }
+
+#if FREERTOSCPP_RING_NOTIFY
+    bool push_ISR(T const& item, BaseType_t& wasWoken) { return pushItems(&item, 1, &wasWoken) == 1; }
+    uint32_t push_ISR(T const* items, uint32_t count, BaseType_t& wasWoken) {
+        return pushItems(items, count, &wasWoken);
+    }
+#endif
+
+    /// @brief Pop one item. @return False if the ring is empty.
+    bool pop(T& item) { return pop(&item, 1) == 1; }
+
+    /// @brief Pop up to count items. @return The number of items popped.
+    uint32_t pop(T* items, uint32_t count) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        uint32_t used = usedSpace(t);
+        if (count > used) {
+            count = used;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            items[i] = buffer[(t + i) & (N - 1)];
+        }
+        release(t, count);
+        return count;
+    }
+
+    /// @brief Look at the oldest item without removing it. @return nullptr if the ring is empty.
+    T const* peek() const {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        return usedSpace(t) ? &buffer[t & (N - 1)] : nullptr;
+    }
+
+    /// @brief Number of items waiting, the consumer can pop at least this many.
+    uint32_t waiting() const { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire); }
+
+    /// @brief Number of free slots, the producer can push at least this many.
+    uint32_t available() const { return N - waiting(); }
+
+    bool isEmpty() const { return waiting() == 0; }
+    bool isFull() const { return waiting() == N; }
+    static constexpr uint32_t capacity() { return N; }
+
+private:
+    uint32_t pushItems(T const* items, uint32_t count, BaseTypeArg wasWoken) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        uint32_t space = freeSpace(N, h);
+        if (count > space) {
+            count = space;
+        }
+        if (count == 0) {
+            return 0;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            buffer[(h + i) & (N - 1)] = items[i];
+        }
+        commit(h, count, wasWoken);
+        return count;
+    }
+
+    T buffer[N];
+};
+
+/**
+ * @brief Lock-free byte stream ring.
+ *
+ * @tparam N Size in bytes, must be a power of 2.
+ *
+ * write() and read() copy with at most two memcpy calls. readRegion() and consume() let the consumer process data
+ * in place.
+ */
+template <uint32_t N> class ByteRing : public SpscRingBase {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "ByteRing size must be a power of 2");
+
+public:
+    ByteRing() {}
+
+    /// @brief Write up to len bytes. @return The number of bytes written.
+    uint32_t write(void const* data, uint32_t len) { return writeBytes(data, len, nullptr); }
+
+#if FREERTOSCPP_RING_NOTIFY
+    uint32_t write_ISR(void const* data, uint32_t len, BaseType_t& wasWoken) {
+        return writeBytes(data, len, &wasWoken);
+    }
+#endif
+
+    /// @brief Read up to len bytes. @return The number of bytes read.
+    uint32_t read(void* data, uint32_t len) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        uint32_t used = usedSpace(t);
+        if (len > used) {
+            len = used;
+        }
+        copyOut(static_cast<uint8_t*>(data), t, len);
+        release(t, len);
+        return len;
+    }
+
+    /**
+     * @brief Get the contiguous readable region starting at the oldest byte.
+     *
+     * @param data Set to the first readable byte.
+     * @return Number of contiguous bytes, the rest (if any) starts at the beginning of the buffer.
+     */
+    uint32_t readRegion(uint8_t const*& data) const {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        uint32_t used = usedSpace(t);
+        uint32_t offset = t & (N - 1);
+        data = &buffer[offset];
+        return used < N - offset ? used : N - offset;
+    }
+
+    /// @brief Drop len bytes already processed through readRegion().
+    void consume(uint32_t len) { release(tail.load(std::memory_order_relaxed), len); }
+
+    uint32_t waiting() const { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire); }
+    uint32_t available() const { return N - waiting(); }
+    bool isEmpty() const { return waiting() == 0; }
+    bool isFull() const { return waiting() == N; }
+    static constexpr uint32_t capacity() { return N; }
+
+private:
+    uint32_t writeBytes(void const* data, uint32_t len, BaseTypeArg wasWoken) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        uint32_t space = freeSpace(N, h);
+        if (len > space) {
+            len = space;
+        }
+        if (len == 0) {
+            return 0;
+        }
+        uint32_t offset = h & (N - 1);
+        uint32_t first = len < N - offset ? len : N - offset;
+        memcpy(&buffer[offset], data, first);
+        memcpy(&buffer[0], static_cast<uint8_t const*>(data) + first, len - first);
+        commit(h, len, wasWoken);
+        return len;
+    }
+
+    void copyOut(uint8_t* data, uint32_t t, uint32_t len) const {
+        uint32_t offset = t & (N - 1);
+        uint32_t first = len < N - offset ? len : N - offset;
+        memcpy(data, &buffer[offset], first);
+        memcpy(data + first, &buffer[0], len - first);
+    }
+
+    uint8_t buffer[N];
+};
+
+#if FREERTOSCPP_USE_NAMESPACE
+} // namespace FreeRTOScpp
+#if FREERTOSCPP_USE_NAMESPACE == 2
+using namespace FreeRTOScpp;
+#endif
+#endif
+
+#endif
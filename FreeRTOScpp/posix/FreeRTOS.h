@@ -0,0 +1,123 @@
+/**
+ * @file posix/FreeRTOS.h
+ * @brief FreeRTOS kernel subset for host builds (POSIX port)
+ *
+ * Selected with FREERTOSCPP_PORT=POSIX in CMake. This directory is searched before the normal include
+ * directory, so FreeRTOS.h, task.h, TaskCPP.h, MutexCPP.h and SemaphoreCPP.h resolve to the host versions,
+ * while FreeRTOScpp.h, Lock.h and SpscRing.h are shared with the target build.
+ *
+ * Only what the application layer uses is provided: tasks on std::thread with the index 0 notification,
+ * delays, the tick count, critical sections and scheduler suspension as one global recursive mutex, and
+ * pvPortMalloc() on malloc() with heap_4 style free space accounting. Priorities are recorded but not
+ * applied, all threads run under the normal Linux scheduler.
+ *
+ * The application provides FreeRTOSConfig.h as on target, anything it leaves out gets the default below.
+ *
+ * @ingroup FreeRTOSCpp
+ */
+
+#ifndef INC_FREERTOS_H
+#define INC_FREERTOS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FreeRTOSConfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Same widths as the Cortex-M port, so that structures shared with the target keep their layout. */
+#define portCHAR        char
+#define portFLOAT       float
+#define portDOUBLE      double
+#define portLONG        long
+#define portSHORT       short
+#define portSTACK_TYPE  uint32_t
+#define portBASE_TYPE   long
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define portMAX_DELAY               (TickType_t)0xffffffffUL
+#define portTICK_TYPE_IS_ATOMIC     1
+#define portBYTE_ALIGNMENT          8
+#define portTICK_PERIOD_MS          ((TickType_t)1000 / configTICK_RATE_HZ)
+#define portYIELD_FROM_ISR(x)       ((void)(x))
+#define portEND_SWITCHING_ISR(x)    ((void)(x))
+
+#define pdFALSE         ((BaseType_t)0)
+#define pdTRUE          ((BaseType_t)1)
+#define pdPASS          (pdTRUE)
+#define pdFAIL          (pdFALSE)
+#define errQUEUE_EMPTY  ((BaseType_t)0)
+#define errQUEUE_FULL   ((BaseType_t)0)
+
+#ifndef pdMS_TO_TICKS
+#define pdMS_TO_TICKS(xTimeInMs) ((TickType_t)(((TickType_t)(xTimeInMs) * (TickType_t)configTICK_RATE_HZ) / (TickType_t)1000))
+#endif
+
+#ifndef configTICK_RATE_HZ
+#define configTICK_RATE_HZ                      ((TickType_t)1000)
+#endif
+#ifndef configMAX_PRIORITIES
+#define configMAX_PRIORITIES                    (56)
+#endif
+#ifndef configMAX_TASK_NAME_LEN
+#define configMAX_TASK_NAME_LEN                 (16)
+#endif
+#ifndef configTOTAL_HEAP_SIZE
+#define configTOTAL_HEAP_SIZE                   ((size_t)64 * 1024)
+#endif
+#ifndef configSTACK_DEPTH_TYPE
+#define configSTACK_DEPTH_TYPE                  uint16_t
+#endif
+#ifndef configUSE_RECURSIVE_MUTEXES
+#define configUSE_RECURSIVE_MUTEXES             1
+#endif
+#ifndef configUSE_TRACE_FACILITY
+#define configUSE_TRACE_FACILITY                1
+#endif
+#ifndef configGENERATE_RUN_TIME_STATS
+#define configGENERATE_RUN_TIME_STATS           1
+#endif
+#ifndef configIDLE_TASK_NAME
+#define configIDLE_TASK_NAME                    "IDLE"
+#endif
+/* kernel objects are always allocated by the port, the StaticXxx_t buffers don't exist on the host */
+#undef configSUPPORT_STATIC_ALLOCATION
+#define configSUPPORT_STATIC_ALLOCATION         0
+#undef configSUPPORT_DYNAMIC_ALLOCATION
+#define configSUPPORT_DYNAMIC_ALLOCATION        1
+#ifndef configQUEUE_REGISTRY_SIZE
+#define configQUEUE_REGISTRY_SIZE               0
+#endif
+#ifndef INCLUDE_vTaskDelete
+#define INCLUDE_vTaskDelete                     1
+#endif
+#ifndef INCLUDE_vTaskDelayUntil
+#define INCLUDE_vTaskDelayUntil                 1
+#endif
+#ifndef INCLUDE_uxTaskPriorityGet
+#define INCLUDE_uxTaskPriorityGet               1
+#endif
+
+#ifndef configASSERT
+#include <assert.h>
+#define configASSERT(x) assert(x)
+#endif
+
+/* Heap: malloc() underneath, free space is counted against configTOTAL_HEAP_SIZE like heap_4 reports it. */
+void *pvPortMalloc(size_t xSize);
+void vPortFree(void *pv);
+size_t xPortGetFreeHeapSize(void);
+size_t xPortGetMinimumEverFreeHeapSize(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_FREERTOS_H */
@@ -0,0 +1,100 @@
+/**
+ * @file posix/MutexCPP.h
+ * @brief Mutex wrappers for host builds (POSIX port)
+ *
+ * Same interface as include/MutexCPP.h, built on std::timed_mutex and std::recursive_timed_mutex so that
+ * ThreadSanitizer and helgrind understand the locking. As on target, only the task that took the mutex may
+ * give it back.
+ *
+ * @ingroup FreeRTOSCpp
+ */
+
+#ifndef MUTEXCPP_H
+#define MUTEXCPP_H
+
+#include <chrono>
+#include <mutex>
+
+#include "FreeRTOScpp.h"
+#include "Lock.h"
+
+#if FREERTOSCPP_USE_NAMESPACE
+namespace FreeRTOScpp {
+#endif
+
+/**
+ * @brief Take a std timed mutex with a FreeRTOS style timeout.
+ */
+template<class M> inline bool mutexTakeTicks(M& mutex, TickType_t wait) {
+	if(wait == portMAX_DELAY) {
+		mutex.lock();
+		return true;
+	}
+	if(wait == 0) {
+		return mutex.try_lock();
+	}
+	return mutex.try_lock_for(std::chrono::milliseconds(static_cast<uint64_t>(wait) * portTICK_PERIOD_MS));
+}
+
+/**
+ * @brief Mutex Wrapper.
+ *
+ * Not recursive, a task must give the Mutex before taking it again.
+ * @ingroup FreeRTOSCpp
+ */
+class Mutex : public Lockable {
+public:
+	/**
+	 * @brief Constructor.
+	 * @param name Name to give mutex, unused on the host.
+	 */
+	Mutex(char const* name) { (void)name; }
+	~Mutex() {}
+
+	bool take(TickType_t wait = portMAX_DELAY) override { return mutexTakeTicks(mutex, wait); }
+#if FREERTOSCPP_USE_CHRONO
+	bool take(Time_ms wait) { return mutexTakeTicks(mutex, ms2ticks(wait)); }
+#endif
+	bool give() override {
+		mutex.unlock();
+		return true;
+	}
+
+private:
+	std::timed_mutex mutex;
+
+	Mutex(Mutex const&) = delete;
+	void operator =(Mutex const&) = delete;
+};
+
+#if configUSE_RECURSIVE_MUTEXES > 0
+/**
+ * @brief Recursive Mutex Wrapper.
+ *
+ * Nested takes by the same task need as many gives before the mutex is released.
+ * @ingroup FreeRTOSCpp
+ */
+class RecursiveMutex : public Lockable {
+public:
+	RecursiveMutex(char const* name = nullptr) { (void)name; }
+	~RecursiveMutex() {}
+
+	bool take(TickType_t wait = portMAX_DELAY) override { return mutexTakeTicks(mutex, wait); }
+	bool give() override {
+		mutex.unlock();
+		return true;
+	}
+
+private:
+	std::recursive_timed_mutex mutex;
+
+	RecursiveMutex(RecursiveMutex const&) = delete;
+	void operator =(RecursiveMutex const&) = delete;
+};
+#endif // configUSE_RECURSIVE_MUTEXES
+
+#if FREERTOSCPP_USE_NAMESPACE
+}   // namespace FreeRTOScpp
+#endif
+
+#endif // MUTEXCPP_H
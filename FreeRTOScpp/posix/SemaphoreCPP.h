@@ -0,0 +1,95 @@
+/**
+ * @file posix/SemaphoreCPP.h
+ * @brief Binary semaphore wrapper for host builds (POSIX port)
+ *
+ * Same interface as include/SemaphoreCPP.h, built on a mutex and a condition variable. The _ISR variants are
+ * kept for source compatibility, on the host they are called from ordinary threads.
+ *
+ * @ingroup FreeRTOSCpp
+ */
+
+#ifndef SEMAPHORE_CPP_H
+#define SEMAPHORE_CPP_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include "FreeRTOScpp.h"
+#include "Lock.h"
+
+#if FREERTOSCPP_USE_NAMESPACE
+namespace FreeRTOScpp {
+#endif
+
+/**
+ * @brief Binary Semaphore Wrapper.
+ *
+ * Created empty, a give() sets it and one take() clears it, further gives while set are lost.
+ * @ingroup FreeRTOSCpp
+ */
+class BinarySemaphore : public Lockable {
+public:
+	BinarySemaphore(char const* name = nullptr) : set(false) { (void)name; }
+	~BinarySemaphore() {}
+
+	/**
+	 * @brief Give the Semaphore.
+	 * @returns False if the semaphore was already set.
+	 */
+	bool give() override {
+		std::lock_guard<std::mutex> lock(mutex);
+		if(set) {
+			return false;
+		}
+		set = true;
+		cond.notify_one();
+		return true;
+	}
+
+	/**
+	 * @brief Take the semaphore.
+	 * @param delay The number of ticks to wait for the semaphore.
+	 * @returns True if the semaphore was taken.
+	 */
+	bool take(TickType_t delay = portMAX_DELAY) override {
+		std::unique_lock<std::mutex> lock(mutex);
+		if(delay == portMAX_DELAY) {
+			cond.wait(lock, [this] { return set; });
+		} else if(!cond.wait_for(lock, std::chrono::milliseconds(static_cast<uint64_t>(delay) * portTICK_PERIOD_MS),
+		                         [this] { return set; })) {
+			return false;
+		}
+		set = false;
+		return true;
+	}
+#if FREERTOSCPP_USE_CHRONO
+	bool take(Time_ms delay) { return take(ms2ticks(delay)); }
+#endif
+
+	bool take_ISR(portBASE_TYPE& waswoken) {
+		(void)waswoken;
+		return take(0);
+	}
+
+	bool give_ISR(portBASE_TYPE& waswoken) {
+		(void)waswoken;
+		return give();
+	}
+
+private:
+	std::mutex mutex;
+	std::condition_variable cond;
+	bool set;
+
+	BinarySemaphore(BinarySemaphore const&) = delete;
+	void operator =(BinarySemaphore const&) = delete;
+};
+
+typedef BinarySemaphore Semaphore [[deprecated("Rename to BinarySemaphore")]];
+
+#if FREERTOSCPP_USE_NAMESPACE
+}   // namespace FreeRTOScpp
+#endif
+
+#endif
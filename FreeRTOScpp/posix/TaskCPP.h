@@ -0,0 +1,174 @@
+/**
+ * @file posix/TaskCPP.h
+ * @brief Task wrappers for host builds (POSIX port)
+ *
+ * Same interface as include/TaskCPP.h for the parts used off-target: class based tasks (TaskClassS), function
+ * tasks (TaskS), delays, priorities and the give()/take() notification. Tasks run as std::thread through the
+ * port in posix/, the stack depth template parameter is only recorded for uxTaskGetSystemState().
+ *
+ * As on target, a TaskClassS created while the scheduler runs (always the case on the host) starts blocked in
+ * take() until the most derived constructor or the owner calls give().
+ *
+ * @ingroup FreeRTOSCpp
+ */
+
+#ifndef TaskCPP_H
+#define TaskCPP_H
+
+#include "FreeRTOScpp.h"
+
+extern "C" {
+	extern void taskcpp_task_thunk(void*);
+}
+
+#if FREERTOSCPP_USE_NAMESPACE
+namespace FreeRTOScpp {
+#endif
+
+/**
+ * @brief Names for Base set of Priorities.
+ *
+ * Same values as on target, the host scheduler ignores them.
+ * @ingroup FreeRTOSCpp
+ */
+enum TaskPriority {
+	TaskPrio_Idle = 0,
+	TaskPrio_Low = ((configMAX_PRIORITIES)>1),
+	TaskPrio_HMI = (TaskPrio_Low + ((configMAX_PRIORITIES)>5)),
+	TaskPrio_Mid = ((configMAX_PRIORITIES)/2),
+	TaskPrio_High = ((configMAX_PRIORITIES)-1-((configMAX_PRIORITIES)>4)),
+	TaskPrio_Highest = ((configMAX_PRIORITIES)-1)
+};
+
+constexpr TaskPriority operator+(TaskPriority p, int offset) {
+	return static_cast<TaskPriority>(static_cast<int>(p) + offset);
+}
+
+constexpr TaskPriority operator-(TaskPriority p, int offset) {
+	return static_cast<TaskPriority>(static_cast<int>(p) - offset);
+}
+
+/**
+ * @brief Lightweight wrapper around a task handle.
+ *
+ * The destructor doesn't delete the task, a host thread can't be stopped from outside. Task objects are
+ * expected to live until the process exits, as they do on target.
+ * @ingroup FreeRTOSCpp
+ */
+class TaskBase {
+protected:
+	TaskBase() : taskHandle(nullptr) {}
+public:
+	TaskBase(TaskHandle_t handle) : taskHandle(handle) {}
+	virtual ~TaskBase() {}
+
+	TaskHandle_t getTaskHandle() const { return taskHandle; }
+
+	static void delay(TickType_t time) { vTaskDelay(time); }
+#if FREERTOSCPP_USE_CHRONO
+	static void delay(Time_ms ms) { vTaskDelay(ms2ticks(ms)); }
+#endif
+	static void delayUntil(TickType_t& prev, TickType_t time) { vTaskDelayUntil(&prev, time); }
+
+	TaskPriority priority() const { return static_cast<TaskPriority>(uxTaskPriorityGet(taskHandle)); }
+
+	/// @brief Notify the task, see take().
+	bool give() { return xTaskNotifyGive(taskHandle); }
+	void give_ISR(portBASE_TYPE& waswoken) { vTaskNotifyGiveFromISR(taskHandle, &waswoken); }
+
+	/**
+	 * @brief Wait for a give() notification of the calling task.
+	 *
+	 * @param clear True to clear the notification count (binary), false to decrement it (counting).
+	 * @param ticks The time to wait.
+	 * @returns The notification count before the take, zero on timeout.
+	 */
+	static uint32_t take(bool clear = true, TickType_t ticks = portMAX_DELAY) { return ulTaskNotifyTake(clear, ticks); }
+#if FREERTOSCPP_USE_CHRONO
+	static uint32_t take(bool clear, Time_ms ticks) { return ulTaskNotifyTake(clear, ms2ticks(ticks)); }
+#endif
+
+protected:
+	TaskHandle_t taskHandle;  ///< Handle for the task we are managing.
+
+private:
+	TaskBase(TaskBase const&) = delete;
+	void operator =(TaskBase const&) = delete;
+};
+
+/**
+ * @brief Task Wrapper.
+ *
+ * @tparam stackDepth Stack depth in words as on target, recorded but not applied to the host thread.
+ * @ingroup FreeRTOSCpp
+ */
+template<uint32_t stackDepth = 0> class TaskS : public TaskBase {
+public:
+	TaskS(char const* name, void (*taskfun)(void *), TaskPriority priority_, void * myParm = 0) :
+		TaskBase() {
+		xTaskCreate(taskfun, name, stackDepth, myParm, priority_, &taskHandle);
+	}
+};
+
+template<> class TaskS<0> : public TaskBase {
+public:
+	TaskS(char const* name, void (*taskfun)(void *), TaskPriority priority_,
+	      unsigned portSHORT stackSize, void * myParm = nullptr) :
+		TaskBase() {
+		xTaskCreate(taskfun, name, stackSize, myParm, priority_, &taskHandle);
+	}
+};
+
+typedef TaskS<0> Task;
+
+/**
+ * @brief Base Class for all Class based tasks.
+ */
+class TaskClassBase {
+public:
+	TaskClassBase() {}
+	~TaskClassBase() {}
+	virtual void task() = 0;
+};
+
+/**
+ * @brief Make a class based task.
+ *
+ * Derive from TaskClassS and the 'task()' member function will get called as the task based on the class,
+ * once the task has been given.
+ * @ingroup FreeRTOSCpp
+ */
+template<uint32_t stackDepth> class TaskClassS : public TaskClassBase, public TaskS<stackDepth> {
+public:
+	TaskClassS(char const* name, TaskPriority priority_, unsigned portSHORT stackDepth_ = 0) :
+		TaskS<stackDepth>(name, &taskcpp_task_thunk, priority_, static_cast<TaskClassBase*>(this))
+	{
+		(void) stackDepth_;
+		if(xTaskGetSchedulerState() != taskSCHEDULER_RUNNING) {
+			this->TaskBase::give();
+		}
+	}
+	virtual ~TaskClassS() {}
+	void task() override = 0;
+};
+
+template<> class TaskClassS<0> : public TaskClassBase, public TaskS<0> {
+public:
+	TaskClassS(char const* name, TaskPriority priority_, unsigned portSHORT stackDepth_) :
+		TaskS<0>(name, &taskcpp_task_thunk, priority_, stackDepth_, static_cast<TaskClassBase*>(this))
+	{
+		if(xTaskGetSchedulerState() != taskSCHEDULER_RUNNING) {
+			this->TaskBase::give();
+		}
+	}
+	virtual ~TaskClassS() {}
+	void task() override = 0;
+};
+
+typedef TaskClassS<0> TaskClass;
+
+#if FREERTOSCPP_USE_NAMESPACE
+} // namespace FreeRTOScpp
+#endif
+
+#endif
@@ -0,0 +1,460 @@
+/**
+ * @file posix/cmsis_os2_posix.cpp
+ * @brief CMSIS-RTOS2 subset of the POSIX port
+ *
+ * Kernel tick/state, delays, threads with thread flags, message queues, semaphores, mutexes and memory pools,
+ * the objects the application tasks (uwb_task, pkt_buf, the host UDP transport) are built on. Functions that
+ * are not listed here are deliberately missing, using one fails at link time.
+ *
+ * Control block and storage memory passed in the attributes is ignored, objects are always allocated by the
+ * port. Message priorities are ignored as in the FreeRTOS implementation. Calls from "ISR" context don't
+ * exist on the host, every function may block when given a timeout.
+ *
+ * @ingroup FreeRTOSCpp
+ */
+
+#include <cstring>
+#include <vector>
+
+#include "cmsis_os2.h"
+#include "port_posix.h"
+
+using namespace FreeRTOScpp::posix;
+
+namespace {
+
+struct Semaphore {
+	std::mutex lock;
+	std::condition_variable cond;
+	uint32_t count;
+	uint32_t maxCount;
+};
+
+struct MessageQueue {
+	std::mutex lock;
+	std::condition_variable notEmpty;
+	std::condition_variable notFull;
+	uint32_t msgSize;
+	uint32_t capacity;
+	uint32_t head;      ///< Oldest message.
+	uint32_t count;
+	std::vector<uint8_t> storage;
+};
+
+struct MemoryPool {
+	std::mutex lock;
+	std::condition_variable cond;
+	uint32_t blockSize;
+	uint32_t capacity;
+	std::vector<uint8_t> storage;
+	std::vector<void *> freeBlocks;
+};
+
+struct Mutex {
+	std::recursive_timed_mutex mutex;
+};
+
+/// Blocks are handed out 8 byte aligned like heap_4 allocations.
+const uint32_t POOL_ALIGN = 8;
+
+} // namespace
+
+extern "C" {
+
+//  ==== Kernel Management Functions ====
+
+osKernelState_t osKernelGetState(void) {
+	return osKernelRunning;
+}
+
+uint32_t osKernelGetTickCount(void) {
+	return xTaskGetTickCount();
+}
+
+uint32_t osKernelGetTickFreq(void) {
+	return configTICK_RATE_HZ;
+}
+
+//  ==== Thread Management Functions ====
+
+osThreadId_t osThreadNew(osThreadFunc_t func, void *argument, const osThreadAttr_t *attr) {
+	const char *name = nullptr;
+	uint32_t stackWords = 128;
+	osPriority_t prio = osPriorityNormal;
+	TaskHandle_t handle = nullptr;
+
+	if(func == nullptr) {
+		return nullptr;
+	}
+	if(attr != nullptr) {
+		name = attr->name;
+		if(attr->stack_size > 0) {
+			stackWords = attr->stack_size / sizeof(StackType_t);
+		}
+		if(attr->priority != osPriorityNone) {
+			prio = attr->priority;
+		}
+	}
+	if(xTaskCreate(func, name, static_cast<configSTACK_DEPTH_TYPE>(stackWords), argument,
+	               static_cast<UBaseType_t>(prio), &handle) != pdPASS) {
+		return nullptr;
+	}
+	return handle;
+}
+
+const char *osThreadGetName(osThreadId_t thread_id) {
+	return thread_id ? pcTaskGetName(static_cast<TaskHandle_t>(thread_id)) : nullptr;
+}
+
+osThreadId_t osThreadGetId(void) {
+	return currentTask();
+}
+
+__NO_RETURN void osThreadExit(void) {
+	exitCurrentTask();
+}
+
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags) {
+	TaskHandle_t tcb = static_cast<TaskHandle_t>(thread_id);
+	if(tcb == nullptr || (flags & osFlagsError)) {
+		return osFlagsErrorParameter;
+	}
+	uint32_t result;
+	{
+		std::lock_guard<std::mutex> lock(tcb->lock);
+		tcb->flags |= flags;
+		result = tcb->flags;
+	}
+	tcb->cond.notify_all();
+	return result;
+}
+
+uint32_t osThreadFlagsClear(uint32_t flags) {
+	TaskHandle_t tcb = currentTask();
+	std::lock_guard<std::mutex> lock(tcb->lock);
+	uint32_t result = tcb->flags;
+	tcb->flags &= ~flags;
+	return result;
+}
+
+uint32_t osThreadFlagsGet(void) {
+	TaskHandle_t tcb = currentTask();
+	std::lock_guard<std::mutex> lock(tcb->lock);
+	return tcb->flags;
+}
+
+uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout) {
+	if(flags & osFlagsError) {
+		return osFlagsErrorParameter;
+	}
+	TaskHandle_t tcb = currentTask();
+	bool waitAll = (options & osFlagsWaitAll) != 0;
+	std::unique_lock<std::mutex> lock(tcb->lock);
+	bool ok = waitTicks(lock, tcb->cond, timeout, [tcb, flags, waitAll] {
+		return waitAll ? (tcb->flags & flags) == flags : (tcb->flags & flags) != 0;
+	});
+	if(!ok) {
+		return timeout == 0 ? osFlagsErrorResource : osFlagsErrorTimeout;
+	}
+	uint32_t result = tcb->flags;
+	if(!(options & osFlagsNoClear)) {
+		tcb->flags &= ~flags;
+	}
+	return result;
+}
+
+//  ==== Generic Wait Functions ====
+
+osStatus_t osDelay(uint32_t ticks) {
+	vTaskDelay(ticks);
+	return osOK;
+}
+
+osStatus_t osDelayUntil(uint32_t ticks) {
+	TickType_t now = xTaskGetTickCount();
+	TickType_t delay = ticks - now;
+	if(delay == 0 || delay > 0x7FFFFFFFU) {
+		return osErrorParameter;
+	}
+	vTaskDelay(delay);
+	return osOK;
+}
+
+//  ==== Mutex Management Functions ====
+
+osMutexId_t osMutexNew(const osMutexAttr_t *attr) {
+	(void)attr;
+	return new Mutex();
+}
+
+osStatus_t osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout) {
+	Mutex *m = static_cast<Mutex *>(mutex_id);
+	if(m == nullptr) {
+		return osErrorParameter;
+	}
+	if(timeout == osWaitForever) {
+		m->mutex.lock();
+		return osOK;
+	}
+	if(timeout == 0) {
+		return m->mutex.try_lock() ? osOK : osErrorResource;
+	}
+	return m->mutex.try_lock_for(ticksToDuration(timeout)) ? osOK : osErrorTimeout;
+}
+
+osStatus_t osMutexRelease(osMutexId_t mutex_id) {
+	Mutex *m = static_cast<Mutex *>(mutex_id);
+	if(m == nullptr) {
+		return osErrorParameter;
+	}
+	m->mutex.unlock();
+	return osOK;
+}
+
+osStatus_t osMutexDelete(osMutexId_t mutex_id) {
+	delete static_cast<Mutex *>(mutex_id);
+	return osOK;
+}
+
+//  ==== Semaphore Management Functions ====
+
+osSemaphoreId_t osSemaphoreNew(uint32_t max_count, uint32_t initial_count, const osSemaphoreAttr_t *attr) {
+	(void)attr;
+	if(max_count == 0 || initial_count > max_count) {
+		return nullptr;
+	}
+	Semaphore *s = new Semaphore();
+	s->count = initial_count;
+	s->maxCount = max_count;
+	return s;
+}
+
+osStatus_t osSemaphoreAcquire(osSemaphoreId_t semaphore_id, uint32_t timeout) {
+	Semaphore *s = static_cast<Semaphore *>(semaphore_id);
+	if(s == nullptr) {
+		return osErrorParameter;
+	}
+	std::unique_lock<std::mutex> lock(s->lock);
+	if(!waitTicks(lock, s->cond, timeout, [s] { return s->count > 0; })) {
+		return timeout == 0 ? osErrorResource : osErrorTimeout;
+	}
+	s->count--;
+	return osOK;
+}
+
+osStatus_t osSemaphoreRelease(osSemaphoreId_t semaphore_id) {
+	Semaphore *s = static_cast<Semaphore *>(semaphore_id);
+	if(s == nullptr) {
+		return osErrorParameter;
+	}
+	{
+		std::lock_guard<std::mutex> lock(s->lock);
+		if(s->count >= s->maxCount) {
+			return osErrorResource;
+		}
+		s->count++;
+	}
+	s->cond.notify_one();
+	return osOK;
+}
+
+uint32_t osSemaphoreGetCount(osSemaphoreId_t semaphore_id) {
+	Semaphore *s = static_cast<Semaphore *>(semaphore_id);
+	if(s == nullptr) {
+		return 0;
+	}
+	std::lock_guard<std::mutex> lock(s->lock);
+	return s->count;
+}
+
+osStatus_t osSemaphoreDelete(osSemaphoreId_t semaphore_id) {
+	delete static_cast<Semaphore *>(semaphore_id);
+	return osOK;
+}
+
+//  ==== Memory Pool Management Functions ====
+
+osMemoryPoolId_t osMemoryPoolNew(uint32_t block_count, uint32_t block_size, const osMemoryPoolAttr_t *attr) {
+	(void)attr;
+	if(block_count == 0 || block_size == 0) {
+		return nullptr;
+	}
+	MemoryPool *mp = new MemoryPool();
+	mp->blockSize = (block_size + POOL_ALIGN - 1) & ~(POOL_ALIGN - 1);
+	mp->capacity = block_count;
+	mp->storage.resize(static_cast<size_t>(mp->blockSize) * block_count + POOL_ALIGN);
+	uintptr_t base = (reinterpret_cast<uintptr_t>(mp->storage.data()) + POOL_ALIGN - 1) & ~(uintptr_t)(POOL_ALIGN - 1);
+	// hand out the lowest address first, like the FreeRTOS pool
+	for(uint32_t i = block_count; i > 0; i--) {
+		mp->freeBlocks.push_back(reinterpret_cast<void *>(base + static_cast<uintptr_t>(i - 1) * mp->blockSize));
+	}
+	return mp;
+}
+
+void *osMemoryPoolAlloc(osMemoryPoolId_t mp_id, uint32_t timeout) {
+	MemoryPool *mp = static_cast<MemoryPool *>(mp_id);
+	if(mp == nullptr) {
+		return nullptr;
+	}
+	std::unique_lock<std::mutex> lock(mp->lock);
+	if(!waitTicks(lock, mp->cond, timeout, [mp] { return !mp->freeBlocks.empty(); })) {
+		return nullptr;
+	}
+	void *block = mp->freeBlocks.back();
+	mp->freeBlocks.pop_back();
+	return block;
+}
+
+osStatus_t osMemoryPoolFree(osMemoryPoolId_t mp_id, void *block) {
+	MemoryPool *mp = static_cast<MemoryPool *>(mp_id);
+	if(mp == nullptr || block == nullptr) {
+		return osErrorParameter;
+	}
+	{
+		std::lock_guard<std::mutex> lock(mp->lock);
+		if(mp->freeBlocks.size() >= mp->capacity) {
+			return osErrorResource;
+		}
+		mp->freeBlocks.push_back(block);
+	}
+	mp->cond.notify_one();
+	return osOK;
+}
+
+uint32_t osMemoryPoolGetCapacity(osMemoryPoolId_t mp_id) {
+	MemoryPool *mp = static_cast<MemoryPool *>(mp_id);
+	return mp ? mp->capacity : 0;
+}
+
+uint32_t osMemoryPoolGetBlockSize(osMemoryPoolId_t mp_id) {
+	MemoryPool *mp = static_cast<MemoryPool *>(mp_id);
+	return mp ? mp->blockSize : 0;
+}
+
+uint32_t osMemoryPoolGetCount(osMemoryPoolId_t mp_id) {
+	MemoryPool *mp = static_cast<MemoryPool *>(mp_id);
+	if(mp == nullptr) {
+		return 0;
+	}
+	std::lock_guard<std::mutex> lock(mp->lock);
+	return mp->capacity - static_cast<uint32_t>(mp->freeBlocks.size());
+}
+
+uint32_t osMemoryPoolGetSpace(osMemoryPoolId_t mp_id) {
+	MemoryPool *mp = static_cast<MemoryPool *>(mp_id);
+	if(mp == nullptr) {
+		return 0;
+	}
+	std::lock_guard<std::mutex> lock(mp->lock);
+	return static_cast<uint32_t>(mp->freeBlocks.size());
+}
+
+osStatus_t osMemoryPoolDelete(osMemoryPoolId_t mp_id) {
+	delete static_cast<MemoryPool *>(mp_id);
+	return osOK;
+}
+
+//  ==== Message Queue Management Functions ====
+
+osMessageQueueId_t osMessageQueueNew(uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t *attr) {
+	(void)attr;
+	if(msg_count == 0 || msg_size == 0) {
+		return nullptr;
+	}
+	MessageQueue *mq = new MessageQueue();
+	mq->msgSize = msg_size;
+	mq->capacity = msg_count;
+	mq->head = 0;
+	mq->count = 0;
+	mq->storage.resize(static_cast<size_t>(msg_count) * msg_size);
+	return mq;
+}
+
+osStatus_t osMessageQueuePut(osMessageQueueId_t mq_id, const void *msg_ptr, uint8_t msg_prio, uint32_t timeout) {
+	MessageQueue *mq = static_cast<MessageQueue *>(mq_id);
+	(void)msg_prio;
+	if(mq == nullptr || msg_ptr == nullptr) {
+		return osErrorParameter;
+	}
+	{
+		std::unique_lock<std::mutex> lock(mq->lock);
+		if(!waitTicks(lock, mq->notFull, timeout, [mq] { return mq->count < mq->capacity; })) {
+			return timeout == 0 ? osErrorResource : osErrorTimeout;
+		}
+		uint32_t tail = (mq->head + mq->count) % mq->capacity;
+		memcpy(&mq->storage[static_cast<size_t>(tail) * mq->msgSize], msg_ptr, mq->msgSize);
+		mq->count++;
+	}
+	mq->notEmpty.notify_one();
+	return osOK;
+}
+
+osStatus_t osMessageQueueGet(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *msg_prio, uint32_t timeout) {
+	MessageQueue *mq = static_cast<MessageQueue *>(mq_id);
+	if(mq == nullptr || msg_ptr == nullptr) {
+		return osErrorParameter;
+	}
+	{
+		std::unique_lock<std::mutex> lock(mq->lock);
+		if(!waitTicks(lock, mq->notEmpty, timeout, [mq] { return mq->count > 0; })) {
+			return timeout == 0 ? osErrorResource : osErrorTimeout;
+		}
+		memcpy(msg_ptr, &mq->storage[static_cast<size_t>(mq->head) * mq->msgSize], mq->msgSize);
+		mq->head = (mq->head + 1) % mq->capacity;
+		mq->count--;
+	}
+	if(msg_prio != nullptr) {
+		*msg_prio = 0;
+	}
+	mq->notFull.notify_one();
+	return osOK;
+}
+
+uint32_t osMessageQueueGetCapacity(osMessageQueueId_t mq_id) {
+	MessageQueue *mq = static_cast<MessageQueue *>(mq_id);
+	return mq ? mq->capacity : 0;
+}
+
+uint32_t osMessageQueueGetMsgSize(osMessageQueueId_t mq_id) {
+	MessageQueue *mq = static_cast<MessageQueue *>(mq_id);
+	return mq ? mq->msgSize : 0;
+}
+
+uint32_t osMessageQueueGetCount(osMessageQueueId_t mq_id) {
+	MessageQueue *mq = static_cast<MessageQueue *>(mq_id);
+	if(mq == nullptr) {
+		return 0;
+	}
+	std::lock_guard<std::mutex> lock(mq->lock);
+	return mq->count;
+}
+
+uint32_t osMessageQueueGetSpace(osMessageQueueId_t mq_id) {
+	MessageQueue *mq = static_cast<MessageQueue *>(mq_id);
+	if(mq == nullptr) {
+		return 0;
+	}
+	std::lock_guard<std::mutex> lock(mq->lock);
+	return mq->capacity - mq->count;
+}
+
+osStatus_t osMessageQueueReset(osMessageQueueId_t mq_id) {
+	MessageQueue *mq = static_cast<MessageQueue *>(mq_id);
+	if(mq == nullptr) {
+		return osErrorParameter;
+	}
+	{
+		std::lock_guard<std::mutex> lock(mq->lock);
+		mq->head = 0;
+		mq->count = 0;
+	}
+	mq->notFull.notify_all();
+	return osOK;
+}
+
+osStatus_t osMessageQueueDelete(osMessageQueueId_t mq_id) {
+	delete static_cast<MessageQueue *>(mq_id);
+	return osOK;
+}
+
+} // extern "C"
@@ -0,0 +1,328 @@
+/**
+ * @file posix/port_posix.cpp
+ * @brief FreeRTOS kernel subset of the POSIX port
+ *
+ * @ingroup FreeRTOSCpp
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <malloc.h>
+#include <thread>
+#include <vector>
+
+#include "port_posix.h"
+#include "TaskCPP.h"
+
+using namespace FreeRTOScpp;
+using namespace FreeRTOScpp::posix;
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+Clock::time_point startTime() {
+	static const Clock::time_point start = Clock::now();
+	return start;
+}
+
+uint64_t elapsedUs() {
+	return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - startTime()).count();
+}
+
+/// All live tasks, in creation order, for uxTaskGetSystemState().
+std::mutex registryLock;
+std::vector<TaskHandle_t> registry;
+UBaseType_t nextTaskNumber = 1;
+
+thread_local TaskHandle_t current = nullptr;
+
+/// Critical sections and scheduler suspension, the only exclusion the host can give.
+std::recursive_mutex kernelLock;
+
+std::atomic<size_t> heapUsed{0};
+std::atomic<size_t> heapMaxUsed{0};
+
+TaskHandle_t newTask(const char *name, configSTACK_DEPTH_TYPE stackDepth, UBaseType_t priority) {
+	TaskHandle_t tcb = new tskTaskControlBlock();
+	strncpy(tcb->name, name ? name : "", configMAX_TASK_NAME_LEN - 1);
+	tcb->name[configMAX_TASK_NAME_LEN - 1] = '\0';
+	tcb->stackDepth = stackDepth;
+	tcb->priority = priority;
+	tcb->code = nullptr;
+	tcb->param = nullptr;
+	tcb->hasCpuClock = false;
+	tcb->notifyValue = 0;
+	tcb->flags = 0;
+
+	std::lock_guard<std::mutex> lock(registryLock);
+	tcb->number = nextTaskNumber++;
+	registry.push_back(tcb);
+	return tcb;
+}
+
+void unregisterTask(TaskHandle_t tcb) {
+	std::lock_guard<std::mutex> lock(registryLock);
+	registry.erase(std::remove(registry.begin(), registry.end(), tcb), registry.end());
+}
+
+/// Bind the calling thread to tcb, done by the thread itself so that its CPU clock can be queried.
+void attachThread(TaskHandle_t tcb) {
+	current = tcb;
+	char threadName[16];
+	strncpy(threadName, tcb->name, sizeof(threadName) - 1);
+	threadName[sizeof(threadName) - 1] = '\0';
+	if(threadName[0]) {
+		pthread_setname_np(pthread_self(), threadName);
+	}
+
+	std::lock_guard<std::mutex> lock(registryLock);
+	tcb->hasCpuClock = pthread_getcpuclockid(pthread_self(), &tcb->cpuClock) == 0;
+}
+
+} // namespace
+
+namespace FreeRTOScpp {
+namespace posix {
+
+TaskHandle_t currentTask() {
+	if(current == nullptr) {
+		char name[16] = "";
+		pthread_getname_np(pthread_self(), name, sizeof(name));
+		attachThread(newTask(name, 0, 0));
+	}
+	return current;
+}
+
+void exitCurrentTask() {
+	TaskHandle_t tcb = current;
+	if(tcb != nullptr) {
+		unregisterTask(tcb);
+		current = nullptr;
+		delete tcb;
+	}
+	pthread_exit(nullptr);
+}
+
+} // namespace posix
+} // namespace FreeRTOScpp
+
+extern "C" {
+
+/**
+ * Thunk for the class based tasks, same as TaskCpp.cpp on target.
+ */
+void taskcpp_task_thunk(void* parm) {
+	TaskClassBase *myClass = static_cast<TaskClassBase*>(parm);
+	TaskBase::take();
+	myClass->task();
+	vTaskDelete(nullptr);
+}
+
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char *const pcName, const configSTACK_DEPTH_TYPE usStackDepth,
+                       void *const pvParameters, UBaseType_t uxPriority, TaskHandle_t *const pxCreatedTask) {
+	TaskHandle_t tcb = newTask(pcName, usStackDepth, uxPriority);
+	tcb->code = pxTaskCode;
+	tcb->param = pvParameters;
+	if(pxCreatedTask) {
+		*pxCreatedTask = tcb;
+	}
+
+	std::thread([tcb] {
+		attachThread(tcb);
+		tcb->code(tcb->param);
+		// returning from a task function is an error on target, here it just ends the task
+		exitCurrentTask();
+	}).detach();
+	return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t xTaskToDelete) {
+	if(xTaskToDelete == nullptr || xTaskToDelete == current) {
+		exitCurrentTask();
+	}
+	// another thread can't be stopped, only forget about it
+	unregisterTask(xTaskToDelete);
+}
+
+void vTaskDelay(const TickType_t xTicksToDelay) {
+	if(xTicksToDelay == 0) {
+		std::this_thread::yield();
+		return;
+	}
+	std::this_thread::sleep_for(ticksToDuration(xTicksToDelay));
+}
+
+void vTaskDelayUntil(TickType_t *const pxPreviousWakeTime, const TickType_t xTimeIncrement) {
+	*pxPreviousWakeTime += xTimeIncrement;
+	TickType_t wait = *pxPreviousWakeTime - xTaskGetTickCount();
+	// a wake time in the past (difference wrapped) doesn't block
+	if(wait != 0 && wait <= xTimeIncrement) {
+		std::this_thread::sleep_for(ticksToDuration(wait));
+	}
+}
+
+TickType_t xTaskGetTickCount(void) {
+	return static_cast<TickType_t>(elapsedUs() / (1000000U / configTICK_RATE_HZ));
+}
+
+TickType_t xTaskGetTickCountFromISR(void) {
+	return xTaskGetTickCount();
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+	return currentTask();
+}
+
+BaseType_t xTaskGetSchedulerState(void) {
+	// threads start at once, there is no window before the scheduler runs
+	return taskSCHEDULER_RUNNING;
+}
+
+char *pcTaskGetName(TaskHandle_t xTaskToQuery) {
+	return (xTaskToQuery ? xTaskToQuery : currentTask())->name;
+}
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t xTask) {
+	return (xTask ? xTask : currentTask())->priority;
+}
+
+UBaseType_t uxTaskGetNumberOfTasks(void) {
+	std::lock_guard<std::mutex> lock(registryLock);
+	return registry.size();
+}
+
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *const pxTaskStatusArray, const UBaseType_t uxArraySize,
+                                 uint32_t *const pulTotalRunTime) {
+	static uint64_t lastWall = 0;
+	static uint64_t lastBusy = 0;
+	static uint64_t idleTime = 0;
+	static const char idleName[] = configIDLE_TASK_NAME;
+
+	std::lock_guard<std::mutex> lock(registryLock);
+	if(uxArraySize < registry.size() + 1) {
+		return 0;
+	}
+
+	uint64_t wall = elapsedUs();
+	uint64_t busy = 0;
+	UBaseType_t count = 0;
+	for(TaskHandle_t tcb : registry) {
+		uint64_t cpu = 0;
+		struct timespec ts;
+		if(tcb->hasCpuClock && clock_gettime(tcb->cpuClock, &ts) == 0) {
+			cpu = static_cast<uint64_t>(ts.tv_sec) * 1000000U + ts.tv_nsec / 1000U;
+		}
+		busy += cpu;
+
+		TaskStatus_t *status = &pxTaskStatusArray[count++];
+		status->xHandle = tcb;
+		status->pcTaskName = tcb->name;
+		status->xTaskNumber = tcb->number;
+		status->eCurrentState = (tcb == current) ? eRunning : eBlocked;
+		status->uxCurrentPriority = tcb->priority;
+		status->uxBasePriority = tcb->priority;
+		status->ulRunTimeCounter = static_cast<uint32_t>(cpu);
+		status->pxStackBase = nullptr;
+		status->usStackHighWaterMark = tcb->stackDepth;
+	}
+
+	// wall time not spent in any task since the last call, tasks that ended meanwhile can make busy go back
+	uint64_t dWall = wall - lastWall;
+	uint64_t dBusy = busy > lastBusy ? busy - lastBusy : 0;
+	if(dWall > dBusy) {
+		idleTime += dWall - dBusy;
+	}
+	lastWall = wall;
+	lastBusy = busy;
+
+	TaskStatus_t *idle = &pxTaskStatusArray[count++];
+	memset(idle, 0, sizeof(*idle));
+	idle->pcTaskName = idleName;
+	idle->eCurrentState = eReady;
+	idle->ulRunTimeCounter = static_cast<uint32_t>(idleTime);
+
+	if(pulTotalRunTime) {
+		*pulTotalRunTime = static_cast<uint32_t>(wall);
+	}
+	return count;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify) {
+	{
+		std::lock_guard<std::mutex> lock(xTaskToNotify->lock);
+		xTaskToNotify->notifyValue++;
+	}
+	xTaskToNotify->cond.notify_all();
+	return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken) {
+	xTaskNotifyGive(xTaskToNotify);
+	if(pxHigherPriorityTaskWoken) {
+		*pxHigherPriorityTaskWoken = pdTRUE;
+	}
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait) {
+	TaskHandle_t tcb = currentTask();
+	std::unique_lock<std::mutex> lock(tcb->lock);
+	waitTicks(lock, tcb->cond, xTicksToWait, [tcb] { return tcb->notifyValue != 0; });
+	uint32_t value = tcb->notifyValue;
+	if(value) {
+		tcb->notifyValue = xClearCountOnExit ? 0 : value - 1;
+	}
+	return value;
+}
+
+void vTaskSuspendAll(void) {
+	kernelLock.lock();
+}
+
+BaseType_t xTaskResumeAll(void) {
+	kernelLock.unlock();
+	return pdFALSE;
+}
+
+void vPortEnterCritical(void) {
+	kernelLock.lock();
+}
+
+void vPortExitCritical(void) {
+	kernelLock.unlock();
+}
+
+void vPortYield(void) {
+	std::this_thread::yield();
+}
+
+void *pvPortMalloc(size_t xSize) {
+	void *pv = malloc(xSize);
+	if(pv) {
+		size_t used = heapUsed.fetch_add(malloc_usable_size(pv)) + malloc_usable_size(pv);
+		size_t maxUsed = heapMaxUsed.load();
+		while(used > maxUsed && !heapMaxUsed.compare_exchange_weak(maxUsed, used)) {
+		}
+	}
+	return pv;
+}
+
+void vPortFree(void *pv) {
+	if(pv) {
+		heapUsed.fetch_sub(malloc_usable_size(pv));
+		free(pv);
+	}
+}
+
+size_t xPortGetFreeHeapSize(void) {
+	size_t used = heapUsed.load();
+	return used < configTOTAL_HEAP_SIZE ? configTOTAL_HEAP_SIZE - used : 0;
+}
+
+size_t xPortGetMinimumEverFreeHeapSize(void) {
+	size_t used = heapMaxUsed.load();
+	return used < configTOTAL_HEAP_SIZE ? configTOTAL_HEAP_SIZE - used : 0;
+}
+
+} // extern "C"
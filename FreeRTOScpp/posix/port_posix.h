@@ -0,0 +1,77 @@
+/**
+ * @file posix/port_posix.h
+ * @brief Internals shared by the POSIX port sources, not for application code
+ *
+ * @ingroup FreeRTOSCpp
+ */
+
+#ifndef PORT_POSIX_H
+#define PORT_POSIX_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include <pthread.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * @brief Task control block of the POSIX port.
+ *
+ * lock/cond guard the index 0 notification value and the CMSIS thread flags, every change notifies all
+ * waiters since both kinds of wait share the condition variable.
+ */
+struct tskTaskControlBlock {
+	char name[configMAX_TASK_NAME_LEN];
+	UBaseType_t priority;
+	UBaseType_t number;
+	configSTACK_DEPTH_TYPE stackDepth;
+	TaskFunction_t code;
+	void *param;
+
+	clockid_t cpuClock;     ///< Thread CPU time clock, valid once hasCpuClock is set by the thread itself.
+	bool hasCpuClock;
+
+	std::mutex lock;
+	std::condition_variable cond;
+	uint32_t notifyValue;
+	uint32_t flags;
+};
+
+namespace FreeRTOScpp {
+namespace posix {
+
+/// Control block of the calling thread, threads created outside the port get one on first use.
+TaskHandle_t currentTask();
+
+/// End the calling thread after removing its task, used by vTaskDelete(nullptr) and osThreadExit().
+[[noreturn]] void exitCurrentTask();
+
+/// Convert a tick timeout to a duration, portMAX_DELAY must be handled by the caller.
+inline std::chrono::milliseconds ticksToDuration(TickType_t ticks) {
+	return std::chrono::milliseconds(static_cast<uint64_t>(ticks) * portTICK_PERIOD_MS);
+}
+
+/**
+ * @brief Wait on cond for pred with a FreeRTOS style timeout.
+ * @returns The final value of pred.
+ */
+template<class Pred> bool waitTicks(std::unique_lock<std::mutex>& lock, std::condition_variable& cond,
+                                    TickType_t ticks, Pred pred) {
+	if(ticks == portMAX_DELAY) {
+		cond.wait(lock, pred);
+		return true;
+	}
+	if(ticks == 0) {
+		return pred();
+	}
+	return cond.wait_for(lock, ticksToDuration(ticks), pred);
+}
+
+} // namespace posix
+} // namespace FreeRTOScpp
+
+#endif // PORT_POSIX_H
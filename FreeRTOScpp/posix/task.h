@@ -0,0 +1,95 @@
+/**
+ * @file posix/task.h
+ * @brief FreeRTOS task API subset for host builds (POSIX port)
+ *
+ * Every task is a std::thread with a control block holding its name, priority, index 0 notification value and
+ * CMSIS thread flags. Threads not created through the port (main(), test threads) get a control block on their
+ * first use of the API, so they can wait for notifications as well.
+ *
+ * vTaskDelete() of the calling task ends its thread. Other threads can't be stopped safely, deleting another
+ * task only removes it from the task list, its thread keeps running until the process exits.
+ *
+ * @ingroup FreeRTOSCpp
+ */
+
+#ifndef INC_TASK_H
+#define INC_TASK_H
+
+#include "FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define tskKERNEL_VERSION_NUMBER    "V10.3.1"
+#define tskKERNEL_VERSION_MAJOR     10
+#define tskKERNEL_VERSION_MINOR     3
+#define tskKERNEL_VERSION_BUILD     1
+
+#define taskSCHEDULER_SUSPENDED     ((BaseType_t)0)
+#define taskSCHEDULER_NOT_STARTED   ((BaseType_t)1)
+#define taskSCHEDULER_RUNNING       ((BaseType_t)2)
+
+struct tskTaskControlBlock;
+typedef struct tskTaskControlBlock *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+typedef enum { eRunning = 0, eReady, eBlocked, eSuspended, eDeleted, eInvalid } eTaskState;
+
+/**
+ * Task information filled by uxTaskGetSystemState().
+ *
+ * ulRunTimeCounter is the thread CPU time in us and the total run time is the wall clock in us, both wrap at
+ * 32 bits like the target TIM2 counter. usStackHighWaterMark reports the requested stack depth, host stacks are
+ * not measured. An extra IDLE entry carries the wall time left over by the other tasks, so load figures read
+ * like on the single core target.
+ */
+typedef struct xTASK_STATUS {
+    TaskHandle_t xHandle;
+    const char *pcTaskName;
+    UBaseType_t xTaskNumber;
+    eTaskState eCurrentState;
+    UBaseType_t uxCurrentPriority;
+    UBaseType_t uxBasePriority;
+    uint32_t ulRunTimeCounter;
+    StackType_t *pxStackBase;
+    configSTACK_DEPTH_TYPE usStackHighWaterMark;
+} TaskStatus_t;
+
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char *const pcName, const configSTACK_DEPTH_TYPE usStackDepth,
+                       void *const pvParameters, UBaseType_t uxPriority, TaskHandle_t *const pxCreatedTask);
+void vTaskDelete(TaskHandle_t xTaskToDelete);
+void vTaskDelay(const TickType_t xTicksToDelay);
+void vTaskDelayUntil(TickType_t *const pxPreviousWakeTime, const TickType_t xTimeIncrement);
+TickType_t xTaskGetTickCount(void);
+TickType_t xTaskGetTickCountFromISR(void);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+BaseType_t xTaskGetSchedulerState(void);
+char *pcTaskGetName(TaskHandle_t xTaskToQuery);
+UBaseType_t uxTaskPriorityGet(TaskHandle_t xTask);
+UBaseType_t uxTaskGetNumberOfTasks(void);
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *const pxTaskStatusArray, const UBaseType_t uxArraySize,
+                                 uint32_t *const pulTotalRunTime);
+
+BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify);
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken);
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait);
+
+void vTaskSuspendAll(void);
+BaseType_t xTaskResumeAll(void);
+
+void vPortEnterCritical(void);
+void vPortExitCritical(void);
+void vPortYield(void);
+
+#define taskYIELD()                         vPortYield()
+#define taskENTER_CRITICAL()                vPortEnterCritical()
+#define taskEXIT_CRITICAL()                 vPortExitCritical()
+#define taskENTER_CRITICAL_FROM_ISR()       (vPortEnterCritical(), 0)
+#define taskEXIT_CRITICAL_FROM_ISR(x)       ((void)(x), vPortExitCritical())
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_TASK_H */
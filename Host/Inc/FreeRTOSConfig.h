@@ -0,0 +1,37 @@
+/**
+ * @file FreeRTOSConfig.h
+ * @brief 本机构建（FreeRTOScpp POSIX移植）的内核配置，与Core/Inc/FreeRTOSConfig.h保持一致
+ *
+ * 只保留应用层用到的项，其余由FreeRTOScpp/posix/FreeRTOS.h给出默认值。
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#include <stdint.h>
+
+/* 目标板通过CMSIS_device_header引入HAL，本机由main.h提供GPIO等空实现 */
+#include "main.h"
+
+#define configTICK_RATE_HZ                       ((TickType_t)1000)
+#define configMAX_PRIORITIES                     ( 56 )
+#define configMINIMAL_STACK_SIZE                 ((uint16_t)128)
+#define configTOTAL_HEAP_SIZE                    ((size_t)500*1024)
+#define configMAX_TASK_NAME_LEN                  ( 16 )
+#define configUSE_TRACE_FACILITY                 1
+#define configUSE_MUTEXES                        1
+#define configUSE_RECURSIVE_MUTEXES              1
+#define configUSE_COUNTING_SEMAPHORES            1
+#define configGENERATE_RUN_TIME_STATS            1
+
+#define INCLUDE_vTaskDelete                      1
+#define INCLUDE_vTaskDelayUntil                  1
+#define INCLUDE_vTaskDelay                       1
+#define INCLUDE_uxTaskPriorityGet                1
+#define INCLUDE_xTaskGetSchedulerState           1
+#define INCLUDE_xTaskGetCurrentTaskHandle        1
+
+/* sys_mon的切换计数槽，本机没有traceTASK_SWITCHED_IN，计数保持为0 */
+#define SYS_MON_SWITCH_SLOTS                     32
+
+#endif /* FREERTOS_CONFIG_H */
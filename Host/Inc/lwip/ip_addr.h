@@ -0,0 +1,48 @@
+/**
+ * @file lwip/ip_addr.h
+ * @brief 本机构建的lwIP地址类型替身，udp_task.h中的udp_endpoint_t依赖此类型
+ */
+
+#ifndef LWIP_HDR_IP_ADDR_H
+#define LWIP_HDR_IP_ADDR_H
+
+#include <arpa/inet.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // 与lwIP的IPv4地址一致，网络字节序
+    typedef struct
+    {
+        uint32_t addr;
+    } ip_addr_t;
+
+    // 解析点分十进制地址，返回：1 - 成功, 0 - 无效地址
+    static inline int ipaddr_aton(const char *cp, ip_addr_t *addr)
+    {
+        struct in_addr in;
+        if (inet_pton(AF_INET, cp, &in) != 1)
+        {
+            return 0;
+        }
+        addr->addr = in.s_addr;
+        return 1;
+    }
+
+    // 转换为点分十进制字符串，结果在下一次调用前有效
+    static inline const char *ipaddr_ntoa(const ip_addr_t *addr)
+    {
+        static __thread char str[INET_ADDRSTRLEN];
+        struct in_addr in;
+        in.s_addr = addr->addr;
+        return inet_ntop(AF_INET, &in, str, sizeof(str));
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LWIP_HDR_IP_ADDR_H */
@@ -0,0 +1,13 @@
+/**
+ * @file lwip/sockets.h
+ * @brief 本机构建直接使用系统套接字头文件（struct sockaddr_in、htons等）
+ */
+
+#ifndef LWIP_HDR_SOCKETS_H
+#define LWIP_HDR_SOCKETS_H
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#endif /* LWIP_HDR_SOCKETS_H */
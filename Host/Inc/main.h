@@ -0,0 +1,36 @@
+/**
+ * @file main.h
+ * @brief 本机构建的HAL替身，只提供应用层用到的GPIO接口（空操作）
+ */
+
+#ifndef __MAIN_H
+#define __MAIN_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    typedef struct
+    {
+        uint32_t ODR;
+    } GPIO_TypeDef;
+
+    extern GPIO_TypeDef host_gpioa;
+
+#define GPIOA (&host_gpioa)
+#define GPIO_PIN_0 ((uint16_t)0x0001)
+
+    // 翻转输出寄存器中的对应位，便于调试时观察
+    static inline void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+    {
+        GPIOx->ODR ^= GPIO_Pin;
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MAIN_H */
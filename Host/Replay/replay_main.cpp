@@ -0,0 +1,305 @@
+// 抓包回放：把Scripts/pkt_capture.py写入的抓包文件按记录顺序送入MasterServer的接收处理，
+// UWB记录走processSlaveData（与SlaveDataProcT出队后相同），后端记录走processBackendData（与BackDataProcT相同）。
+// MasterServer只构造不run()，其任务线程保持空闲，处理全部在回放线程中顺序执行，结果可重复
+// 用法：wht_master_replay [-r] [-x 倍速] [-n 次数] [-l 日志级别] 抓包文件
+//   默认不等待，尽快回放；-r按抓包时间间隔实时回放，-x N按N倍速回放
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+#include "MasterServer.h"
+#include "cmsis_os2.h"
+#include "elog.h"
+#include "hptimer.hpp"
+#include "main.h"
+#include "pkt_buf.h"
+#include "pkt_capture.h"
+#include "udp_task.h"
+#include "uwb_task.h"
+
+GPIO_TypeDef host_gpioa;
+
+static constexpr uint8_t FILE_MAGIC[4] = {'W', 'H', 'C', 'P'};
+static constexpr size_t FILE_HDR_SIZE = 8;
+static constexpr uint8_t FILE_VERSION = 1;
+
+// 重组后的一条完整记录
+struct ReplayRecord
+{
+    uint64_t tsUs; // 展开32位回绕后的时间戳
+    uint8_t source;
+    std::vector<uint8_t> data;
+};
+
+// 每个来源的回放统计
+struct SourceStats
+{
+    uint64_t records = 0;
+    uint64_t bytes = 0;
+    uint64_t skipped = 0;   // 超过缓冲块大小或在缺口处不完整的记录
+    uint64_t wallUs = 0;    // 处理耗时总和
+    uint64_t wallMaxUs = 0;
+    uint64_t cpuNs = 0;     // 回放线程CPU时间总和
+};
+
+static void elog_init_replay(uint8_t level)
+{
+    elog_init();
+    elog_set_filter_lvl(level);
+    elog_set_fmt(ELOG_LVL_ASSERT, ELOG_FMT_ALL & ~ELOG_FMT_P_INFO);
+    elog_set_fmt(ELOG_LVL_ERROR, ELOG_FMT_LVL | ELOG_FMT_TAG | ELOG_FMT_TIME);
+    elog_set_fmt(ELOG_LVL_WARN, ELOG_FMT_LVL | ELOG_FMT_TAG | ELOG_FMT_TIME);
+    elog_set_fmt(ELOG_LVL_INFO, ELOG_FMT_LVL | ELOG_FMT_TAG | ELOG_FMT_TIME);
+    elog_set_fmt(ELOG_LVL_DEBUG, ELOG_FMT_ALL & ~(ELOG_FMT_FUNC | ELOG_FMT_P_INFO));
+    elog_set_fmt(ELOG_LVL_VERBOSE, ELOG_FMT_ALL & ~(ELOG_FMT_FUNC | ELOG_FMT_P_INFO));
+    elog_start();
+}
+
+static uint64_t thread_cpu_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// 读取抓包文件并重组跨数据报拆分的记录，缺口处未完成的记录丢弃
+// 返回：0 - 成功, -1 - 无法读取, -2 - 格式错误
+static int load_capture(const char *path, std::vector<ReplayRecord> &records, uint64_t &gaps, SourceStats *stats)
+{
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL)
+    {
+        return -1;
+    }
+    std::vector<uint8_t> file;
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), fp)) > 0)
+    {
+        file.insert(file.end(), chunk, chunk + n);
+    }
+    fclose(fp);
+
+    if (file.size() < FILE_HDR_SIZE || memcmp(file.data(), FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 ||
+        file[4] != FILE_VERSION)
+    {
+        return -2;
+    }
+
+    ReplayRecord pending[2];
+    bool inChain[2] = {false, false};
+    uint32_t prevTs = 0;
+    uint64_t base = 0;
+    bool first = true;
+    size_t pos = FILE_HDR_SIZE;
+
+    while (pos + sizeof(pkt_capture_rec_t) <= file.size())
+    {
+        pkt_capture_rec_t hdr;
+        memcpy(&hdr, file.data() + pos, sizeof(hdr));
+        pos += sizeof(hdr);
+        if (pos + hdr.len > file.size())
+        {
+            break; // 采集中断，最后一条记录不完整
+        }
+        const uint8_t *data = file.data() + pos;
+        pos += hdr.len;
+
+        // 两个任务的记录可能有少量乱序，只有大幅回退才视为32位微秒计数回绕
+        if (!first && hdr.ts_us < prevTs && prevTs - hdr.ts_us > 0x80000000U)
+        {
+            base += 1ULL << 32;
+        }
+        first = false;
+        prevTs = hdr.ts_us;
+
+        if (hdr.source == PKT_CAPTURE_SRC_GAP)
+        {
+            gaps++;
+            for (int s = 0; s < 2; s++)
+            {
+                if (inChain[s])
+                {
+                    stats[s].skipped++;
+                    inChain[s] = false;
+                }
+            }
+            continue;
+        }
+        if (hdr.source > PKT_CAPTURE_SRC_UDP)
+        {
+            continue;
+        }
+
+        ReplayRecord &rec = pending[hdr.source];
+        if (!inChain[hdr.source])
+        {
+            rec.tsUs = base + hdr.ts_us;
+            rec.source = hdr.source;
+            rec.data.clear();
+        }
+        rec.data.insert(rec.data.end(), data, data + hdr.len);
+        inChain[hdr.source] = (hdr.flags & PKT_CAPTURE_FLAG_MORE) != 0;
+        if (!inChain[hdr.source])
+        {
+            records.push_back(rec);
+        }
+    }
+    return 0;
+}
+
+// 按来源送入MasterServer，返回处理耗时（us）
+static uint64_t dispatch(MasterServer &server, const ReplayRecord &rec, SourceStats &stats)
+{
+    if (rec.source == PKT_CAPTURE_SRC_UWB && rec.data.size() > PKT_BUF_DATA_SIZE)
+    {
+        stats.skipped++;
+        return 0;
+    }
+
+    uint64_t cpu0 = thread_cpu_ns();
+    uint64_t t0 = hal_hptimer_get_us64();
+    if (rec.source == PKT_CAPTURE_SRC_UWB)
+    {
+        // 与UWB任务相同，接收数据放在报文缓冲中，转发时可直接引用
+        pkt_buf_t *buf = PktBuf_Alloc(100);
+        if (buf == NULL)
+        {
+            stats.skipped++;
+            return 0;
+        }
+        memcpy(buf->data, rec.data.data(), rec.data.size());
+        buf->len = (uint16_t)rec.data.size();
+        server.processSlaveData(buf);
+        PktBuf_Release(buf);
+    }
+    else
+    {
+        server.processBackendData(rec.data.data(), (uint16_t)rec.data.size());
+    }
+    uint64_t elapsed = hal_hptimer_get_us64() - t0;
+
+    stats.records++;
+    stats.bytes += rec.data.size();
+    stats.wallUs += elapsed;
+    stats.wallMaxUs = elapsed > stats.wallMaxUs ? elapsed : stats.wallMaxUs;
+    stats.cpuNs += thread_cpu_ns() - cpu0;
+    return elapsed;
+}
+
+int main(int argc, char *argv[])
+{
+    double speed = 0.0; // 0 - 不等待
+    int loops = 1;
+    int level = ELOG_LVL_WARN;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "rx:n:l:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'r':
+            speed = 1.0;
+            break;
+        case 'x':
+            speed = atof(optarg);
+            break;
+        case 'n':
+            loops = atoi(optarg);
+            break;
+        case 'l':
+            level = atoi(optarg);
+            break;
+        default:
+            optind = argc + 1;
+            break;
+        }
+    }
+    if (optind != argc - 1 || speed < 0.0 || loops <= 0)
+    {
+        fprintf(stderr, "usage: %s [-r] [-x speed] [-n loops] [-l level] capture.whcp\n", argv[0]);
+        return 1;
+    }
+
+    SourceStats stats[2];
+    std::vector<ReplayRecord> records;
+    uint64_t gaps = 0;
+    int ret = load_capture(argv[optind], records, gaps, stats);
+    if (ret != 0)
+    {
+        fprintf(stderr, "%s: %s\n", argv[optind], ret == -1 ? strerror(errno) : "not a capture file");
+        return 1;
+    }
+    if (records.empty())
+    {
+        fprintf(stderr, "%s: no records\n", argv[optind]);
+        return 1;
+    }
+
+    elog_init_replay((uint8_t)level);
+    hal_hptimer_init();
+
+    PktBuf_Init();
+    UWB_Task_Init();
+    UDP_Task_Init(); // 回放中发往后端的数据仍经UDP任务发送到DEFAULT_BACKEND_IP
+
+    // 不调用run()，MasterServer的任务阻塞在启动信号上，不与回放线程并发处理
+    static std::unique_ptr<MasterServer> masterServer = std::make_unique<MasterServer>();
+
+    uint64_t lateMaxUs = 0;
+    uint64_t start = hal_hptimer_get_us64();
+    for (int loop = 0; loop < loops; loop++)
+    {
+        uint64_t loopStart = hal_hptimer_get_us64();
+        uint64_t traceStart = records.front().tsUs;
+        for (const ReplayRecord &rec : records)
+        {
+            if (speed > 0.0)
+            {
+                uint64_t due = loopStart + (uint64_t)((double)(rec.tsUs - traceStart) / speed);
+                uint64_t now = hal_hptimer_get_us64();
+                if (due > now)
+                {
+                    std::this_thread::sleep_for(std::chrono::microseconds(due - now));
+                }
+                else if (now - due > lateMaxUs)
+                {
+                    lateMaxUs = now - due;
+                }
+            }
+            dispatch(*masterServer, rec, stats[rec.source]);
+        }
+    }
+    double seconds = (double)(hal_hptimer_get_us64() - start) / 1e6;
+    double traceSeconds = (double)(records.back().tsUs - records.front().tsUs) / 1e6;
+
+    printf("# %s: %zu records, %.3f s captured, %llu gaps, %d loops, %.3f s replayed\n", argv[optind],
+           records.size(), traceSeconds, (unsigned long long)gaps, loops, seconds);
+    printf("# %-6s %9s %11s %8s %9s %9s %9s\n", "source", "records", "bytes", "skipped", "avg_us", "max_us",
+           "cpu_us");
+    static const char *const names[2] = {"uwb", "udp"};
+    for (int s = 0; s < 2; s++)
+    {
+        uint64_t n = stats[s].records > 0 ? stats[s].records : 1;
+        printf("  %-6s %9llu %11llu %8llu %9.2f %9llu %9.2f\n", names[s], (unsigned long long)stats[s].records,
+               (unsigned long long)stats[s].bytes, (unsigned long long)stats[s].skipped,
+               (double)stats[s].wallUs / n, (unsigned long long)stats[s].wallMaxUs, (double)stats[s].cpuNs / n / 1e3);
+    }
+    printf("  %.1f records/s", (double)(stats[0].records + stats[1].records) / seconds);
+    if (speed > 0.0)
+    {
+        printf(", %.1fx, max late %llu us", speed, (unsigned long long)lateMaxUs);
+    }
+    printf("\n");
+
+    // UDP/UWB任务线程仍在运行，不析构MasterServer和elog，只刷新输出后直接退出
+    fflush(stdout);
+    _exit(0);
+}
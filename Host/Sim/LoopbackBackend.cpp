@@ -0,0 +1,204 @@
+#include "LoopbackBackend.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <unistd.h>
+
+#include "elog.h"
+#include "lwip/sockets.h"
+
+using namespace WhtsProtocol;
+
+static constexpr const char TAG[] = "vbackend";
+static constexpr size_t FRAME_HEADER_LEN = 7;
+
+LoopbackBackend::LoopbackBackend(const char *masterIp, uint16_t masterPort, uint16_t backendPort)
+    : sock(-1), master{0, masterPort}, backendPort(backendPort), datagrams(0), bytes(0), s2bFrames(0), s2bMessages(0),
+      m2bFrames(0), stopping(false)
+{
+    struct in_addr in;
+    if (inet_pton(AF_INET, masterIp, &in) == 1)
+    {
+        master.ip = in.s_addr;
+    }
+}
+
+LoopbackBackend::~LoopbackBackend()
+{
+    stopping = true;
+    if (rxThread.joinable())
+    {
+        rxThread.join();
+    }
+    if (sock >= 0)
+    {
+        close(sock);
+    }
+}
+
+int LoopbackBackend::start()
+{
+    sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0)
+    {
+        elog_e(TAG, "Failed to create UDP socket: %s", strerror(errno));
+        return -1;
+    }
+
+    // 接收超时用于检查退出标志
+    struct timeval tv = {0, 100 * 1000};
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    // 高帧率下避免内核接收缓冲区成为瓶颈
+    int rcvbuf = 4 * 1024 * 1024;
+    setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(backendPort);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+    {
+        elog_e(TAG, "Failed to bind UDP socket to port %d: %s", backendPort, strerror(errno));
+        close(sock);
+        sock = -1;
+        return -1;
+    }
+
+    rxThread = std::thread([this] { rxTask(); });
+    elog_i(TAG, "Loopback backend listening on 127.0.0.1:%d", backendPort);
+    return 0;
+}
+
+int LoopbackBackend::send(const Message &message, uint32_t gapMs)
+{
+    struct sockaddr_in to;
+    memset(&to, 0, sizeof(to));
+    to.sin_family = AF_INET;
+    to.sin_port = htons(master.port);
+    to.sin_addr.s_addr = master.ip;
+
+    auto fragments = txProcessor.packBackend2MasterMessage(message);
+    for (size_t i = 0; i < fragments.size(); i++)
+    {
+        if (i > 0 && gapMs > 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(gapMs));
+        }
+        const auto &fragment = fragments[i];
+        if (sendto(sock, fragment.data(), fragment.size(), 0, (struct sockaddr *)&to, sizeof(to)) < 0)
+        {
+            elog_e(TAG, "sendto failed: %s", strerror(errno));
+            return -1;
+        }
+    }
+
+    elog_d(TAG, "Sent %s in %d fragment(s)", message.getMessageTypeName(), static_cast<int>(fragments.size()));
+    return 0;
+}
+
+bool LoopbackBackend::waitResponse(Master2BackendMessageId messageId, uint32_t timeoutMs, std::vector<uint8_t> *payload)
+{
+    uint8_t id = static_cast<uint8_t>(messageId);
+    std::unique_lock<std::mutex> guard(responseLock);
+
+    bool received = responseCond.wait_for(guard, std::chrono::milliseconds(timeoutMs),
+                                          [this, id] { return responses.count(id) != 0; });
+    if (received)
+    {
+        if (payload != nullptr)
+        {
+            *payload = std::move(responses[id]);
+        }
+        responses.erase(id);
+    }
+    return received;
+}
+
+LoopbackBackend::Stats LoopbackBackend::getStats() const
+{
+    Stats stats;
+    stats.datagrams = datagrams.load();
+    stats.bytes = bytes.load();
+    stats.s2bFrames = s2bFrames.load();
+    stats.s2bMessages = s2bMessages.load();
+    stats.m2bFrames = m2bFrames.load();
+    return stats;
+}
+
+void LoopbackBackend::rxTask()
+{
+    static uint8_t buffer[UINT16_MAX];
+
+    while (!stopping)
+    {
+        ssize_t n = recv(sock, buffer, sizeof(buffer), 0);
+        if (n < 0)
+        {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            {
+                elog_e(TAG, "recv failed: %s", strerror(errno));
+                return;
+            }
+            continue;
+        }
+
+        datagrams++;
+        bytes += static_cast<uint64_t>(n);
+        handleDatagram(buffer, static_cast<size_t>(n));
+    }
+}
+
+// 主机透传的是从机原始接收缓冲，一个数据报中可能有多帧，只按帧头统计不做重组
+void LoopbackBackend::handleDatagram(const uint8_t *data, size_t len)
+{
+    size_t pos = 0;
+
+    while (pos + FRAME_HEADER_LEN <= len)
+    {
+        if (data[pos] != FRAME_DELIMITER_1 || data[pos + 1] != FRAME_DELIMITER_2)
+        {
+            pos++;
+            continue;
+        }
+
+        uint8_t packetId = data[pos + 2];
+        uint8_t moreFragments = data[pos + 4];
+        size_t frameLen = FRAME_HEADER_LEN + (data[pos + 5] | (data[pos + 6] << 8));
+        if (pos + frameLen > len)
+        {
+            elog_w(TAG, "Truncated frame in datagram (%d of %d bytes)", static_cast<int>(len - pos),
+                   static_cast<int>(frameLen));
+            return;
+        }
+
+        if (packetId == static_cast<uint8_t>(PacketId::SLAVE_TO_BACKEND))
+        {
+            s2bFrames++;
+            if (moreFragments == 0)
+            {
+                s2bMessages++;
+            }
+        }
+        else if (packetId == static_cast<uint8_t>(PacketId::MASTER_TO_BACKEND))
+        {
+            m2bFrames++;
+            rxProcessor.processReceivedData(std::vector<uint8_t>(data + pos, data + pos + frameLen));
+
+            Frame frame;
+            while (rxProcessor.getNextCompleteFrame(frame))
+            {
+                if (frame.packetId == static_cast<uint8_t>(PacketId::MASTER_TO_BACKEND) && !frame.payload.empty())
+                {
+                    std::lock_guard<std::mutex> guard(responseLock);
+                    responses[frame.payload[0]] = std::move(frame.payload);
+                    responseCond.notify_all();
+                }
+            }
+        }
+
+        pos += frameLen;
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef LOOPBACK_BACKEND_H
+#define LOOPBACK_BACKEND_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "WhtsProtocol.h"
+
+// 本机回环UDP后端：绑定DEFAULT_BACKEND_PORT，向主机UDP端口下发Backend2Master消息，
+// 统计主机透传的Slave2Backend帧，并重组Master2Backend响应供waitResponse()等待
+class LoopbackBackend
+{
+  public:
+    struct Stats
+    {
+        uint64_t datagrams;   // 收到的数据报
+        uint64_t bytes;       // 收到的字节数
+        uint64_t s2bFrames;   // Slave2Backend帧（含分片）
+        uint64_t s2bMessages; // Slave2Backend消息（最后一个分片）
+        uint64_t m2bFrames;   // Master2Backend帧
+    };
+
+    LoopbackBackend(const char *masterIp, uint16_t masterPort, uint16_t backendPort);
+    ~LoopbackBackend();
+
+    LoopbackBackend(const LoopbackBackend &) = delete;
+    LoopbackBackend &operator=(const LoopbackBackend &) = delete;
+
+    // 创建套接字并启动接收线程，返回：0 - 成功, -1 - 失败
+    int start();
+
+    // 发送一条Backend2Master消息，分片之间间隔gapMs，避免主机8条深度的接收队列溢出
+    // 返回：0 - 成功, -1 - 失败
+    int send(const WhtsProtocol::Message &message, uint32_t gapMs = 1);
+
+    // 等待指定Message ID的Master2Backend响应，payload非空时取回其Master2Backend负载（含Message ID）
+    // 返回：true - 收到, false - 超时
+    bool waitResponse(WhtsProtocol::Master2BackendMessageId messageId, uint32_t timeoutMs,
+                      std::vector<uint8_t> *payload = nullptr);
+
+    Stats getStats() const;
+
+  private:
+    void rxTask();
+    void handleDatagram(const uint8_t *data, size_t len);
+
+    int sock;
+    struct Address
+    {
+        uint32_t ip; // 网络字节序
+        uint16_t port;
+    } master;
+    uint16_t backendPort;
+
+    WhtsProtocol::ProtocolProcessor txProcessor; // 只在调用send()的线程中使用
+    WhtsProtocol::ProtocolProcessor rxProcessor; // 只在接收线程中使用
+
+    std::atomic<uint64_t> datagrams;
+    std::atomic<uint64_t> bytes;
+    std::atomic<uint64_t> s2bFrames;
+    std::atomic<uint64_t> s2bMessages;
+    std::atomic<uint64_t> m2bFrames;
+
+    std::mutex responseLock;
+    std::condition_variable responseCond;
+    std::map<uint8_t, std::vector<uint8_t>> responses; // 已收到但未被等待取走的响应，同一ID只保留最新一条
+
+    std::atomic<bool> stopping;
+    std::thread rxThread;
+};
+
+#endif /* LOOPBACK_BACKEND_H */
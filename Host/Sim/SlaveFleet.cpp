@@ -0,0 +1,189 @@
+#include "SlaveFleet.h"
+
+#include <algorithm>
+
+#include "elog.h"
+#include "master_app.h"
+
+using namespace WhtsProtocol;
+
+static constexpr const char TAG[] = "vslave";
+
+SlaveFleet::SlaveFleet(const Config &config, VirtualRadio &radio)
+    : config(config), radio(radio), framesSinceMessage(0), lastSyncUs(0), round(0), stats()
+{
+    processor.setMTU(config.mtu);
+}
+
+std::vector<Backend2Master::SlaveConfigMessage::SlaveInfo> SlaveFleet::getSlaveInfos() const
+{
+    std::vector<Backend2Master::SlaveConfigMessage::SlaveInfo> slaves;
+
+    slaves.reserve(config.count);
+    for (uint32_t i = 0; i < config.count; i++)
+    {
+        Backend2Master::SlaveConfigMessage::SlaveInfo info;
+        info.id = SLAVE_ID_BASE + i;
+        info.conductionNum = config.testCount;
+        info.resistanceNum = config.testCount;
+        info.clipMode = config.testCount;
+        info.clipStatus = 0;
+        slaves.push_back(info);
+    }
+    return slaves;
+}
+
+void SlaveFleet::onDownlink(const std::vector<uint8_t> &frame, uint64_t rxTimeUs)
+{
+    framesSinceMessage++;
+    processor.processReceivedData(frame);
+
+    Frame received;
+    while (processor.getNextCompleteFrame(received))
+    {
+        size_t syncFrames = framesSinceMessage;
+        framesSinceMessage = 0;
+
+        if (received.packetId != static_cast<uint8_t>(PacketId::MASTER_TO_SLAVE))
+        {
+            continue;
+        }
+
+        uint32_t destinationId = 0;
+        std::unique_ptr<Message> message;
+        if (!processor.parseMaster2SlavePacket(received.payload, destinationId, message))
+        {
+            elog_w(TAG, "Failed to parse Master2Slave packet (%d bytes)", static_cast<int>(received.payload.size()));
+            continue;
+        }
+
+        const auto *sync = dynamic_cast<const Master2Slave::SyncMessage *>(message.get());
+        if (sync != nullptr)
+        {
+            handleSync(*sync, rxTimeUs, syncFrames);
+        }
+        else
+        {
+            elog_d(TAG, "Ignoring %s to 0x%08X", message->getMessageTypeName(), destinationId);
+        }
+    }
+}
+
+void SlaveFleet::handleSync(const Master2Slave::SyncMessage &sync, uint64_t rxTimeUs, size_t syncFrames)
+{
+    // 从机按同步消息中的currentTime校时，下行延迟即为从机时钟相对主机的偏差
+    int64_t clockOffsetUs = static_cast<int64_t>(rxTimeUs) - static_cast<int64_t>(sync.currentTime);
+    uint64_t intervalUs = static_cast<uint64_t>(sync.interval) * 1000U;
+
+    auto configs = sync.slaveConfigs;
+    std::stable_sort(configs.begin(), configs.end(),
+                     [](const Master2Slave::SyncMessage::SlaveConfig &a,
+                        const Master2Slave::SyncMessage::SlaveConfig &b) { return a.timeSlot < b.timeSlot; });
+
+    uint16_t totalTests = 0;
+    for (const auto &slave : configs)
+    {
+        totalTests += slave.testCount;
+    }
+
+    uint32_t scheduled = 0;
+    uint32_t missed = 0;
+    uint64_t messages = 0;
+    uint64_t frames = 0;
+    uint64_t slotOffset = 0; // 时隙序号在前的从机testCount之和
+
+    for (const auto &slave : configs)
+    {
+        uint64_t slotStart = slotOffset;
+        slotOffset += slave.testCount;
+
+        if (slave.id < SLAVE_ID_BASE || slave.id - SLAVE_ID_BASE >= config.count)
+        {
+            continue;
+        }
+        scheduled++;
+
+        // 每个从机独立收听广播，同步消息的任一分片丢失即错过本周期
+        if (radio.isLost(syncFrames))
+        {
+            missed++;
+            continue;
+        }
+
+        auto report = buildReport(sync.mode, slave.id - SLAVE_ID_BASE, slave.testCount, totalTests);
+        if (!report)
+        {
+            continue;
+        }
+
+        DeviceStatus status;
+        status.fromUint16(0);
+        auto packed = processor.packSlave2BackendMessage(slave.id, status, *report);
+
+        uint64_t txTimeUs = sync.startTime + (slotStart + slave.testCount) * intervalUs + clockOffsetUs;
+        messages++;
+        frames += packed.size();
+        radio.transmitUp(txTimeUs, std::move(packed));
+    }
+
+    round++;
+
+    std::lock_guard<std::mutex> guard(statsLock);
+    stats.syncs++;
+    stats.syncsMissed += missed;
+    stats.messages += messages;
+    stats.frames += frames;
+    stats.scheduled = scheduled;
+    if (lastSyncUs != 0)
+    {
+        stats.cycleMs = static_cast<uint32_t>((rxTimeUs - lastSyncUs) / 1000U);
+    }
+    lastSyncUs = rxTimeUs;
+}
+
+// 构建一个从机的检测数据，数据内容由从机序号和同步轮次生成，便于后端核对
+std::unique_ptr<Message> SlaveFleet::buildReport(uint8_t mode, uint32_t index, uint8_t testCount, uint16_t totalTests)
+{
+    // 默认按导通矩阵估算：每次检测读取全部检测点，每点1位
+    uint16_t dataLen = config.dataLen;
+    if (dataLen == 0)
+    {
+        dataLen = static_cast<uint16_t>(testCount * ((totalTests + 7) / 8));
+    }
+
+    std::vector<uint8_t> data(dataLen);
+    for (uint16_t i = 0; i < dataLen; i++)
+    {
+        data[i] = static_cast<uint8_t>(index + round + i);
+    }
+
+    switch (mode)
+    {
+    case MODE_CONDUCTION: {
+        auto msg = std::make_unique<Slave2Backend::ConductionDataMessage>();
+        msg->conductionLength = dataLen;
+        msg->conductionData = std::move(data);
+        return msg;
+    }
+    case MODE_RESISTANCE: {
+        auto msg = std::make_unique<Slave2Backend::ResistanceDataMessage>();
+        msg->resistanceLength = dataLen;
+        msg->resistanceData = std::move(data);
+        return msg;
+    }
+    case MODE_CLIP: {
+        auto msg = std::make_unique<Slave2Backend::ClipDataMessage>();
+        msg->clipData = static_cast<uint16_t>(index + round);
+        return msg;
+    }
+    default:
+        elog_w(TAG, "Unknown mode %d in sync message", mode);
+        return nullptr;
+    }
+}
+
+SlaveFleet::Stats SlaveFleet::getStats()
+{
+    std::lock_guard<std::mutex> guard(statsLock);
+    return stats;
+}
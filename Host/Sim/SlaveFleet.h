@@ -0,0 +1,64 @@
+#ifndef SLAVE_FLEET_H
+#define SLAVE_FLEET_H
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "VirtualRadio.h"
+#include "WhtsProtocol.h"
+
+// N个仿真从机：共用一个下行解码器，按SyncMessage的TDMA时隙在各自时隙结束时上报检测数据
+// 时隙起点 = startTime + 时隙序号在前的从机testCount之和 × interval，数据在testCount × interval后发出
+class SlaveFleet
+{
+  public:
+    static constexpr uint32_t SLAVE_ID_BASE = 0x51000001;
+
+    struct Config
+    {
+        uint32_t count = 1;     // 从机数量
+        uint8_t testCount = 1;  // 每个从机的导通/阻值/卡钉检测数量
+        uint16_t dataLen = 0;   // 导通/阻值数据长度，0表示按导通矩阵估算
+        size_t mtu = 100;       // 从机侧分片MTU，与ProtocolProcessor默认值一致
+    };
+
+    struct Stats
+    {
+        uint64_t syncs;        // 收到的完整同步消息
+        uint64_t syncsMissed;  // 按从机计的同步丢失次数
+        uint64_t messages;     // 已发出的上报消息
+        uint64_t frames;       // 已发出的上报帧（含分片）
+        uint32_t scheduled;    // 最近一次同步中属于本仿真的从机数量
+        uint32_t cycleMs;      // 最近两次同步的间隔
+    };
+
+    SlaveFleet(const Config &config, VirtualRadio &radio);
+
+    // 后端下发的从机配置，与SlaveConfigMessage::SlaveInfo一致
+    std::vector<WhtsProtocol::Backend2Master::SlaveConfigMessage::SlaveInfo> getSlaveInfos() const;
+
+    // 虚拟射频下行回调，在空中线程中调用
+    void onDownlink(const std::vector<uint8_t> &frame, uint64_t rxTimeUs);
+
+    Stats getStats();
+
+  private:
+    void handleSync(const WhtsProtocol::Master2Slave::SyncMessage &sync, uint64_t rxTimeUs, size_t syncFrames);
+    std::unique_ptr<WhtsProtocol::Message> buildReport(uint8_t mode, uint32_t index, uint8_t testCount,
+                                                       uint16_t totalTests);
+
+    Config config;
+    VirtualRadio &radio;
+
+    // 以下成员只在空中线程中访问
+    WhtsProtocol::ProtocolProcessor processor;
+    size_t framesSinceMessage;
+    uint64_t lastSyncUs;
+    uint32_t round;
+
+    std::mutex statsLock;
+    Stats stats;
+};
+
+#endif /* SLAVE_FLEET_H */
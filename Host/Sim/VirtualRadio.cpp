@@ -0,0 +1,207 @@
+#include "VirtualRadio.h"
+
+#include <chrono>
+
+#include "elog.h"
+#include "hptimer.hpp"
+#include "uwb_task.h"
+
+static constexpr const char TAG[] = "vradio";
+
+VirtualRadio *VirtualRadio::instance = nullptr;
+
+VirtualRadio::VirtualRadio(const Config &config)
+    : config(config), rng(config.seed), nextSeq(0), stats(), stopping(false)
+{
+}
+
+VirtualRadio::~VirtualRadio()
+{
+    if (instance == this)
+    {
+        UWB_Host_SetTxHook(NULL);
+        instance = nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    if (airThread.joinable())
+    {
+        airThread.join();
+    }
+}
+
+void VirtualRadio::start(DownlinkHandler handler)
+{
+    downlink = std::move(handler);
+    airThread = std::thread([this] { airTask(); });
+
+    instance = this;
+    UWB_Host_SetTxHook(&VirtualRadio::txHook);
+
+    elog_i(TAG, "Virtual radio started: latency=%lu us, jitter=%lu us, loss=%.3f",
+           static_cast<unsigned long>(config.latencyUs), static_cast<unsigned long>(config.jitterUs), config.lossRate);
+}
+
+// 在uwb_comm任务中调用，数据在返回后失效，需要拷贝
+void VirtualRadio::txHook(const uint8_t *data, uint16_t len)
+{
+    VirtualRadio *radio = instance;
+    if (radio != nullptr)
+    {
+        radio->transmitDown(data, len);
+    }
+}
+
+void VirtualRadio::transmitDown(const uint8_t *data, uint16_t len)
+{
+    uint64_t now = hal_hptimer_get_us64();
+
+    Event event;
+    event.dir = Direction::DOWN;
+    event.plannedUs = now;
+    event.frames.emplace_back(data, data + len);
+
+    std::lock_guard<std::mutex> guard(lock);
+    stats.downFrames++;
+    event.dueUs = now + airDelayUs();
+    post(std::move(event));
+}
+
+void VirtualRadio::transmitUp(uint64_t txTimeUs, Frames frames)
+{
+    Event event;
+    event.dir = Direction::UP;
+    event.plannedUs = txTimeUs;
+
+    std::lock_guard<std::mutex> guard(lock);
+    stats.upFrames += frames.size();
+
+    // 丢包在提交时判定，空中线程只投递存活的帧
+    std::bernoulli_distribution lost(config.lossRate);
+    for (auto &frame : frames)
+    {
+        if (config.lossRate > 0.0 && lost(rng))
+        {
+            stats.upLost++;
+            continue;
+        }
+        event.frames.push_back(std::move(frame));
+    }
+    if (event.frames.empty())
+    {
+        return;
+    }
+
+    event.dueUs = txTimeUs + airDelayUs();
+    post(std::move(event));
+}
+
+bool VirtualRadio::isLost(size_t frames)
+{
+    if (config.lossRate <= 0.0)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    std::bernoulli_distribution lost(config.lossRate);
+    for (size_t i = 0; i < frames; i++)
+    {
+        if (lost(rng))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+VirtualRadio::Stats VirtualRadio::getStats()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return stats;
+}
+
+// 调用者持有lock
+uint64_t VirtualRadio::airDelayUs()
+{
+    uint64_t delay = config.latencyUs;
+    if (config.jitterUs > 0)
+    {
+        delay += std::uniform_int_distribution<uint32_t>(0, config.jitterUs)(rng);
+    }
+    return delay;
+}
+
+// 调用者持有lock
+void VirtualRadio::post(Event &&event)
+{
+    event.seq = nextSeq++;
+    bool earliest = events.empty() || event.dueUs < events.top().dueUs;
+    events.push(std::move(event));
+    if (earliest)
+    {
+        wake.notify_one();
+    }
+}
+
+// 空中线程：按到期时间投递，下行交给从机，上行注入主机接收队列
+void VirtualRadio::airTask()
+{
+    std::unique_lock<std::mutex> guard(lock);
+
+    while (!stopping)
+    {
+        if (events.empty())
+        {
+            wake.wait(guard);
+            continue;
+        }
+
+        uint64_t now = hal_hptimer_get_us64();
+        uint64_t due = events.top().dueUs;
+        if (due > now)
+        {
+            wake.wait_for(guard, std::chrono::microseconds(due - now));
+            continue;
+        }
+
+        // priority_queue::top()只能拷贝，const_cast移出后立即弹出
+        Event event = std::move(const_cast<Event &>(events.top()));
+        events.pop();
+
+        if (event.dir == Direction::UP && now - event.dueUs > stats.upLateUsMax)
+        {
+            stats.upLateUsMax = now - event.dueUs;
+        }
+
+        guard.unlock();
+        if (event.dir == Direction::DOWN)
+        {
+            if (downlink)
+            {
+                downlink(event.frames.front(), now);
+            }
+        }
+        else
+        {
+            uint64_t rejected = 0;
+            for (const auto &frame : event.frames)
+            {
+                if (UWB_Host_InjectRx(frame.data(), static_cast<uint16_t>(frame.size())) != 0)
+                {
+                    rejected++;
+                }
+            }
+            if (rejected > 0)
+            {
+                std::lock_guard<std::mutex> statsGuard(lock);
+                stats.upRejected += rejected;
+            }
+        }
+        guard.lock();
+    }
+}
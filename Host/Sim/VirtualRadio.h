@@ -0,0 +1,99 @@
+#ifndef VIRTUAL_RADIO_H
+#define VIRTUAL_RADIO_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <thread>
+#include <vector>
+
+// 进程内虚拟射频：代替CX310，主机发送经UWB_Host_SetTxHook进入下行，从机数据经UWB_Host_InjectRx进入上行
+// 每次传输附加固定延迟 + 均匀抖动，上行按帧丢包，下行丢包由接收方调用isLost()按从机判定
+class VirtualRadio
+{
+  public:
+    using Frames = std::vector<std::vector<uint8_t>>;
+    using DownlinkHandler = std::function<void(const std::vector<uint8_t> &frame, uint64_t rxTimeUs)>;
+
+    struct Config
+    {
+        uint32_t latencyUs = 500; // 空中 + 协议栈固定延迟
+        uint32_t jitterUs = 0;    // 附加的均匀抖动 [0, jitterUs]
+        double lossRate = 0.0;    // 单帧丢失概率 [0, 1)
+        uint32_t seed = 1;
+    };
+
+    struct Stats
+    {
+        uint64_t downFrames;  // 主机发出的帧
+        uint64_t upFrames;    // 从机发出的帧
+        uint64_t upLost;      // 上行空中丢失
+        uint64_t upRejected;  // UWB_Host_InjectRx失败（接收队列满/缓冲池耗尽）
+        uint64_t upLateUsMax; // 上行实际投递时刻晚于计划的最大值
+    };
+
+    explicit VirtualRadio(const Config &config);
+    ~VirtualRadio();
+
+    VirtualRadio(const VirtualRadio &) = delete;
+    VirtualRadio &operator=(const VirtualRadio &) = delete;
+
+    // 启动空中线程并注册UWB发送钩子，整个进程只能有一个实例
+    void start(DownlinkHandler handler);
+
+    // 从机在txTimeUs（hptimer时间）发出一组帧（同一条消息的分片），按帧独立丢包
+    void transmitUp(uint64_t txTimeUs, Frames frames);
+
+    // 按配置的丢包率判定一次接收是否丢失，frames为该次接收包含的帧数
+    bool isLost(size_t frames = 1);
+
+    Stats getStats();
+
+  private:
+    enum class Direction : uint8_t
+    {
+        DOWN,
+        UP,
+    };
+
+    struct Event
+    {
+        uint64_t dueUs;
+        uint64_t seq; // 同一时刻按提交顺序投递
+        Direction dir;
+        uint64_t plannedUs;
+        Frames frames;
+
+        bool operator>(const Event &other) const
+        {
+            return dueUs != other.dueUs ? dueUs > other.dueUs : seq > other.seq;
+        }
+    };
+
+    static void txHook(const uint8_t *data, uint16_t len);
+
+    void transmitDown(const uint8_t *data, uint16_t len);
+    uint64_t airDelayUs();
+    void post(Event &&event);
+    void airTask();
+
+    static VirtualRadio *instance;
+
+    Config config;
+    DownlinkHandler downlink;
+
+    std::mutex lock; // 保护以下所有成员
+    std::condition_variable wake;
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events;
+    std::mt19937 rng;
+    uint64_t nextSeq;
+    Stats stats;
+    bool stopping;
+
+    std::thread airThread;
+};
+
+#endif /* VIRTUAL_RADIO_H */
@@ -0,0 +1,363 @@
+// 主机负载仿真：MasterServer运行在POSIX线程上，射频由VirtualRadio代替，N个仿真从机按TDMA时隙上报，
+// 后端为本机回环UDP套接字。配置并启动采集后测量透传帧率、每帧CPU时间和队列占用
+// 用法：wht_master_sim -n 从机数 [-t 测量秒数] [-w 预热秒数] [-m 模式] [-c 检测数] [-i 间隔ms] [-b 数据长度]
+//                      [-L 延迟us] [-J 抖动us] [-p 丢包%] [-s 种子] [-l 日志级别] [-P]
+//   -P 测量开始时清零、结束时通过CYCLE_PROF_REQ_MSG读取热点函数耗时（需-DCYCLE_PROFILE=ON）
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <sys/resource.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "FreeRTOS.h"
+#include "LoopbackBackend.h"
+#include "MasterServer.h"
+#include "SlaveFleet.h"
+#include "VirtualRadio.h"
+#include "cmsis_os2.h"
+#include "elog.h"
+#include "hptimer.hpp"
+#include "main.h"
+#include "master_app.h"
+#include "pkt_buf.h"
+#include "pkt_capture.h"
+#include "task.h"
+#include "udp_task.h"
+#include "uwb_task.h"
+
+GPIO_TypeDef host_gpioa;
+
+static constexpr const char TAG[] = "sim";
+static constexpr uint16_t MASTER_UDP_PORT = 8080;
+static constexpr uint32_t SLAVE_CONFIG_MAX = UINT8_MAX; // SlaveConfigMessage::slaveNum为u8
+static constexpr uint32_t RESPONSE_TIMEOUT_MS = 2000;
+
+// 队列占用采样，1ms一次
+struct QueueSample
+{
+    uint64_t samples = 0;
+    uint64_t uwbRxSum = 0;
+    uint64_t udpTxSum = 0;
+    int uwbRxMax = 0;
+    int udpTxMax = 0;
+    uint32_t pktBufFreeMin = PKT_BUF_POOL_SIZE;
+};
+
+static void elog_init_sim(uint8_t level)
+{
+    elog_init();
+    elog_set_filter_lvl(level);
+    elog_set_fmt(ELOG_LVL_ASSERT, ELOG_FMT_ALL & ~ELOG_FMT_P_INFO);
+    elog_set_fmt(ELOG_LVL_ERROR, ELOG_FMT_LVL | ELOG_FMT_TAG | ELOG_FMT_TIME);
+    elog_set_fmt(ELOG_LVL_WARN, ELOG_FMT_LVL | ELOG_FMT_TAG | ELOG_FMT_TIME);
+    elog_set_fmt(ELOG_LVL_INFO, ELOG_FMT_LVL | ELOG_FMT_TAG | ELOG_FMT_TIME);
+    elog_set_fmt(ELOG_LVL_DEBUG, ELOG_FMT_ALL & ~(ELOG_FMT_FUNC | ELOG_FMT_P_INFO));
+    elog_set_fmt(ELOG_LVL_VERBOSE, ELOG_FMT_ALL & ~(ELOG_FMT_FUNC | ELOG_FMT_P_INFO));
+    elog_start();
+}
+
+// MasterServer所有任务（含UWB/UDP任务）的线程CPU时间之和，不含仿真自身的线程
+static uint64_t master_cpu_us(void)
+{
+    std::vector<TaskStatus_t> status(uxTaskGetNumberOfTasks() + 1);
+    UBaseType_t count = uxTaskGetSystemState(status.data(), status.size(), NULL);
+    uint64_t total = 0;
+
+    for (UBaseType_t i = 0; i < count; i++)
+    {
+        if (status[i].xHandle != NULL) // 跳过合成的IDLE项
+        {
+            total += status[i].ulRunTimeCounter;
+        }
+    }
+    return total;
+}
+
+static uint64_t process_cpu_us(void)
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (uint64_t)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000ULL +
+           (uint64_t)(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+static bool configure_master(LoopbackBackend &backend, const SlaveFleet &fleet, uint8_t mode, uint8_t intervalMs)
+{
+    using namespace WhtsProtocol;
+
+    Backend2Master::SlaveConfigMessage slaveConfig;
+    slaveConfig.slaves = fleet.getSlaveInfos();
+    if (slaveConfig.slaves.size() > SLAVE_CONFIG_MAX)
+    {
+        elog_w(TAG, "SlaveConfigMessage carries at most %lu slaves, %d simulated slaves will never be scheduled",
+               static_cast<unsigned long>(SLAVE_CONFIG_MAX),
+               static_cast<int>(slaveConfig.slaves.size() - SLAVE_CONFIG_MAX));
+        slaveConfig.slaves.resize(SLAVE_CONFIG_MAX);
+    }
+    slaveConfig.slaveNum = static_cast<uint8_t>(slaveConfig.slaves.size());
+    if (backend.send(slaveConfig) != 0 ||
+        !backend.waitResponse(Master2BackendMessageId::SLAVE_CFG_RSP_MSG, RESPONSE_TIMEOUT_MS))
+    {
+        elog_e(TAG, "No response to slave config");
+        return false;
+    }
+
+    Backend2Master::IntervalConfigMessage interval;
+    interval.intervalMs = intervalMs;
+    if (backend.send(interval) != 0 ||
+        !backend.waitResponse(Master2BackendMessageId::INTERVAL_CFG_RSP_MSG, RESPONSE_TIMEOUT_MS))
+    {
+        elog_e(TAG, "No response to interval config");
+        return false;
+    }
+
+    Backend2Master::ModeConfigMessage modeConfig;
+    modeConfig.mode = mode;
+    if (backend.send(modeConfig) != 0 ||
+        !backend.waitResponse(Master2BackendMessageId::MODE_CFG_RSP_MSG, RESPONSE_TIMEOUT_MS))
+    {
+        elog_e(TAG, "No response to mode config");
+        return false;
+    }
+
+    Backend2Master::CtrlMessage ctrl;
+    ctrl.runningStatus = SYSTEM_STATUS_RUN;
+    if (backend.send(ctrl) != 0 || !backend.waitResponse(Master2BackendMessageId::CTRL_RSP_MSG, RESPONSE_TIMEOUT_MS))
+    {
+        elog_e(TAG, "No response to control message");
+        return false;
+    }
+
+    elog_i(TAG, "Master configured: %d slaves, mode %d, interval %d ms, running", slaveConfig.slaveNum, mode,
+           intervalMs);
+    return true;
+}
+
+// 通过后端CYCLE_PROF_REQ_MSG读取热点函数耗时统计，print为false时只清零
+static bool query_cycle_profile(LoopbackBackend &backend, bool print)
+{
+    using namespace WhtsProtocol;
+
+    Backend2Master::CycleProfReqMessage request;
+    request.reset = 1;
+    std::vector<uint8_t> payload;
+    if (backend.send(request) != 0 ||
+        !backend.waitResponse(Master2BackendMessageId::CYCLE_PROF_RSP_MSG, RESPONSE_TIMEOUT_MS, &payload))
+    {
+        elog_e(TAG, "No response to cycle profile request");
+        return false;
+    }
+
+    ProtocolProcessor processor;
+    std::unique_ptr<Message> message;
+    auto *profile = processor.parseMaster2BackendPacket(payload, message)
+                        ? dynamic_cast<Master2Backend::CycleProfResponseMessage *>(message.get())
+                        : nullptr;
+    if (profile == nullptr)
+    {
+        elog_e(TAG, "Malformed cycle profile response");
+        return false;
+    }
+    if (!print)
+    {
+        return true;
+    }
+    if (profile->clockHz == 0)
+    {
+        printf("prof  cycle profiling not enabled, configure with -DCYCLE_PROFILE=ON\n");
+        return true;
+    }
+
+    // 主机构建的计数单位为纳秒
+    double perUs = (double)profile->clockHz / 1e6;
+    printf("prof  %-14s %9s %9s %9s %9s %9s %7s  (slot %lu us)\n", "probe", "count", "avg_us", "min_us", "max_us",
+           "budget_us", "over", (unsigned long)profile->slotUs);
+    for (const auto &probe : profile->probes)
+    {
+        uint64_t n = probe.count > 0 ? probe.count : 1;
+        printf("prof  %-14s %9lu %9.2f %9.2f %9.2f %9.1f %7lu\n", probe.name, (unsigned long)probe.count,
+               (double)probe.total / n / perUs, probe.min / perUs, probe.max / perUs, probe.budget / perUs,
+               (unsigned long)probe.overBudget);
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    SlaveFleet::Config fleetConfig;
+    VirtualRadio::Config radioConfig;
+    int measure_s = 10;
+    int warmup_s = 1;
+    int mode = MODE_CONDUCTION;
+    int interval_ms = 1;
+    int level = ELOG_LVL_WARN;
+    bool profile = false;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:t:w:m:c:i:b:L:J:p:s:l:P")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n':
+            fleetConfig.count = (uint32_t)atoi(optarg);
+            break;
+        case 't':
+            measure_s = atoi(optarg);
+            break;
+        case 'w':
+            warmup_s = atoi(optarg);
+            break;
+        case 'm':
+            mode = atoi(optarg);
+            break;
+        case 'c':
+            fleetConfig.testCount = (uint8_t)atoi(optarg);
+            break;
+        case 'i':
+            interval_ms = atoi(optarg);
+            break;
+        case 'b':
+            fleetConfig.dataLen = (uint16_t)atoi(optarg);
+            break;
+        case 'L':
+            radioConfig.latencyUs = (uint32_t)atoi(optarg);
+            break;
+        case 'J':
+            radioConfig.jitterUs = (uint32_t)atoi(optarg);
+            break;
+        case 'p':
+            radioConfig.lossRate = atof(optarg) / 100.0;
+            break;
+        case 's':
+            radioConfig.seed = (uint32_t)atoi(optarg);
+            break;
+        case 'l':
+            level = atoi(optarg);
+            break;
+        case 'P':
+            profile = true;
+            break;
+        default:
+            fprintf(stderr,
+                    "usage: %s -n slaves [-t seconds] [-w warmup] [-m mode] [-c tests] [-i interval_ms] [-b data_len]\n"
+                    "          [-L latency_us] [-J jitter_us] [-p loss_percent] [-s seed] [-l level] [-P]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+    if (fleetConfig.count == 0 || measure_s <= 0 || mode > MODE_CLIP || interval_ms <= 0 || interval_ms > UINT8_MAX ||
+        radioConfig.lossRate < 0.0 || radioConfig.lossRate >= 1.0)
+    {
+        fprintf(stderr, "invalid arguments\n");
+        return 1;
+    }
+
+    elog_init_sim((uint8_t)level);
+    hal_hptimer_init();
+
+    PktBuf_Init();
+    UWB_Task_Init();
+    UDP_Task_Init();
+#if PKT_CAPTURE
+    PktCapture_Init(PKT_CAPTURE_IP, PKT_CAPTURE_PORT); // 仿真流量抓包，可用wht_master_replay回放
+#endif
+
+    static VirtualRadio radio(radioConfig);
+    static SlaveFleet fleet(fleetConfig, radio);
+    radio.start([](const std::vector<uint8_t> &frame, uint64_t rxTimeUs) { fleet.onDownlink(frame, rxTimeUs); });
+
+    static std::unique_ptr<MasterServer> masterServer = std::make_unique<MasterServer>();
+    std::thread([] { masterServer->run(); }).detach();
+    osDelay(100); // 等待MasterServer任务启动
+
+    static LoopbackBackend backend("127.0.0.1", MASTER_UDP_PORT, DEFAULT_BACKEND_PORT);
+    if (backend.start() != 0 || !configure_master(backend, fleet, (uint8_t)mode, (uint8_t)interval_ms))
+    {
+        fflush(stdout);
+        _exit(1);
+    }
+
+    // 预热：至少完整经历一个TDMA周期
+    uint32_t waited = 0;
+    while (fleet.getStats().syncs < 2 && waited < 30000)
+    {
+        osDelay(10);
+        waited += 10;
+    }
+    osDelay((uint32_t)warmup_s * 1000U);
+    if (profile)
+    {
+        query_cycle_profile(backend, false); // 清零预热阶段的统计
+    }
+
+    // 测量窗口
+    std::atomic<bool> sampling(true);
+    QueueSample queues;
+    std::thread sampler([&] {
+        while (sampling)
+        {
+            int uwbRx = UWB_GetRxQueueCount();
+            int udpTx = UDP_GetTxQueueCount();
+            uint32_t pktBufFree = PktBuf_GetFreeCount();
+            queues.samples++;
+            queues.uwbRxSum += (uint64_t)uwbRx;
+            queues.udpTxSum += (uint64_t)udpTx;
+            queues.uwbRxMax = std::max(queues.uwbRxMax, uwbRx);
+            queues.udpTxMax = std::max(queues.udpTxMax, udpTx);
+            queues.pktBufFreeMin = std::min(queues.pktBufFreeMin, pktBufFree);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    uint64_t t0 = hal_hptimer_get_us64();
+    uint64_t masterCpu0 = master_cpu_us();
+    uint64_t processCpu0 = process_cpu_us();
+    LoopbackBackend::Stats backend0 = backend.getStats();
+    VirtualRadio::Stats radio0 = radio.getStats();
+    SlaveFleet::Stats fleet0 = fleet.getStats();
+
+    osDelay((uint32_t)measure_s * 1000U);
+
+    uint64_t t1 = hal_hptimer_get_us64();
+    uint64_t masterCpu1 = master_cpu_us();
+    uint64_t processCpu1 = process_cpu_us();
+    LoopbackBackend::Stats backend1 = backend.getStats();
+    VirtualRadio::Stats radio1 = radio.getStats();
+    SlaveFleet::Stats fleet1 = fleet.getStats();
+
+    sampling = false;
+    sampler.join();
+
+    double seconds = (double)(t1 - t0) / 1e6;
+    uint64_t forwarded = backend1.s2bFrames - backend0.s2bFrames;
+    uint64_t masterCpu = masterCpu1 - masterCpu0;
+    uint64_t samples = queues.samples > 0 ? queues.samples : 1;
+
+    // 第一行为表头，Scripts/sim_sweep.sh只保留第一次运行的表头
+    printf("# %5s %5s %8s %9s %9s %9s %7s %7s %7s %9s %7s %7s %11s %11s %8s\n", "N", "sched", "cycle_ms", "tx_fps",
+           "fwd_fps", "msg/s", "lost", "reject", "missed", "cpu_us/f", "cpu%", "sim_cpu%", "uwb_rxq", "udp_txq",
+           "pbuf_min");
+    printf("  %5lu %5lu %8lu %9.1f %9.1f %9.1f %7llu %7llu %7llu %9.2f %7.1f %7.1f %5.2f/%-5d %5.2f/%-5d %8lu\n",
+           (unsigned long)fleetConfig.count, (unsigned long)fleet1.scheduled, (unsigned long)fleet1.cycleMs,
+           (double)(radio1.upFrames - radio0.upFrames) / seconds, (double)forwarded / seconds,
+           (double)(backend1.s2bMessages - backend0.s2bMessages) / seconds,
+           (unsigned long long)(radio1.upLost - radio0.upLost),
+           (unsigned long long)(radio1.upRejected - radio0.upRejected),
+           (unsigned long long)(fleet1.syncsMissed - fleet0.syncsMissed),
+           forwarded > 0 ? (double)masterCpu / (double)forwarded : 0.0, (double)masterCpu / (seconds * 1e4),
+           (double)(processCpu1 - processCpu0 - masterCpu) / (seconds * 1e4), (double)queues.uwbRxSum / samples,
+           queues.uwbRxMax, (double)queues.udpTxSum / samples, queues.udpTxMax, (unsigned long)queues.pktBufFreeMin);
+
+    if (profile)
+    {
+        query_cycle_profile(backend, true);
+    }
+
+    // 任务线程仍在运行，不析构MasterServer和elog，只刷新输出后直接退出
+    fflush(stdout);
+    _exit(0);
+}
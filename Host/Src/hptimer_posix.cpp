@@ -0,0 +1,61 @@
+// 本机构建的高精度定时器：CLOCK_MONOTONIC代替TIM2，64位微秒时间不会溢出
+#include "hptimer.hpp"
+
+#include <sched.h>
+#include <time.h>
+
+static uint64_t s_start_us = 0;
+
+static uint64_t hptimer_monotonic_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+// 与TIM2一样是32位微秒计数，会回绕
+static uint32_t hal_hptimer_get_us(void)
+{
+    return (uint32_t)hal_hptimer_get_us64();
+}
+
+void hal_hptimer_init(void)
+{
+    s_start_us = hptimer_monotonic_us();
+}
+
+void hal_hptimer_overflow_isr(void)
+{
+}
+
+uint32_t hal_hptimer_get_ms(void)
+{
+    return (uint32_t)(hal_hptimer_get_us64() / 1000ULL);
+}
+
+uint64_t hal_hptimer_get_us64(void)
+{
+    return hptimer_monotonic_us() - s_start_us;
+}
+
+uint32_t hal_hptimer_elapsed_us(uint32_t ref_time)
+{
+    return hal_hptimer_get_us() - ref_time;
+}
+
+bool hal_hptimer_is_timeout_us(uint32_t ref_time, uint32_t timeout_us)
+{
+    return hal_hptimer_elapsed_us(ref_time) >= timeout_us;
+}
+
+void hal_hptimer_delay_us(uint32_t us)
+{
+    uint32_t start = hal_hptimer_get_us();
+    while (hal_hptimer_elapsed_us(start) < us)
+    {
+        if (us > 1000)
+        {
+            sched_yield();
+        }
+    }
+}
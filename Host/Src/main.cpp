@@ -0,0 +1,84 @@
+// 本机构建入口：与master_app.cpp相同的初始化顺序，MasterServer及其任务运行在POSIX线程上
+// 用法：wht_master_host [-t 秒数] [-l 日志级别0-5]
+//   -t 运行指定时间后退出（默认一直运行），便于perf/sanitizer/基准测试
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <unistd.h>
+
+#include "MasterServer.h"
+#include "cmsis_os2.h"
+#include "elog.h"
+#include "hptimer.hpp"
+#include "main.h"
+#include "master_app.h"
+#include "pkt_buf.h"
+#include "pkt_capture.h"
+#include "udp_task.h"
+#include "uwb_task.h"
+
+GPIO_TypeDef host_gpioa;
+
+static void elog_init_host(uint8_t level)
+{
+    elog_init();
+    elog_set_filter_lvl(level);
+    // 与Core/Src/main.c相同的格式，DEBUG/VERBOSE中的T_INFO在本机为线程名
+    elog_set_fmt(ELOG_LVL_ASSERT, ELOG_FMT_ALL & ~ELOG_FMT_P_INFO);
+    elog_set_fmt(ELOG_LVL_ERROR, ELOG_FMT_LVL | ELOG_FMT_TAG | ELOG_FMT_TIME);
+    elog_set_fmt(ELOG_LVL_WARN, ELOG_FMT_LVL | ELOG_FMT_TAG | ELOG_FMT_TIME);
+    elog_set_fmt(ELOG_LVL_INFO, ELOG_FMT_LVL | ELOG_FMT_TAG | ELOG_FMT_TIME);
+    elog_set_fmt(ELOG_LVL_DEBUG, ELOG_FMT_ALL & ~(ELOG_FMT_FUNC | ELOG_FMT_P_INFO));
+    elog_set_fmt(ELOG_LVL_VERBOSE, ELOG_FMT_ALL & ~(ELOG_FMT_FUNC | ELOG_FMT_P_INFO));
+    elog_start();
+}
+
+int main(int argc, char *argv[])
+{
+    int duration_s = 0;
+    int level = ELOG_LVL_INFO;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "t:l:")) != -1)
+    {
+        switch (opt)
+        {
+        case 't':
+            duration_s = atoi(optarg);
+            break;
+        case 'l':
+            level = atoi(optarg);
+            break;
+        default:
+            fprintf(stderr, "usage: %s [-t seconds] [-l level]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    elog_init_host((uint8_t)level);
+    hal_hptimer_init();
+
+    PktBuf_Init();   // 初始化UWB/UDP共享报文缓冲池
+    UWB_Task_Init(); // 初始化UWB通信任务
+    UDP_Task_Init(); // 初始化UDP通信任务
+#if PKT_CAPTURE
+    PktCapture_Init(PKT_CAPTURE_IP, PKT_CAPTURE_PORT); // 接收数据抓包发送到采集端
+#endif
+
+    // MasterServer::run()不返回，放在独立线程中，主线程负责计时退出
+    static std::unique_ptr<MasterServer> masterServer = std::make_unique<MasterServer>();
+    std::thread([] { masterServer->run(); }).detach();
+
+    if (duration_s <= 0)
+    {
+        for (;;)
+        {
+            pause();
+        }
+    }
+    osDelay((uint32_t)duration_s * 1000U);
+    // 任务线程仍在运行，不析构MasterServer和elog，只刷新输出后直接退出
+    fflush(stdout);
+    _exit(0);
+}
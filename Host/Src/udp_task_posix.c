@@ -0,0 +1,300 @@
+// 本机构建的UDP通信任务：接口与User/Task/udp_task.c一致，基于BSD套接字
+// 发送：队列 + udpCommTask发送线程；接收：udpRxTask阻塞在recvfrom上，记录放入接收队列
+#include "elog.h"
+#include "elog_rl.h"
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cmsis_os.h"
+#include "lwip/sockets.h"
+#include "udp_task.h"
+
+#ifndef UDP_SERVER_PORT
+#define UDP_SERVER_PORT 8080
+#endif
+#define TX_QUEUE_SIZE 2 * 10
+#define RX_QUEUE_SIZE 8 // 目标板按8KB字节缓冲区计，这里按最大数据报计数
+
+// 发送消息结构体，队列持有buf的一次引用
+typedef struct
+{
+    udp_endpoint_t dest; // 目标地址
+    pkt_buf_t *buf;
+} tx_msg_t;
+
+// 全局变量
+static int udpSock = -1;
+static osMessageQueueId_t txQueue; // 发送队列
+static osMessageQueueId_t rxQueue; // 接收队列，元素为完整的udp_rx_msg_t
+static osThreadId_t udpTaskHandle;
+static osThreadId_t udpRxTaskHandle;
+static udp_rx_msg_t rxStaging; // 接收暂存区，只在udpRxTask中使用
+
+static udp_rx_callback_t rx_callback = NULL;
+
+// 发送一条消息，buf的引用由调用者释放
+static void udp_send_msg(const tx_msg_t *tx_msg)
+{
+    struct sockaddr_in to;
+    memset(&to, 0, sizeof(to));
+    to.sin_family = AF_INET;
+    to.sin_port = htons(tx_msg->dest.port);
+    to.sin_addr.s_addr = tx_msg->dest.ip.addr;
+
+    if (sendto(udpSock, tx_msg->buf->data, tx_msg->buf->len, 0, (struct sockaddr *)&to, sizeof(to)) < 0)
+    {
+        elog_rl_e("udp_task", "UDP sendto failed: %s, target=%s:%d, size=%d", strerror(errno),
+                  ipaddr_ntoa(&tx_msg->dest.ip), tx_msg->dest.port, tx_msg->buf->len);
+    }
+    else
+    {
+        elog_v("udp_task", "UDP sent %d bytes to %s:%d", tx_msg->buf->len, ipaddr_ntoa(&tx_msg->dest.ip),
+               tx_msg->dest.port);
+    }
+}
+
+// UDP发送任务
+static void udp_comm_task(void *argument)
+{
+    tx_msg_t tx_msg;
+    (void)argument;
+
+    for (;;)
+    {
+        if (osMessageQueueGet(txQueue, &tx_msg, NULL, osWaitForever) == osOK)
+        {
+            udp_send_msg(&tx_msg);
+            PktBuf_Release(tx_msg.buf);
+        }
+    }
+}
+
+// 投递一条接收记录：先调用回调，再写入接收队列
+static void udp_rx_deliver(const udp_rx_msg_t *rx_msg)
+{
+    elog_i("udp_task", "UDP received %d bytes from %s:%d", rx_msg->len, inet_ntoa(rx_msg->src_addr.sin_addr),
+           ntohs(rx_msg->src_addr.sin_port));
+
+    if (rx_callback != NULL)
+    {
+        rx_callback(rx_msg);
+    }
+
+    if (osMessageQueuePut(rxQueue, rx_msg, 0, 0) != osOK)
+    {
+        elog_rl_w("udp_task", "UDP RX buffer full, dropping packet from %s:%d (%d bytes)",
+                  inet_ntoa(rx_msg->src_addr.sin_addr), ntohs(rx_msg->src_addr.sin_port), rx_msg->len);
+    }
+}
+
+// UDP接收任务
+static void udp_rx_task(void *argument)
+{
+    (void)argument;
+
+    for (;;)
+    {
+        socklen_t addr_len = sizeof(rxStaging.src_addr);
+        ssize_t n = recvfrom(udpSock, rxStaging.data, sizeof(rxStaging.data), MSG_TRUNC,
+                             (struct sockaddr *)&rxStaging.src_addr, &addr_len);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            elog_e("udp_task", "UDP recvfrom failed: %s", strerror(errno));
+            osThreadExit();
+        }
+        if ((size_t)n > UDP_RX_MAX_DATAGRAM)
+        {
+            elog_rl_w("udp_task", "UDP packet size (%d bytes) > max datagram size (%d bytes), data truncated!",
+                      (int)n, UDP_RX_MAX_DATAGRAM);
+            n = UDP_RX_MAX_DATAGRAM;
+        }
+        rxStaging.len = (uint16_t)n;
+        udp_rx_deliver(&rxStaging);
+    }
+}
+
+// 初始化UDP通信任务
+void UDP_Task_Init(void)
+{
+    struct sockaddr_in addr;
+
+    udpSock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (udpSock < 0)
+    {
+        elog_e("udp_task", "Failed to create UDP socket: %s", strerror(errno));
+        return;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(UDP_SERVER_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(udpSock, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+    {
+        elog_e("udp_task", "Failed to bind UDP socket to port %d: %s", UDP_SERVER_PORT, strerror(errno));
+        close(udpSock);
+        udpSock = -1;
+        return;
+    }
+
+    txQueue = osMessageQueueNew(TX_QUEUE_SIZE, sizeof(tx_msg_t), NULL);
+    rxQueue = osMessageQueueNew(RX_QUEUE_SIZE, sizeof(udp_rx_msg_t), NULL);
+    if (txQueue == NULL || rxQueue == NULL)
+    {
+        return;
+    }
+
+    const osThreadAttr_t udpTask_attributes = {
+        .name = "udpCommTask",
+        .stack_size = 1024 * 16,
+        .priority = (osPriority_t)osPriorityNormal,
+    };
+    udpTaskHandle = osThreadNew(udp_comm_task, NULL, &udpTask_attributes);
+
+    const osThreadAttr_t udpRxTask_attributes = {
+        .name = "udpRxTask",
+        .stack_size = 1024 * 16,
+        .priority = (osPriority_t)osPriorityNormal,
+    };
+    udpRxTaskHandle = osThreadNew(udp_rx_task, NULL, &udpRxTask_attributes);
+
+    elog_i("udp_task", "UDP server started on port %d", UDP_SERVER_PORT);
+}
+
+// API函数：解析目标地址，结果可缓存复用
+int UDP_ResolveEndpoint(udp_endpoint_t *ep, const char *ip_addr, uint16_t port)
+{
+    if (ep == NULL || ip_addr == NULL)
+    {
+        return -1;
+    }
+
+    if (ipaddr_aton(ip_addr, &ep->ip) == 0)
+    {
+        return -2; // 无效的IP地址
+    }
+    ep->port = port;
+
+    return 0;
+}
+
+// API函数：发送UDP数据
+int UDP_SendData(const uint8_t *data, uint16_t len, const char *ip_addr, uint16_t port)
+{
+    udp_endpoint_t ep;
+    int ret = UDP_ResolveEndpoint(&ep, ip_addr, port);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    return UDP_SendDataTo(data, len, &ep);
+}
+
+// API函数：发送UDP数据到已解析的目标地址
+int UDP_SendDataTo(const uint8_t *data, uint16_t len, const udp_endpoint_t *ep)
+{
+    if (data == NULL || len == 0 || len > UDP_BUFFER_SIZE || ep == NULL)
+    {
+        return -1;
+    }
+
+    pkt_buf_t *buf = PktBuf_Alloc(0);
+    if (buf == NULL)
+    {
+        return -3; // 缓冲池耗尽
+    }
+
+    memcpy(buf->data, data, len);
+    buf->len = len;
+
+    int ret = UDP_SendBufTo(buf, ep);
+    PktBuf_Release(buf);
+    return ret;
+}
+
+// API函数：发送缓冲块中的UDP数据
+int UDP_SendBuf(pkt_buf_t *buf, const char *ip_addr, uint16_t port)
+{
+    udp_endpoint_t ep;
+    int ret = UDP_ResolveEndpoint(&ep, ip_addr, port);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    return UDP_SendBufTo(buf, &ep);
+}
+
+// API函数：发送缓冲块中的UDP数据到已解析的目标地址
+int UDP_SendBufTo(pkt_buf_t *buf, const udp_endpoint_t *ep)
+{
+    if (buf == NULL || buf->len == 0 || buf->len > UDP_BUFFER_SIZE || ep == NULL)
+    {
+        return -1;
+    }
+
+    tx_msg_t msg;
+    msg.dest = *ep;
+    msg.buf = PktBuf_Ref(buf);
+    if (osMessageQueuePut(txQueue, &msg, 0, 100) != osOK)
+    {
+        PktBuf_Release(buf);
+        return -3; // 队列满或超时
+    }
+
+    return 0; // 成功
+}
+
+// API函数：接收UDP数据
+int UDP_ReceiveData(udp_rx_msg_t *msg, uint32_t timeout_ms)
+{
+    if (msg == NULL)
+    {
+        return -1;
+    }
+
+    if (osMessageQueueGet(rxQueue, msg, NULL, timeout_ms) == osOK)
+    {
+        return 0; // 成功
+    }
+
+    return -1; // 超时或错误
+}
+
+// API函数：设置接收回调函数
+void UDP_SetRxCallback(udp_rx_callback_t callback)
+{
+    rx_callback = callback;
+}
+
+// API函数：获取队列状态
+int UDP_GetTxQueueCount(void)
+{
+    return (int)osMessageQueueGetCount(txQueue);
+}
+
+int UDP_GetRxQueueCount(void)
+{
+    return (int)osMessageQueueGetCount(rxQueue);
+}
+
+// API函数：清空队列
+void UDP_ClearTxQueue(void)
+{
+    tx_msg_t msg;
+    while (osMessageQueueGet(txQueue, &msg, NULL, 0) == osOK)
+    {
+        PktBuf_Release(msg.buf);
+    }
+}
+
+void UDP_ClearRxQueue(void)
+{
+    osMessageQueueReset(rxQueue);
+}
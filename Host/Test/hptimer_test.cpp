@@ -0,0 +1,201 @@
+// hal_hptimer_get_us64单元测试：User/hptimer/hptimer.cpp以HPTIMER_FAKE_COUNTER编译，
+// TIM2计数器和溢出标志由本文件模拟，溢出中断由测试直接调用hal_hptimer_overflow_isr()
+// 覆盖：跨溢出读取、溢出标志已置位但中断未处理、读取过程中被溢出中断打断、多次回绕的单调性
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <random>
+
+#include "hptimer.hpp"
+
+static uint32_t fakeCounter;
+static bool fakeOverflow;
+static std::function<void()> onCounterRead; // 读取计数器时执行一次，模拟读取过程中发生的中断
+
+extern "C" uint32_t hptimer_fake_counter(void)
+{
+    uint32_t value = fakeCounter;
+    if (onCounterRead)
+    {
+        std::function<void()> hook = std::move(onCounterRead);
+        onCounterRead = nullptr;
+        hook();
+    }
+    return value;
+}
+
+extern "C" bool hptimer_fake_overflow_pending(void)
+{
+    return fakeOverflow;
+}
+
+extern "C" void hptimer_fake_clear_overflow(void)
+{
+    fakeOverflow = false;
+}
+
+static int failures;
+
+#define CHECK_EQ(actual, expected)                                                                                     \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        uint64_t a_ = (actual);                                                                                        \
+        uint64_t e_ = (expected);                                                                                      \
+        if (a_ != e_)                                                                                                  \
+        {                                                                                                              \
+            fprintf(stderr, "%s:%d: %s = 0x%llx, expected 0x%llx\n", __FILE__, __LINE__, #actual,                     \
+                    (unsigned long long)a_, (unsigned long long)e_);                                                   \
+            failures++;                                                                                                \
+        }                                                                                                              \
+    } while (0)
+
+// 计数器前进，越过0xFFFFFFFF时置位溢出标志（与TIM2相同，标志保持到被清除）
+static void advance(uint32_t us)
+{
+    uint32_t next = fakeCounter + us;
+    if (next < fakeCounter)
+    {
+        fakeOverflow = true;
+    }
+    fakeCounter = next;
+}
+
+static void reset(void)
+{
+    fakeCounter = 0;
+    fakeOverflow = false;
+    onCounterRead = nullptr;
+    hal_hptimer_init();
+}
+
+static void test_overflow_handled(void)
+{
+    reset();
+    fakeCounter = 0xFFFFFFF0U;
+    CHECK_EQ(hal_hptimer_get_us64(), 0xFFFFFFF0ULL);
+
+    advance(0x20);
+    hal_hptimer_overflow_isr();
+    CHECK_EQ(hal_hptimer_get_us64(), 0x100000010ULL);
+    CHECK_EQ(hal_hptimer_get_ms(), 0x100000010ULL / 1000);
+
+    // 标志未置位时中断不累加
+    hal_hptimer_overflow_isr();
+    CHECK_EQ(hal_hptimer_get_us64(), 0x100000010ULL);
+}
+
+static void test_overflow_pending(void)
+{
+    reset();
+    fakeCounter = 0xFFFFFFF0U;
+
+    // 已回绕、标志已置位，中断尚未执行（关中断期间读取）
+    advance(0x20);
+    CHECK_EQ(hal_hptimer_get_us64(), 0x100000010ULL);
+
+    // 中断执行后结果不变
+    hal_hptimer_overflow_isr();
+    CHECK_EQ(hal_hptimer_get_us64(), 0x100000010ULL);
+
+    // 计数值大于一半说明计数器在溢出之前被读取，标志不计入
+    reset();
+    fakeCounter = 0xFFFFFFFEU;
+    fakeOverflow = true;
+    CHECK_EQ(hal_hptimer_get_us64(), 0xFFFFFFFEULL);
+}
+
+static void test_torn_read(void)
+{
+    // 读取s_epoch之后、计数器返回之前发生溢出中断：必须重试，不能得到旧epoch与新计数值的组合
+    reset();
+    fakeCounter = 0xFFFFFFFFU;
+    onCounterRead = [] {
+        advance(5);
+        hal_hptimer_overflow_isr();
+    };
+    uint64_t first = hal_hptimer_get_us64();
+    CHECK_EQ(first, 0x100000004ULL);
+
+    // 同样的中断发生在标志读取之前但未被处理：计数值为回绕前的值，标志已置位
+    reset();
+    fakeCounter = 0xFFFFFFFFU;
+    onCounterRead = [] { advance(5); };
+    CHECK_EQ(hal_hptimer_get_us64(), 0xFFFFFFFFULL);
+    CHECK_EQ(hal_hptimer_get_us64(), 0x100000004ULL);
+}
+
+static void test_monotonic(void)
+{
+    reset();
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<uint32_t> step(1, 0x3FFFFFFFU);
+    std::uniform_int_distribution<int> action(0, 3);
+    uint64_t last = 0;
+    uint64_t expected = 0;
+    uint32_t wraps = 0;
+
+    while (wraps < 2000)
+    {
+        uint32_t us = step(rng);
+        uint32_t before = fakeCounter;
+        expected += us;
+
+        switch (action(rng))
+        {
+        case 0: // 中断在下一次读取之前执行
+            advance(us);
+            hal_hptimer_overflow_isr();
+            break;
+        case 1: // 中断推迟到读取之后
+            advance(us);
+            break;
+        case 2: // 中断打断读取
+            onCounterRead = [us] {
+                advance(us);
+                hal_hptimer_overflow_isr();
+            };
+            break;
+        default: // 计数器在读取过程中前进，中断推迟
+            onCounterRead = [us] { advance(us); };
+            break;
+        }
+
+        uint64_t now = hal_hptimer_get_us64();
+        if (now < last)
+        {
+            fprintf(stderr, "%s:%d: time went backwards after %u wraps: 0x%llx < 0x%llx\n", __FILE__, __LINE__,
+                    (unsigned)wraps, (unsigned long long)now, (unsigned long long)last);
+            failures++;
+            return;
+        }
+        last = now;
+
+        // 推迟的中断在下一步之前执行，之后的读取结果与真实时间一致
+        hal_hptimer_overflow_isr();
+        if (fakeCounter < before)
+        {
+            wraps++;
+        }
+        CHECK_EQ(hal_hptimer_get_us64(), expected);
+        if (failures)
+        {
+            return;
+        }
+    }
+}
+
+int main(void)
+{
+    test_overflow_handled();
+    test_overflow_pending();
+    test_torn_read();
+    test_monotonic();
+
+    if (failures)
+    {
+        fprintf(stderr, "hptimer_test: %d failures\n", failures);
+        return 1;
+    }
+    printf("hptimer_test: ok\n");
+    return 0;
+}
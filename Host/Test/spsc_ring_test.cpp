@@ -0,0 +1,261 @@
+// SpscRing/ByteRing多线程压力测试，以ThreadSanitizer编译（Host/CMakeLists.txt）
+// 生产者与消费者各一个线程，消费者通过setConsumer()/wait()阻塞在POSIX移植的任务通知上：
+// - 数据经commit()的release/acquire发布，缓冲区读写若缺少同步由TSan报告数据竞争
+// - commit()与wait()中的seq_cst栅栏保证不丢失唤醒，wait()等满超时即视为丢失唤醒
+// - 生产者随机暂停，使环形缓冲区频繁在空与非空之间切换，覆盖只在空转非空时通知的路径
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <thread>
+
+#include "FreeRTOS.h"
+#include "SpscRing.h"
+#include "task.h"
+
+static constexpr uint32_t ITEM_COUNT = 200000;
+static constexpr uint32_t BYTE_COUNT = 2000000;
+static constexpr TickType_t WAIT_TIMEOUT = 1000; // ms，远大于生产者的最长暂停
+
+static std::atomic<int> failures{0}; // 消费者出错退出后生产者随之停止
+
+// 带校验的条目，拷贝不完整时校验失败
+struct Item
+{
+    uint32_t seq;
+    uint32_t check;
+};
+
+static uint32_t item_check(uint32_t seq)
+{
+    return ~seq * 2654435761U;
+}
+
+// 消费者取空后阻塞等待，返回false表示等满了超时，即丢失唤醒（数据仍未收完时生产者不会停顿这么久，
+// 超时后生产者多半已写满，wait()的返回值为true，因此只看等待时间）
+// 已取走数据对应的过期通知会使wait()立即返回false，这种情况不算失败，下次调用再阻塞
+static bool wait_data(SpscRingBase &ring)
+{
+    auto start = std::chrono::steady_clock::now();
+    ring.wait(WAIT_TIMEOUT);
+    return std::chrono::steady_clock::now() - start < std::chrono::milliseconds(WAIT_TIMEOUT);
+}
+
+static uint8_t stream_byte(uint32_t pos)
+{
+    return (uint8_t)(pos * 131U + (pos >> 8));
+}
+
+// 生产者随机暂停，约1/8的概率让出或短暂休眠
+static void producer_pause(std::mt19937 &rng)
+{
+    uint32_t r = rng() & 63;
+    if (r == 0)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    else if (r < 8)
+    {
+        std::this_thread::yield();
+    }
+}
+
+static void test_item_ring(void)
+{
+    static SpscRing<Item, 64> ring;
+    std::atomic<bool> consumerReady{false};
+    uint32_t waits = 0;
+
+    std::thread consumer([&] {
+        ring.setConsumer(xTaskGetCurrentTaskHandle());
+        consumerReady.store(true);
+
+        Item items[16];
+        uint32_t expected = 0;
+        while (expected < ITEM_COUNT)
+        {
+            uint32_t n = ring.pop(items, (expected & 15) + 1);
+            for (uint32_t i = 0; i < n; i++, expected++)
+            {
+                if (items[i].seq != expected || items[i].check != item_check(expected))
+                {
+                    fprintf(stderr, "item ring: got %u/0x%08x, expected %u\n", (unsigned)items[i].seq,
+                            (unsigned)items[i].check, (unsigned)expected);
+                    failures++;
+                    return;
+                }
+            }
+            if (n == 0)
+            {
+                waits++;
+                if (!wait_data(ring))
+                {
+                    fprintf(stderr, "item ring: lost wakeup after %u items\n", (unsigned)expected);
+                    failures++;
+                    return;
+                }
+            }
+        }
+    });
+
+    while (!consumerReady.load())
+    {
+        std::this_thread::yield();
+    }
+
+    std::mt19937 rng(1);
+    Item items[16];
+    uint32_t seq = 0;
+    while (seq < ITEM_COUNT && failures == 0)
+    {
+        uint32_t count = (rng() & 15) + 1;
+        if (count > ITEM_COUNT - seq)
+        {
+            count = ITEM_COUNT - seq;
+        }
+        for (uint32_t i = 0; i < count; i++)
+        {
+            items[i].seq = seq + i;
+            items[i].check = item_check(seq + i);
+        }
+
+        // 交替使用任务与中断版本，两者只在唤醒方式上不同
+        uint32_t pushed;
+        if (rng() & 1)
+        {
+            pushed = ring.push(items, count);
+        }
+        else
+        {
+            BaseType_t woken = pdFALSE;
+            pushed = ring.push_ISR(items, count, woken);
+        }
+        seq += pushed;
+        if (pushed == 0)
+        {
+            std::this_thread::yield();
+        }
+        producer_pause(rng);
+    }
+
+    consumer.join();
+    if (failures == 0)
+    {
+        printf("item ring: %u items, %u waits\n", (unsigned)ITEM_COUNT, (unsigned)waits);
+    }
+}
+
+static void test_byte_ring(void)
+{
+    static ByteRing<256> ring;
+    std::atomic<bool> consumerReady{false};
+    uint32_t waits = 0;
+
+    std::thread consumer([&] {
+        ring.setConsumer(xTaskGetCurrentTaskHandle());
+        consumerReady.store(true);
+
+        uint8_t data[97];
+        uint32_t pos = 0;
+        bool inPlace = false;
+        while (pos < BYTE_COUNT)
+        {
+            // read()与readRegion()/consume()交替使用
+            uint32_t n;
+            const uint8_t *region = data;
+            if (inPlace)
+            {
+                n = ring.readRegion(region);
+            }
+            else
+            {
+                n = ring.read(data, (pos % sizeof(data)) + 1);
+            }
+            for (uint32_t i = 0; i < n; i++, pos++)
+            {
+                if (region[i] != stream_byte(pos))
+                {
+                    fprintf(stderr, "byte ring: byte %u = 0x%02x, expected 0x%02x\n", (unsigned)pos,
+                            (unsigned)region[i], (unsigned)stream_byte(pos));
+                    failures++;
+                    return;
+                }
+            }
+            if (inPlace)
+            {
+                ring.consume(n);
+            }
+            inPlace = !inPlace;
+
+            if (n == 0 && ring.isEmpty())
+            {
+                waits++;
+                if (!wait_data(ring))
+                {
+                    fprintf(stderr, "byte ring: lost wakeup after %u bytes\n", (unsigned)pos);
+                    failures++;
+                    return;
+                }
+            }
+        }
+    });
+
+    while (!consumerReady.load())
+    {
+        std::this_thread::yield();
+    }
+
+    std::mt19937 rng(2);
+    uint8_t data[300];
+    uint32_t pos = 0;
+    while (pos < BYTE_COUNT && failures == 0)
+    {
+        uint32_t len = rng() % sizeof(data) + 1;
+        if (len > BYTE_COUNT - pos)
+        {
+            len = BYTE_COUNT - pos;
+        }
+        for (uint32_t i = 0; i < len; i++)
+        {
+            data[i] = stream_byte(pos + i);
+        }
+
+        uint32_t written;
+        if (rng() & 1)
+        {
+            written = ring.write(data, len);
+        }
+        else
+        {
+            BaseType_t woken = pdFALSE;
+            written = ring.write_ISR(data, len, woken);
+        }
+        pos += written;
+        if (written == 0)
+        {
+            std::this_thread::yield();
+        }
+        producer_pause(rng);
+    }
+
+    consumer.join();
+    if (failures == 0)
+    {
+        printf("byte ring: %u bytes, %u waits\n", (unsigned)BYTE_COUNT, (unsigned)waits);
+    }
+}
+
+int main(void)
+{
+    test_item_ring();
+    test_byte_ring();
+
+    if (failures)
+    {
+        fprintf(stderr, "spsc_ring_test: %d failures\n", failures.load());
+        return 1;
+    }
+    printf("spsc_ring_test: ok\n");
+    return 0;
+}
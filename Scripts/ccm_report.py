@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""Report CCM-RAM usage per module from the GNU ld map file.
+
+The CCM-RAM output sections (.ccmram, .ccmbss) are scanned for input sections, each one is attributed to the
+object file (module) it comes from, together with the symbols it defines.
+
+Usage:
+    ccm_report.py build/wht_master.map
+    ccm_report.py build/wht_master.map --symbols
+"""
+
+import argparse
+import os
+import re
+import sys
+
+CCM_SECTIONS = (".ccmram", ".ccmbss")
+CCM_REGION = "CCMRAM"
+HEX = r"0x[0-9a-fA-F]+"
+REGION_RE = re.compile(r"^(\S+)\s+(%s)\s+(%s)" % (HEX, HEX))
+OUT_SECTION_RE = re.compile(r"^(\.\S+)(?:\s+(%s)\s+(%s))?\s*$" % (HEX, HEX))
+IN_SECTION_RE = re.compile(r"^ (\.\S+|\*fill\*|COMMON)(?:\s+(%s)\s+(%s)(?:\s+(.*))?)?\s*$" % (HEX, HEX))
+ADDR_SIZE_RE = re.compile(r"^\s+(%s)\s+(%s)(?:\s+(.*))?\s*$" % (HEX, HEX))
+SYMBOL_RE = re.compile(r"^\s+(%s)\s+([^=\s].*)$" % HEX)
+
+
+def module_name(path):
+    """CMakeFiles/x.dir/User/App/MasterServer.cpp.obj -> MasterServer.cpp, libfoo.a(bar.c.obj) -> libfoo.a(bar.c)"""
+    path = path.strip()
+    m = re.match(r"^(.*)\((.*)\)$", path)
+    if m:
+        return "%s(%s)" % (os.path.basename(m.group(1)), module_name(m.group(2)))
+    return re.sub(r"\.(obj|o)$", "", os.path.basename(path))
+
+
+def parse_map(lines):
+    region_size = None
+    modules = {}
+    out_section = None
+    current = None
+    pending = None
+
+    for line in lines:
+        line = line.rstrip("\n")
+
+        m = REGION_RE.match(line)
+        if m and m.group(1) == CCM_REGION and region_size is None:
+            region_size = int(m.group(3), 16)
+            continue
+
+        # a new output section starts at column 0
+        if line and not line[0].isspace():
+            m = OUT_SECTION_RE.match(line)
+            out_section = m.group(1) if m and m.group(1) in CCM_SECTIONS else None
+            current = pending = None
+            continue
+        if out_section is None:
+            continue
+
+        # the name of a long input section is wrapped, address and size follow on the next line
+        if pending is not None:
+            m = ADDR_SIZE_RE.match(line)
+            pending = None
+            if m and m.group(3):
+                current = add_input(modules, int(m.group(2), 16), m.group(3))
+            continue
+
+        m = IN_SECTION_RE.match(line)
+        if m:
+            name, _, size, obj = m.groups()
+            current = None
+            if size is None:
+                pending = name
+            elif name != "*fill*" and obj:
+                current = add_input(modules, int(size, 16), obj)
+            elif name == "*fill*":
+                modules.setdefault("*fill*", {"size": 0, "symbols": []})["size"] += int(size, 16)
+            continue
+
+        m = SYMBOL_RE.match(line)
+        if m and current is not None and " = " not in m.group(2) and not m.group(2).startswith((".", "*")):
+            current["symbols"].append(m.group(2).strip())
+
+    return region_size, modules
+
+
+def add_input(modules, size, obj):
+    mod = modules.setdefault(module_name(obj), {"size": 0, "symbols": []})
+    mod["size"] += size
+    return mod
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("map", help="linker map file")
+    parser.add_argument("--symbols", action="store_true", help="list the symbols placed by each module")
+    args = parser.parse_args()
+
+    with open(args.map, "r", errors="replace") as f:
+        region_size, modules = parse_map(f)
+
+    total = sum(m["size"] for m in modules.values())
+    print("CCM-RAM usage by module:")
+    for name, mod in sorted(modules.items(), key=lambda kv: -kv[1]["size"]):
+        if not mod["size"]:
+            continue
+        print("  %-40s %8u" % (name, mod["size"]))
+        if args.symbols:
+            for sym in mod["symbols"]:
+                print("      %s" % sym)
+    if region_size:
+        print("  %-40s %8u / %u (%.1f%%)" % ("total", total, region_size, 100.0 * total / region_size))
+    else:
+        print("  %-40s %8u" % ("total", total))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,210 @@
+#!/usr/bin/env python3
+"""Decode the EasyLogger binary log stream (plugins/bin) using the firmware ELF.
+
+The log UART carries normal text lines mixed with binary frames:
+    0xA5 0x5A <word count> <words, little endian> <xor of word bytes>
+Words: header, timestamp(us), format address, tag address, arguments.
+Format and tag strings are looked up in the ELF by address.
+
+With --udp the script acts as the network log collector (User/Task/log_udp.c), every datagram carries
+    'E' 'L' <version> <reserved> <u32 seq> <u32 dropped bytes>
+followed by complete text lines and binary frames.
+
+Usage:
+    elog_bin_decode.py build/wht_master.elf capture.bin
+    elog_bin_decode.py build/wht_master.elf --port /dev/ttyUSB0 --baud 921600
+    elog_bin_decode.py build/wht_master.elf --udp 8090
+"""
+
+import argparse
+import io
+import re
+import struct
+import sys
+
+SYNC = b"\xa5\x5a"
+HDR_MARK = 0xB1000000
+HDR_WORDS = 4
+LEVEL_NAMES = "AEWIDV"
+UDP_HDR = struct.Struct("<2sBBII")
+FMT_RE = re.compile(r"%([-+ #0]*)(\d+|\*)?(?:\.(\d+))?(hh|h|ll|l|z|j|t)?([diouxXcspf%])")
+
+
+class ElfImage:
+    """Minimal ELF32 little-endian reader, only allocated PROGBITS sections are needed."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+        if data[:4] != b"\x7fELF" or data[4] != 1 or data[5] != 1:
+            raise ValueError("%s is not a little endian ELF32 file" % path)
+        shoff, = struct.unpack_from("<I", data, 0x20)
+        shentsize, shnum = struct.unpack_from("<HH", data, 0x2E)
+        self.sections = []
+        for i in range(shnum):
+            (_, sh_type, sh_flags, sh_addr, sh_offset, sh_size) = struct.unpack_from("<IIIIII", data,
+                                                                                      shoff + i * shentsize)
+            # SHT_PROGBITS with SHF_ALLOC
+            if sh_type == 1 and (sh_flags & 0x2) and sh_size:
+                self.sections.append((sh_addr, sh_size, data[sh_offset:sh_offset + sh_size]))
+
+    def string(self, addr):
+        for base, size, blob in self.sections:
+            if base <= addr < base + size:
+                end = blob.find(b"\0", addr - base)
+                if end < 0:
+                    end = size
+                return blob[addr - base:end].decode("utf-8", "replace")
+        return None
+
+
+def format_record(elf, words):
+    hdr, ts, fmt_addr, tag_addr = words[:HDR_WORDS]
+    args = words[HDR_WORDS:]
+    level = (hdr >> 8) & 0xFF
+    lvl = LEVEL_NAMES[level] if level < len(LEVEL_NAMES) else "?"
+
+    if fmt_addr == 0:
+        return "[%10u] %s/elog_bin: %u records dropped" % (ts, lvl, args[0] if args else 0)
+
+    tag = elf.string(tag_addr) or "0x%08x" % tag_addr
+    fmt = elf.string(fmt_addr)
+    if fmt is None:
+        return "[%10u] %s/%s: <unknown format 0x%08x> %s" % (ts, lvl, tag, fmt_addr,
+                                                              " ".join("0x%08x" % a for a in args))
+
+    arg_iter = iter(args)
+
+    def convert(m):
+        flags, width, prec, _, conv = m.groups()
+        if conv == "%":
+            return "%"
+        value = next(arg_iter, 0)
+        spec = "%" + flags + (width or "") + ("." + prec if prec is not None else "")
+        if conv in "di":
+            value = value - (1 << 32) if value & 0x80000000 else value
+            return (spec + "d") % value
+        if conv in "ouxX":
+            return (spec + conv) % value
+        if conv == "c":
+            return (spec + "c") % chr(value & 0xFF)
+        if conv == "s":
+            s = elf.string(value)
+            return (spec + "s") % (s if s is not None else "<0x%08x>" % value)
+        if conv == "p":
+            return "0x%08x" % value
+        # floating point arguments are truncated on target, show the raw word
+        return "<f:0x%08x>" % value
+
+    return "[%10u] %s/%s: %s" % (ts, lvl, tag, FMT_RE.sub(convert, fmt))
+
+
+def decode_stream(elf, chunks, out):
+    buf = bytearray()
+    for chunk in chunks:
+        buf += chunk
+        while True:
+            pos = buf.find(SYNC)
+            if pos < 0:
+                # keep a possible partial sync byte
+                keep = 1 if buf.endswith(SYNC[:1]) else 0
+                out.write(buf[:len(buf) - keep].decode("utf-8", "replace"))
+                del buf[:len(buf) - keep]
+                break
+            if pos:
+                out.write(buf[:pos].decode("utf-8", "replace"))
+                del buf[:pos]
+            if len(buf) < 3:
+                break
+            count = buf[2]
+            frame_len = 3 + count * 4 + 1
+            if count < HDR_WORDS or count > HDR_WORDS + 8:
+                out.write(buf[:1].decode("utf-8", "replace"))
+                del buf[:1]
+                continue
+            if len(buf) < frame_len:
+                break
+            payload = bytes(buf[3:frame_len - 1])
+            checksum = 0
+            for b in payload:
+                checksum ^= b
+            words = struct.unpack("<%dI" % count, payload)
+            if checksum != buf[frame_len - 1] or (words[0] & 0xFF000000) != HDR_MARK:
+                out.write(buf[:1].decode("utf-8", "replace"))
+                del buf[:1]
+                continue
+            out.write(format_record(elf, words) + "\n")
+            del buf[:frame_len]
+        out.flush()
+
+
+def file_chunks(f):
+    while True:
+        chunk = f.read(4096)
+        if not chunk:
+            return
+        yield chunk
+
+
+def serial_chunks(port, baud):
+    import serial  # pyserial, only needed for live decoding
+
+    with serial.Serial(port, baud, timeout=0.1) as ser:
+        while True:
+            chunk = ser.read(4096)
+            if chunk:
+                yield chunk
+
+
+def decode_udp(elf, port, out):
+    import socket
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind(("", port))
+    next_seq = {}
+    while True:
+        data, (ip, _) = sock.recvfrom(2048)
+        if len(data) < UDP_HDR.size:
+            continue
+        magic, version, _, seq, dropped = UDP_HDR.unpack_from(data)
+        if magic != b"EL" or version != 1:
+            continue
+        expected = next_seq.get(ip)
+        if expected is not None and seq != expected:
+            out.write("[%s] collector: %d datagrams lost\n" % (ip, (seq - expected) & 0xFFFFFFFF))
+        next_seq[ip] = (seq + 1) & 0xFFFFFFFF
+        if dropped:
+            out.write("[%s] collector: %u log bytes dropped by target\n" % (ip, dropped))
+        text = io.StringIO()
+        decode_stream(elf, [data[UDP_HDR.size:]], text)
+        for line in text.getvalue().splitlines():
+            out.write("[%s] %s\n" % (ip, line))
+        out.flush()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="firmware ELF matching the running image")
+    parser.add_argument("capture", nargs="?", help="raw UART capture file, stdin if omitted")
+    parser.add_argument("--port", help="decode live from a serial port")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--udp", type=int, metavar="PORT", help="collect network logs on a UDP port")
+    args = parser.parse_args()
+
+    elf = ElfImage(args.elf)
+    try:
+        if args.udp:
+            decode_udp(elf, args.udp, sys.stdout)
+        elif args.port:
+            decode_stream(elf, serial_chunks(args.port, args.baud), sys.stdout)
+        elif args.capture:
+            with open(args.capture, "rb") as f:
+                decode_stream(elf, file_chunks(f), sys.stdout)
+        else:
+            decode_stream(elf, file_chunks(sys.stdin.buffer), sys.stdout)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
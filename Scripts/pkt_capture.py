@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+"""Collect the traffic capture stream (User/Task/pkt_capture.c) into a file, or summarize a capture file.
+
+Every capture datagram carries
+    'P' 'C' <version> <reserved> <u32 seq> <u32 dropped records>
+followed by records
+    <u32 timestamp us> <u16 len> <u8 source> <u8 flags> <len bytes>
+Source 0 is a UWB rx buffer, 1 a backend UDP datagram. Flag 0x01 marks a record continued in the next record of
+the same source.
+
+The capture file is an 8 byte header ("WHCP", u8 version, 3 reserved bytes) followed by the records in sequence
+order. Lost datagrams and records dropped on the target become a gap record (source 0xFF, u32 dropped count, 0 when
+unknown), wht_master_replay discards records interrupted by a gap.
+
+Usage:
+    pkt_capture.py --udp 8091 -o trace.whcp
+    pkt_capture.py --udp 8091 -o trace.whcp --duration 60
+    pkt_capture.py --info trace.whcp
+"""
+
+import argparse
+import socket
+import struct
+import sys
+import time
+
+FILE_MAGIC = b"WHCP"
+FILE_VERSION = 1
+FILE_HDR = struct.Struct("<4sB3x")
+UDP_HDR = struct.Struct("<2sBBII")
+REC_HDR = struct.Struct("<IHBB")
+SRC_UWB = 0x00
+SRC_UDP = 0x01
+SRC_GAP = 0xFF
+FLAG_MORE = 0x01
+SOURCE_NAMES = {SRC_UWB: "uwb", SRC_UDP: "udp", SRC_GAP: "gap"}
+REORDER_WINDOW = 8  # datagrams held back to put records of different target tasks back in order
+
+
+class CaptureWriter:
+    """Writes datagram payloads in sequence order, lost sequence numbers become gap records."""
+
+    def __init__(self, out):
+        self.out = out
+        self.out.write(FILE_HDR.pack(FILE_MAGIC, FILE_VERSION))
+        self.expected = None
+        self.pending = {}
+        self.last_ts = 0
+        self.datagrams = 0
+        self.records = 0
+        self.gaps = 0
+        self.dropped = 0
+
+    def gap(self, count):
+        self.out.write(REC_HDR.pack(self.last_ts, 4, SRC_GAP, 0) + struct.pack("<I", count))
+        self.gaps += 1
+        self.dropped += count
+
+    def write(self, dropped, payload):
+        if dropped:
+            self.gap(dropped)
+        pos = 0
+        while pos + REC_HDR.size <= len(payload):
+            ts, length, _, flags = REC_HDR.unpack_from(payload, pos)
+            end = pos + REC_HDR.size + length
+            if end > len(payload):
+                break
+            self.out.write(payload[pos:end])
+            self.last_ts = ts
+            if not flags & FLAG_MORE:
+                self.records += 1
+            pos = end
+
+    def push(self, seq, dropped, payload):
+        self.datagrams += 1
+        if self.expected is None:
+            self.expected = seq
+        if (seq - self.expected) & 0xFFFFFFFF >= 0x80000000:
+            return  # arrived after its slot was declared lost
+        self.pending[seq] = (dropped, payload)
+        self.drain(force=False)
+
+    def drain(self, force):
+        while self.pending:
+            if self.expected in self.pending:
+                self.write(*self.pending.pop(self.expected))
+                self.expected = (self.expected + 1) & 0xFFFFFFFF
+            elif force or len(self.pending) > REORDER_WINDOW:
+                self.gap(0)
+                self.expected = (self.expected + 1) & 0xFFFFFFFF
+            else:
+                break
+
+
+def collect(port, path, duration):
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 4 * 1024 * 1024)
+    sock.bind(("0.0.0.0", port))
+    sock.settimeout(0.5)
+    deadline = time.monotonic() + duration if duration else None
+
+    with open(path, "wb") as out:
+        writer = CaptureWriter(out)
+        try:
+            while deadline is None or time.monotonic() < deadline:
+                try:
+                    data = sock.recv(65535)
+                except socket.timeout:
+                    continue
+                if len(data) < UDP_HDR.size:
+                    continue
+                magic, version, _, seq, dropped = UDP_HDR.unpack_from(data)
+                if magic != b"PC" or version != 1:
+                    continue
+                writer.push(seq, dropped, data[UDP_HDR.size:])
+        except KeyboardInterrupt:
+            pass
+        writer.drain(force=True)
+
+    print("%s: %d datagrams, %d records, %d gaps (%d records dropped on target)" %
+          (path, writer.datagrams, writer.records, writer.gaps, writer.dropped), file=sys.stderr)
+
+
+def info(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if len(data) < FILE_HDR.size or FILE_HDR.unpack_from(data)[0] != FILE_MAGIC:
+        sys.exit("%s is not a capture file" % path)
+
+    counts = {}
+    sizes = {}
+    first = last = None
+    base = 0
+    prev = None
+    pos = FILE_HDR.size
+    while pos + REC_HDR.size <= len(data):
+        ts, length, source, flags = REC_HDR.unpack_from(data, pos)
+        pos += REC_HDR.size + length
+        # the 32 bit us timestamp wraps every 71 minutes, records of two tasks may be slightly out of order
+        if prev is not None and ts < prev and prev - ts > 0x80000000:
+            base += 1 << 32
+        prev = ts
+        t = base + ts
+        first = t if first is None else first
+        last = t
+        if source != SRC_GAP and flags & FLAG_MORE:
+            sizes[source] = sizes.get(source, 0) + length
+            continue
+        counts[source] = counts.get(source, 0) + 1
+        sizes[source] = sizes.get(source, 0) + length
+
+    span = (last - first) / 1e6 if first is not None else 0.0
+    print("%s: %.3f s" % (path, span))
+    for source in sorted(counts):
+        name = SOURCE_NAMES.get(source, "0x%02x" % source)
+        rate = counts[source] / span if span > 0 else 0.0
+        print("  %-4s %8d records %10d bytes %10.1f records/s" % (name, counts[source], sizes[source], rate))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--udp", type=int, metavar="PORT", help="collect captures on a UDP port")
+    parser.add_argument("-o", "--output", help="capture file written by --udp")
+    parser.add_argument("--duration", type=float, help="stop collecting after this many seconds")
+    parser.add_argument("--info", metavar="FILE", help="summarize a capture file")
+    args = parser.parse_args()
+
+    if args.info:
+        info(args.info)
+    elif args.udp and args.output:
+        collect(args.udp, args.output, args.duration)
+    else:
+        parser.error("either --udp PORT -o FILE or --info FILE is required")
+
+
+if __name__ == "__main__":
+    main()
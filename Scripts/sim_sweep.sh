@@ -0,0 +1,30 @@
+#!/bin/sh
+#
+# 主机负载仿真扫描：按从机数量N依次运行wht_master_sim，汇总成一张表
+# 用法：Scripts/sim_sweep.sh [wht_master_sim的其它参数，如 -t 10 -c 4 -i 5 -p 1]
+# 环境变量：SIM（仿真程序路径，默认build/Host/Host/wht_master_sim），N_LIST（N的取值）
+#
+
+SIM=${SIM:-build/Host/Host/wht_master_sim}
+N_LIST=${N_LIST:-"1 2 5 10 20 50 100 200 255 500"}
+
+if [ ! -x "$SIM" ]; then
+    echo "找不到仿真程序: $SIM"
+    echo "请先构建: cmake --preset Host && cmake --build --preset Host"
+    exit 1
+fi
+
+HEADER_PRINTED=0
+for N in $N_LIST; do
+    # elog同样输出到stdout，只保留表头（以#开头）和数据行（以两个空格开头）
+    OUTPUT=$("$SIM" -n "$N" "$@" 2>/dev/null | grep -E '^(#|  )')
+    if [ -z "$OUTPUT" ]; then
+        echo "N=$N 运行失败" >&2
+        continue
+    fi
+    if [ $HEADER_PRINTED -eq 0 ]; then
+        echo "$OUTPUT" | grep '^#'
+        HEADER_PRINTED=1
+    fi
+    echo "$OUTPUT" | grep -v '^#'
+done
@@ -1,8 +1,13 @@
 #include "B2M_MessageHandlers.h"
 
+#include <cstring>
+
+#include "FreeRTOS.h"
 #include "MasterServer.h"
+#include "cycle_prof.hpp"
 #include "elog.h"
 #include "master_app.h"
+#include "sys_mon.h"
 #include "uwb_task.h"
 
 // Slave Configuration Message Handler
@@ -456,4 +461,99 @@ void SetUwbChannelHandler::executeActions(const Message &message, MasterServer *
 
     elog_d("SetUwbChannelHandler", "UWB channel setting action completed for channel %d",
            static_cast<int>(channelMsg->channel));
-}
\ No newline at end of file
+}
+
+// System Stats Handler
+std::unique_ptr<Message> SysStatsHandler::processMessage(const Message &message, MasterServer *server)
+{
+    const auto *statsMsg = dynamic_cast<const Backend2Master::SysStatsReqMessage *>(&message);
+    if (!statsMsg)
+        return nullptr;
+
+    // 快照由MainTask周期采样，这里只读取，不阻塞后端数据处理
+    static sys_mon_snapshot_t snapshot;
+    if (SysMon_GetSnapshot(&snapshot) != 0)
+    {
+        elog_w("SysStatsHandler", "No system stats sampled yet");
+        memset(&snapshot, 0, sizeof(snapshot));
+    }
+
+    auto response = std::make_unique<Master2Backend::SysStatsResponseMessage>();
+    response->periodMs = snapshot.period_ms;
+    response->cpuLoadPermille = snapshot.cpu_load_permille;
+    response->freeHeap = xPortGetFreeHeapSize();
+    response->minFreeHeap = xPortGetMinimumEverFreeHeapSize();
+    response->taskCount = snapshot.task_count;
+    response->tasks.reserve(snapshot.task_count);
+    for (uint8_t i = 0; i < snapshot.task_count; i++)
+    {
+        const sys_mon_task_t &src = snapshot.tasks[i];
+        Master2Backend::SysStatsResponseMessage::TaskInfo task = {};
+        memcpy(task.name, src.name, sizeof(task.name));
+        task.priority = src.priority;
+        task.cpuPermille = src.cpu_permille;
+        task.stackFreeMin = src.stack_free_min;
+        task.switchesPerSec = src.switches_per_sec;
+        response->tasks.push_back(task);
+    }
+
+    elog_v("SysStatsHandler", "System stats response: %d tasks, CPU %d permille", snapshot.task_count,
+           snapshot.cpu_load_permille);
+    return std::move(response);
+}
+
+void SysStatsHandler::executeActions(const Message &message, MasterServer *server)
+{
+    // No additional actions needed for system stats request
+    elog_d("SysStatsHandler", "System stats request processed");
+}
+
+// Cycle Profile Handler
+std::unique_ptr<Message> CycleProfHandler::processMessage(const Message &message, MasterServer *server)
+{
+    const auto *profMsg = dynamic_cast<const Backend2Master::CycleProfReqMessage *>(&message);
+    if (!profMsg)
+        return nullptr;
+
+    auto response = std::make_unique<Master2Backend::CycleProfResponseMessage>();
+    response->clockHz = 0;
+    response->slotUs = 0;
+    response->histNum = 0;
+    response->probeCount = 0;
+
+#if CYCLE_PROFILE
+    response->clockHz = CycleProf_GetClockHz();
+    response->slotUs = CycleProf_GetSlotUs();
+    response->histNum = CYCLE_PROF_HIST_BUCKETS;
+    response->probeCount = CYCLE_PROF_COUNT;
+    response->probes.reserve(CYCLE_PROF_COUNT);
+    for (uint8_t i = 0; i < CYCLE_PROF_COUNT; i++)
+    {
+        CycleProfId id = static_cast<CycleProfId>(i);
+        cycle_prof_stats_t stats;
+        CycleProf_Get(id, &stats, profMsg->reset);
+
+        Master2Backend::CycleProfResponseMessage::ProbeInfo probe = {};
+        strncpy(probe.name, CycleProf_GetName(id), sizeof(probe.name) - 1);
+        probe.budget = CycleProf_GetBudget(id);
+        probe.count = stats.count;
+        probe.overBudget = stats.over_budget;
+        probe.min = stats.min;
+        probe.max = stats.max;
+        probe.total = stats.total;
+        probe.hist.assign(stats.hist, stats.hist + CYCLE_PROF_HIST_BUCKETS);
+        response->probes.push_back(probe);
+    }
+#else
+    elog_w("CycleProfHandler", "Cycle profiling not enabled (CMake CYCLE_PROFILE)");
+#endif
+
+    elog_v("CycleProfHandler", "Cycle profile response: %d probes, reset %d", response->probeCount, profMsg->reset);
+    return std::move(response);
+}
+
+void CycleProfHandler::executeActions(const Message &message, MasterServer *server)
+{
+    // 统计在processMessage中读取（及清零），无需额外动作
+    elog_d("CycleProfHandler", "Cycle profile request processed");
+}
@@ -191,4 +191,40 @@ class SetUwbChannelHandler : public IMessageHandler
     SetUwbChannelHandler() = default;
     SetUwbChannelHandler(const SetUwbChannelHandler &) = delete;
     SetUwbChannelHandler &operator=(const SetUwbChannelHandler &) = delete;
+};
+
+// System Stats Request Message Handler
+class SysStatsHandler : public IMessageHandler
+{
+  public:
+    static SysStatsHandler &getInstance()
+    {
+        static SysStatsHandler instance;
+        return instance;
+    }
+    std::unique_ptr<Message> processMessage(const Message &message, MasterServer *server) override;
+    void executeActions(const Message &message, MasterServer *server) override;
+
+  private:
+    SysStatsHandler() = default;
+    SysStatsHandler(const SysStatsHandler &) = delete;
+    SysStatsHandler &operator=(const SysStatsHandler &) = delete;
+};
+
+// Cycle Profile Request Message Handler
+class CycleProfHandler : public IMessageHandler
+{
+  public:
+    static CycleProfHandler &getInstance()
+    {
+        static CycleProfHandler instance;
+        return instance;
+    }
+    std::unique_ptr<Message> processMessage(const Message &message, MasterServer *server) override;
+    void executeActions(const Message &message, MasterServer *server) override;
+
+  private:
+    CycleProfHandler() = default;
+    CycleProfHandler(const CycleProfHandler &) = delete;
+    CycleProfHandler &operator=(const CycleProfHandler &) = delete;
 };
\ No newline at end of file
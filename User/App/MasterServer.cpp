@@ -6,12 +6,24 @@
 
 #include "FreeRTOS.h"
 #include "MutexCPP.h"
+#include "block_pool.h"
+#include "cycle_prof.hpp"
+#include "heap_prof.h"
+#include "sys_mon.h"
+#include "cmsis_os.h"
 #include "elog.h"
+#include "elog_bin.h"
+#include "elog_rl.h"
 #include "hptimer.hpp"
+#include "pkt_capture.h"
 #include "udp_task.h"
 #include "utils/ByteUtils.h"
 #include "uwb_task.h"
 
+// SlaveDataProcT与MainTask的存储槽，放在CCM RAM中
+CCM_RAM CcmSlot<MasterServer::SlaveDataProcT> MasterServer::slaveTaskSlot;
+CCM_RAM CcmSlot<MasterServer::MainTask> MasterServer::mainTaskSlot;
+
 // MasterServer 构造函数实现
 MasterServer::MasterServer()
     : pendingCommandsMutex("PendingCommandsMutex"), lastSyncTime(0), initialTimeSyncCompleted(false)
@@ -21,9 +33,23 @@ MasterServer::MasterServer()
 
     processor.setMTU(FRAME_LEN_MAX);
 
-    slaveDataProcessingTask = std::make_unique<SlaveDataProcT>(*this);
+    // 后端地址只解析一次，转发路径直接使用缓存的ip_addr_t
+    if (UDP_ResolveEndpoint(&backendEndpoint, DEFAULT_BACKEND_IP, DEFAULT_BACKEND_PORT) != 0)
+    {
+        elog_e(TAG, "Invalid backend address %s:%d", DEFAULT_BACKEND_IP, DEFAULT_BACKEND_PORT);
+    }
+
+    slaveDataProcessingTask.create(*this);
+#if RTOS_STATIC_ALLOC
+    backendDataProcessingTask.create(*this);
+#else
     backendDataProcessingTask = std::make_unique<BackDataProcT>(*this);
-    mainTask = std::make_unique<MainTask>(*this);
+#endif
+    mainTask.create(*this);
+    if (!slaveDataProcessingTask.inCcm() || !mainTask.inCcm())
+    {
+        elog_w(TAG, "Task CCM slot in use, task stacks allocated from heap");
+    }
 }
 
 // MasterServer 析构函数实现
@@ -47,6 +73,10 @@ void MasterServer::initializeMessageHandlers()
         &ClearDeviceListHandler::getInstance();
     messageHandlers_[static_cast<uint8_t>(Backend2MasterMessageId::SET_UWB_CHAN_MSG)] =
         &SetUwbChannelHandler::getInstance();
+    messageHandlers_[static_cast<uint8_t>(Backend2MasterMessageId::SYS_STATS_REQ_MSG)] =
+        &SysStatsHandler::getInstance();
+    messageHandlers_[static_cast<uint8_t>(Backend2MasterMessageId::CYCLE_PROF_REQ_MSG)] =
+        &CycleProfHandler::getInstance();
 }
 
 void MasterServer::initializeSlave2MasterHandlers()
@@ -94,7 +124,7 @@ void MasterServer::sendResponseToBackend(std::unique_ptr<Message> response)
         return;
     }
 
-    elog_i(TAG, "Sending Master2Backend response: %s", response->getMessageTypeName());
+    elog_bin_i(TAG, "Sending Master2Backend response: %s", response->getMessageTypeName());
     elog_v(TAG, "Starting message serialization...");
 
     auto responseData = processor.packMaster2BackendMessage(*response);
@@ -138,7 +168,7 @@ void MasterServer::sendCommandToSlave(uint32_t slaveId, std::unique_ptr<Message>
 
     auto commandData = processor.packMaster2SlaveMessage(slaveId, *command);
 
-    elog_i(TAG, "Sending Master2Slave command to 0x%08X: %s", slaveId, command->getMessageTypeName());
+    elog_bin_i(TAG, "Sending Master2Slave command to 0x%08X: %s", slaveId, command->getMessageTypeName());
 
     bool sendSuccess = true;
     for (auto &fragment : commandData)
@@ -736,7 +766,7 @@ void MasterServer::processPingSessions()
 
 void MasterServer::processBackend2MasterMessage(const Message &message)
 {
-    elog_i(TAG, "Received Backend2Master message: %s", message.getMessageTypeName());
+    elog_bin_i(TAG, "Received Backend2Master message: %s", message.getMessageTypeName());
 
     uint8_t messageId = message.getMessageId();
     elog_v(TAG, "Processing Backend2Master message, ID: 0x%02X", static_cast<int>(messageId));
@@ -768,7 +798,7 @@ void MasterServer::processBackend2MasterMessage(const Message &message)
 
 void MasterServer::processSlave2MasterMessage(uint32_t slaveId, const Message &message)
 {
-    elog_i(TAG, "Received Slave2Master message from slave 0x%08X: %s", slaveId, message.getMessageTypeName());
+    elog_bin_i(TAG, "Received Slave2Master message from slave 0x%08X: %s", slaveId, message.getMessageTypeName());
 
     uint8_t messageId = message.getMessageId();
     elog_v(TAG, "Processing Slave2Master message from slave 0x%08X, ID: 0x%02X", slaveId, static_cast<int>(messageId));
@@ -803,6 +833,7 @@ void MasterServer::processSlave2MasterMessage(uint32_t slaveId, const Message &m
 
 void MasterServer::processFrame(Frame &frame)
 {
+    CYCLE_PROF_SCOPE(CYCLE_PROF_PROCESS_FRAME);
     elog_v(TAG, "Processing frame - PacketId: 0x%02X, payload size: %d", static_cast<int>(frame.packetId),
            frame.payload.size());
 
@@ -878,6 +909,7 @@ void MasterServer::processTimeSync()
 
     // 获取有效的采集间隔
     uint32_t intervalMs = static_cast<uint32_t>(dm.getEffectiveInterval());
+    CYCLE_PROF_SET_SLOT_US(intervalMs * 1000); // 热点函数耗时预算按时隙间隔计算
 
     // 计算完整的TDMA周期时间D
     uint32_t tdmaCycleMs = startupDelayMs + (totalConductionNum * intervalMs) + extraDelayMs;
@@ -904,7 +936,8 @@ void MasterServer::processTimeSync()
 
         // 启动时间设置为当前时间加上启动延迟时间
         syncCmd->startTime = timestampUs + (startupDelayMs * 1000);
-        elog_i(TAG, "startTime: %lu us", syncCmd->startTime);
+        elog_bin_i(TAG, "startTime: %lu.%06lu s", static_cast<unsigned long>(syncCmd->startTime / 1000000),
+                   static_cast<unsigned long>(syncCmd->startTime % 1000000));
 
         // 构建从机配置列表
         buildSlaveConfigsForSync(*syncCmd, dm);
@@ -925,6 +958,7 @@ void MasterServer::processTimeSync()
 
 void MasterServer::buildSlaveConfigsForSync(Master2Slave::SyncMessage &syncMsg, const DeviceManager &dm)
 {
+    CYCLE_PROF_SCOPE(CYCLE_PROF_BUILD_SYNC);
     syncMsg.slaveConfigs.clear();
 
     // 获取按配置顺序排列的所有从机（包括离线设备）
@@ -991,8 +1025,8 @@ void MasterServer::buildSlaveConfigsForSync(Master2Slave::SyncMessage &syncMsg,
 
 bool MasterServer::sendToBackend(std::vector<uint8_t> &frame)
 {
-    // 数据通过UDP_SendData发送
-    int result = UDP_SendData(frame.data(), frame.size(), DEFAULT_BACKEND_IP, DEFAULT_BACKEND_PORT);
+    // 数据通过UDP_SendDataTo发送
+    int result = UDP_SendDataTo(frame.data(), frame.size(), &backendEndpoint);
     if (result == 0)
     {
         elog_v(TAG, "sendToBackend success (%d bytes to %s:%d)", static_cast<int>(frame.size()), DEFAULT_BACKEND_IP,
@@ -1015,18 +1049,18 @@ bool MasterServer::sendToBackend(std::vector<uint8_t> &frame)
             errorMsg = "UDP TX queue full or timeout";
             break;
         }
-        elog_e(TAG, "sendToBackend failed: %s (error code: %d, size: %d, target: %s:%d)", errorMsg, result,
-               static_cast<int>(frame.size()), DEFAULT_BACKEND_IP, DEFAULT_BACKEND_PORT);
+        elog_rl_e(TAG, "sendToBackend failed: %s (error code: %d, size: %d, target: %s:%d)", errorMsg, result,
+                  static_cast<int>(frame.size()), DEFAULT_BACKEND_IP, DEFAULT_BACKEND_PORT);
 
         // 如果是队列满的问题，尝试清理队列
         if (result == -3)
         {
             int queueCount = UDP_GetTxQueueCount();
-            elog_w(TAG, "UDP TX queue count: %d/10, considering queue cleanup", queueCount);
+            elog_rl_w(TAG, "UDP TX queue count: %d/10, considering queue cleanup", queueCount);
             if (queueCount >= 8) // 队列接近满时清理
             {
                 UDP_ClearTxQueue();
-                elog_w(TAG, "UDP TX queue cleared due to congestion");
+                elog_rl_w(TAG, "UDP TX queue cleared due to congestion");
             }
         }
 
@@ -1034,6 +1068,20 @@ bool MasterServer::sendToBackend(std::vector<uint8_t> &frame)
     }
 }
 
+bool MasterServer::sendToBackend(pkt_buf_t *buf)
+{
+    // 缓冲块直接进入UDP发送队列，不拷贝数据
+    int result = UDP_SendBufTo(buf, &backendEndpoint);
+    if (result == 0)
+    {
+        elog_v(TAG, "sendToBackend success (%d bytes to %s:%d)", buf->len, DEFAULT_BACKEND_IP, DEFAULT_BACKEND_PORT);
+        return true;
+    }
+    elog_rl_e(TAG, "sendToBackend failed (error code: %d, size: %d, target: %s:%d)", result, buf->len,
+              DEFAULT_BACKEND_IP, DEFAULT_BACKEND_PORT);
+    return false;
+}
+
 bool MasterServer::sendToSlave(std::vector<uint8_t> &frame)
 {
     static uint32_t consecutiveFailures = 0;
@@ -1052,10 +1100,10 @@ bool MasterServer::sendToSlave(std::vector<uint8_t> &frame)
     // 如果连续失败次数过多，暂时停止发送
     if (consecutiveFailures >= MAX_CONSECUTIVE_FAILURES)
     {
-        elog_w(TAG,
-               "Too many consecutive UWB failures (%d), temporarily stopping "
-               "transmission",
-               consecutiveFailures);
+        elog_rl_w(TAG,
+                  "Too many consecutive UWB failures (%d), temporarily stopping "
+                  "transmission",
+                  consecutiveFailures);
         return false;
     }
 
@@ -1081,185 +1129,198 @@ MasterServer::SlaveDataProcT::SlaveDataProcT(MasterServer &parent)
 {
 }
 
-void MasterServer::SlaveDataProcT::task()
+// 处理一个从机接收缓冲：Slave2Backend帧直接透传，其余帧解析后分发，buf的引用由调用者释放
+void MasterServer::processSlaveData(pkt_buf_t *buf)
 {
-    elog_i(TAG, "SlaveDataProcT started");
-    uwb_rx_msg_t msg;
-    for (;;)
+    static constexpr const char TAG[] = "SlaveDataProcT";
+    CYCLE_PROF_SCOPE(CYCLE_PROF_SLAVE_FRAMES); // 覆盖SLAVE_TO_BACKEND透传与帧解析两条路径
+
+    elog_v(TAG, "SlaveDataProcT recvData size: %d", buf->len);
+    // copy buf to slaveRecvData for parsing, raw forwarding uses buf directly
+    slaveRecvData.assign(buf->data, buf->data + buf->len);
+
+    if (!slaveRecvData.empty())
     {
-        if (UWB_ReceiveData(&msg, 0) == 0)
+        // 检查是否为SLAVE_TO_BACKEND帧，如果是则直接透传
+        bool hasSlaveToBackendFrame = false;
+        size_t pos = 0;
+        while (pos < slaveRecvData.size())
         {
-            elog_v(TAG, "SlaveDataProcT recvData size: %d", msg.data_len);
-            // copy msg.data to recvData
-            recvData.assign(msg.data, msg.data + msg.data_len);
+            // 查找帧头
+            size_t frameStart = processor.findFrameHeader(slaveRecvData, pos);
+            if (frameStart == SIZE_MAX)
+            {
+                break; // 没有找到更多帧头
+            }
 
-            if (!recvData.empty())
+            // 检查帧长度是否足够
+            if (frameStart + 7 > slaveRecvData.size())
             {
-                // 检查是否为SLAVE_TO_BACKEND帧，如果是则直接透传
-                bool hasSlaveToBackendFrame = false;
-                size_t pos = 0;
-                while (pos < recvData.size())
-                {
-                    // 查找帧头
-                    size_t frameStart = parent.processor.findFrameHeader(recvData, pos);
-                    if (frameStart == SIZE_MAX)
-                    {
-                        break; // 没有找到更多帧头
-                    }
+                break; // 帧头不完整
+            }
 
-                    // 检查帧长度是否足够
-                    if (frameStart + 7 > recvData.size())
-                    {
-                        break; // 帧头不完整
-                    }
+            // 检查PacketId是否为SLAVE_TO_BACKEND
+            uint8_t packetId = slaveRecvData[frameStart + 2];
+            if (packetId == static_cast<uint8_t>(PacketId::SLAVE_TO_BACKEND))
+            {
+                // 找到SLAVE_TO_BACKEND帧，提取从机ID并更新lastSeenTime
+                hasSlaveToBackendFrame = true;
 
-                    // 检查PacketId是否为SLAVE_TO_BACKEND
-                    uint8_t packetId = recvData[frameStart + 2];
-                    if (packetId == static_cast<uint8_t>(PacketId::SLAVE_TO_BACKEND))
-                    {
-                        // 找到SLAVE_TO_BACKEND帧，提取从机ID并更新lastSeenTime
-                        hasSlaveToBackendFrame = true;
+                // 提取分包信息
+                uint8_t fragmentsSequence = slaveRecvData[frameStart + 3];
+                uint8_t moreFragmentsFlag = slaveRecvData[frameStart + 4];
 
-                        // 提取分包信息
-                        uint8_t fragmentsSequence = recvData[frameStart + 3];
-                        uint8_t moreFragmentsFlag = recvData[frameStart + 4];
+                elog_v(TAG,
+                       "Found SLAVE_TO_BACKEND frame, fragment_seq=%d, more_fragments=%d, forwarding raw data",
+                       fragmentsSequence, moreFragmentsFlag);
 
-                        elog_v(TAG,
-                               "Found SLAVE_TO_BACKEND frame, fragment_seq=%d, more_fragments=%d, forwarding raw data",
-                               fragmentsSequence, moreFragmentsFlag);
+                // 提取帧长度
+                if (frameStart + 7 <= slaveRecvData.size())
+                {
+                    uint16_t frameLength = slaveRecvData[frameStart + 5] | (slaveRecvData[frameStart + 6] << 8);
+                    size_t frameEnd = frameStart + 7 + frameLength;
 
-                        // 提取帧长度
-                        if (frameStart + 7 <= recvData.size())
+                    // 检查帧是否完整
+                    if (frameEnd <= slaveRecvData.size())
+                    {
+                        // 只有第一个分片（fragmentsSequence == 0）包含messageId + slaveId + deviceStatus
+                        // 后续分片的payload只是消息内容的一部分，不包含这些信息
+                        if (fragmentsSequence == 0)
                         {
-                            uint16_t frameLength = recvData[frameStart + 5] | (recvData[frameStart + 6] << 8);
-                            size_t frameEnd = frameStart + 7 + frameLength;
+                            // 提取payload（跳过帧头7字节）
+                            std::vector<uint8_t> payload(slaveRecvData.begin() + frameStart + 7,
+                                                         slaveRecvData.begin() + frameEnd);
 
-                            // 检查帧是否完整
-                            if (frameEnd <= recvData.size())
+                            // 检查payload大小，至少需要7字节（messageId + slaveId + deviceStatus）
+                            if (payload.size() < 7)
+                            {
+                                elog_rl_w(TAG,
+                                          "SLAVE_TO_BACKEND payload too small: %d bytes (expected at least 7), "
+                                          "frameLength=%d",
+                                          payload.size(), frameLength);
+                            }
+                            else
                             {
-                                // 只有第一个分片（fragmentsSequence == 0）包含messageId + slaveId + deviceStatus
-                                // 后续分片的payload只是消息内容的一部分，不包含这些信息
-                                if (fragmentsSequence == 0)
+                                // 如果还有后续分片（more_fragments=1），说明数据不完整，只能提取基本信息
+                                // 只有当more_fragments=0时，才尝试完整解析
+                                if (moreFragmentsFlag == 0)
                                 {
-                                    // 提取payload（跳过帧头7字节）
-                                    std::vector<uint8_t> payload(recvData.begin() + frameStart + 7,
-                                                                 recvData.begin() + frameEnd);
-
-                                    // 检查payload大小，至少需要7字节（messageId + slaveId + deviceStatus）
-                                    if (payload.size() < 7)
+                                    // 完整帧，可以完整解析
+                                    uint8_t messageId = payload[0];
+                                    elog_v(TAG,
+                                           "Attempting to parse complete SLAVE_TO_BACKEND packet: "
+                                           "payload_size=%d, "
+                                           "messageId=0x%02X",
+                                           payload.size(), messageId);
+
+                                    // 解析payload提取从机ID
+                                    uint32_t slaveId = 0;
+                                    WhtsProtocol::DeviceStatus deviceStatus;
+                                    std::unique_ptr<WhtsProtocol::Message> message;
+
+                                    if (processor.parseSlave2BackendPacket(payload, slaveId,
+                                                                                  deviceStatus, message))
                                     {
-                                        elog_w(TAG,
-                                               "SLAVE_TO_BACKEND payload too small: %d bytes (expected at least 7), "
-                                               "frameLength=%d",
-                                               payload.size(), frameLength);
+                                        // 通过检测数据更新设备在线状态
+                                        // 设备是否在线只通过是否有检测数据上传来判断，并且收到检测数据后更新最后一次通信时间
+                                        getDeviceManager().updateDeviceOnlineStatusFromDetectionData(
+                                            slaveId);
+                                        elog_v(TAG,
+                                               "Updated online status for slave 0x%08X from SLAVE_TO_BACKEND "
+                                               "detection "
+                                               "data",
+                                               slaveId);
                                     }
                                     else
                                     {
-                                        // 如果还有后续分片（more_fragments=1），说明数据不完整，只能提取基本信息
-                                        // 只有当more_fragments=0时，才尝试完整解析
-                                        if (moreFragmentsFlag == 0)
-                                        {
-                                            // 完整帧，可以完整解析
-                                            uint8_t messageId = payload[0];
-                                            elog_v(TAG,
-                                                   "Attempting to parse complete SLAVE_TO_BACKEND packet: "
-                                                   "payload_size=%d, "
-                                                   "messageId=0x%02X",
-                                                   payload.size(), messageId);
-
-                                            // 解析payload提取从机ID
-                                            uint32_t slaveId = 0;
-                                            WhtsProtocol::DeviceStatus deviceStatus;
-                                            std::unique_ptr<WhtsProtocol::Message> message;
-
-                                            if (parent.processor.parseSlave2BackendPacket(payload, slaveId,
-                                                                                          deviceStatus, message))
-                                            {
-                                                // 通过检测数据更新设备在线状态
-                                                // 设备是否在线只通过是否有检测数据上传来判断，并且收到检测数据后更新最后一次通信时间
-                                                parent.getDeviceManager().updateDeviceOnlineStatusFromDetectionData(
-                                                    slaveId);
-                                                elog_v(TAG,
-                                                       "Updated online status for slave 0x%08X from SLAVE_TO_BACKEND "
-                                                       "detection "
-                                                       "data",
-                                                       slaveId);
-                                            }
-                                            else
-                                            {
-                                                // 详细诊断解析失败的原因
-                                                uint8_t msgId = payload[0];
-                                                elog_w(
-                                                    TAG,
-                                                    "Failed to parse SLAVE_TO_BACKEND packet: payload_size=%d, "
-                                                    "messageId=0x%02X (may be unsupported message type or deserialize "
-                                                    "failed)",
-                                                    payload.size(), msgId);
-                                            }
-                                        }
-                                        else
-                                        {
-                                            // 分包情况：只提取基本信息（前7字节），不进行完整解析
-                                            // 因为数据不完整，完整解析会在所有分片重组后由ProtocolProcessor处理
-                                            uint32_t slaveId = WhtsProtocol::ByteUtils::readUint32LE(
-                                                payload, 1); // 跳过messageId，读取slaveId
-                                            elog_v(TAG,
-                                                   "Extracted slave ID 0x%08X from first fragment (more fragments "
-                                                   "pending, skipping full parse)",
-                                                   slaveId);
-                                            // 更新设备在线状态
-                                            parent.getDeviceManager().updateDeviceOnlineStatusFromDetectionData(
-                                                slaveId);
-                                        }
+                                        // 详细诊断解析失败的原因
+                                        uint8_t msgId = payload[0];
+                                        elog_rl_w(
+                                            TAG,
+                                            "Failed to parse SLAVE_TO_BACKEND packet: payload_size=%d, "
+                                            "messageId=0x%02X (may be unsupported message type or deserialize "
+                                            "failed)",
+                                            payload.size(), msgId);
                                     }
                                 }
                                 else
                                 {
-                                    // 后续分片不包含slaveId信息，跳过解析
-                                    // elog_d(TAG, "Skipping slave ID extraction for fragment %d (not the first
-                                    // fragment)",
-                                    //        fragmentsSequence);
+                                    // 分包情况：只提取基本信息（前7字节），不进行完整解析
+                                    // 因为数据不完整，完整解析会在所有分片重组后由ProtocolProcessor处理
+                                    uint32_t slaveId = WhtsProtocol::ByteUtils::readUint32LE(
+                                        payload, 1); // 跳过messageId，读取slaveId
+                                    elog_v(TAG,
+                                           "Extracted slave ID 0x%08X from first fragment (more fragments "
+                                           "pending, skipping full parse)",
+                                           slaveId);
+                                    // 更新设备在线状态
+                                    getDeviceManager().updateDeviceOnlineStatusFromDetectionData(
+                                        slaveId);
                                 }
                             }
                         }
-
-                        // 直接透传原始接收数据给后端
-                        if (parent.sendToBackend(recvData))
-                        {
-                            elog_v(TAG,
-                                   "Successfully forwarded raw SLAVE_TO_BACKEND "
-                                   "data to backend (%d bytes)",
-                                   recvData.size());
-                        }
                         else
                         {
-                            elog_e(TAG, "Failed to forward raw SLAVE_TO_BACKEND "
-                                        "data to backend");
+                            // 后续分片不包含slaveId信息，跳过解析
+                            // elog_d(TAG, "Skipping slave ID extraction for fragment %d (not the first
+                            // fragment)",
+                            //        fragmentsSequence);
                         }
-                        break; // 找到SLAVE_TO_BACKEND帧后直接透传，不再处理其他帧
                     }
-
-                    // 移动到下一个位置继续查找
-                    pos = frameStart + 1;
                 }
 
-                // 如果不是SLAVE_TO_BACKEND帧，则按原来的逻辑处理
-                if (!hasSlaveToBackendFrame)
+                // 直接透传原始接收缓冲块给后端，不再拷贝
+                if (sendToBackend(buf))
                 {
-                    // process recvData
-                    parent.processor.processReceivedData(recvData);
-
-                    // process complete frame
-                    Frame receivedFrame;
-                    while (parent.processor.getNextCompleteFrame(receivedFrame))
-                    {
-                        parent.processFrame(receivedFrame);
-                    }
+                    elog_v(TAG,
+                           "Successfully forwarded raw SLAVE_TO_BACKEND "
+                           "data to backend (%d bytes)",
+                           slaveRecvData.size());
                 }
+                else
+                {
+                    elog_rl_e(TAG, "Failed to forward raw SLAVE_TO_BACKEND "
+                                   "data to backend");
+                }
+                break; // 找到SLAVE_TO_BACKEND帧后直接透传，不再处理其他帧
+            }
 
-                recvData.clear();
+            // 移动到下一个位置继续查找
+            pos = frameStart + 1;
+        }
+
+        // 如果不是SLAVE_TO_BACKEND帧，则按原来的逻辑处理
+        if (!hasSlaveToBackendFrame)
+        {
+            // process slaveRecvData
+            processor.processReceivedData(slaveRecvData);
+
+            // process complete frame
+            Frame receivedFrame;
+            while (processor.getNextCompleteFrame(receivedFrame))
+            {
+                processFrame(receivedFrame);
             }
         }
+
+        slaveRecvData.clear();
+    }
+}
+
+void MasterServer::SlaveDataProcT::task()
+{
+    elog_i(TAG, "SlaveDataProcT started");
+    uwb_rx_msg_t msg;
+    for (;;)
+    {
+        if (UWB_ReceiveData(&msg, 0) == 0)
+        {
+#if PKT_CAPTURE
+            PktCapture_Record(PKT_CAPTURE_SRC_UWB, msg.buf->data, msg.buf->len);
+#endif
+            parent.processSlaveData(msg.buf);
+            PktBuf_Release(msg.buf);
+        }
         TaskBase::delay(1);
     }
 }
@@ -1270,41 +1331,54 @@ MasterServer::BackDataProcT::BackDataProcT(MasterServer &parent)
 {
 }
 
+// 处理一个后端数据报，只分发Backend2Master帧
+void MasterServer::processBackendData(const uint8_t *data, uint16_t len)
+{
+    static constexpr const char TAG[] = "BackDataProcT";
+
+    // copy data to backendRecvData
+    backendRecvData.assign(data, data + len);
+
+    if (!backendRecvData.empty())
+    {
+        elog_v(TAG, "Backend recvData size: %d", backendRecvData.size());
+        {
+            CYCLE_PROF_SCOPE(CYCLE_PROF_BACKEND_FRAMES);
+            processor.processReceivedData(backendRecvData);
+        }
+        Frame receivedFrame;
+        while (processor.getNextCompleteFrame(receivedFrame))
+        {
+            // 只处理来自后端的消息，不处理转发的从机数据
+            if (receivedFrame.packetId == static_cast<uint8_t>(PacketId::BACKEND_TO_MASTER))
+            {
+                processFrame(receivedFrame);
+            }
+            else
+            {
+                elog_rl_w(TAG,
+                          "Ignoring non-backend frame (PacketId: 0x%02X) to "
+                          "prevent loopback",
+                          static_cast<int>(receivedFrame.packetId));
+            }
+        }
+        backendRecvData.clear();
+    }
+}
+
 void MasterServer::BackDataProcT::task()
 {
     elog_i(TAG, "BackDataProcT started");
-    udp_rx_msg_t msg;
     for (;;)
     {
-        if (UDP_ReceiveData(&msg, 0) == 0)
+        // 阻塞等待后端数据，数据报到达后立即处理
+        if (UDP_ReceiveData(&rxMsg, osWaitForever) == 0)
         {
-            // copy msg.data to recvData
-            recvData.assign(msg.data, msg.data + msg.data_len);
-
-            if (!recvData.empty())
-            {
-                elog_v(TAG, "Backend recvData size: %d", recvData.size());
-                parent.processor.processReceivedData(recvData);
-                Frame receivedFrame;
-                while (parent.processor.getNextCompleteFrame(receivedFrame))
-                {
-                    // 只处理来自后端的消息，不处理转发的从机数据
-                    if (receivedFrame.packetId == static_cast<uint8_t>(PacketId::BACKEND_TO_MASTER))
-                    {
-                        parent.processFrame(receivedFrame);
-                    }
-                    else
-                    {
-                        elog_w(TAG,
-                               "Ignoring non-backend frame (PacketId: 0x%02X) to "
-                               "prevent loopback",
-                               static_cast<int>(receivedFrame.packetId));
-                    }
-                }
-                recvData.clear();
-            }
+#if PKT_CAPTURE
+            PktCapture_Record(PKT_CAPTURE_SRC_UDP, rxMsg.data, rxMsg.len);
+#endif
+            parent.processBackendData(rxMsg.data, rxMsg.len);
         }
-        TaskBase::delay(1);
     }
 }
 
@@ -1324,6 +1398,9 @@ void MasterServer::MainTask::task()
     uint32_t lastStackInfoPrint = 0;
     const uint32_t stackInfoPrintInterval = 5000; // 5秒输出一次堆栈信息
 
+    // 系统监控按固定周期采样，打印与后端SYS_STATS_REQ_MSG查询只读取最新快照
+    uint32_t lastSysMonSample = 0;
+
     for (;;)
     {
         uint32_t currentTime = getCurrentTimestampMs();
@@ -1333,6 +1410,9 @@ void MasterServer::MainTask::task()
         parent.processPingSessions();
         parent.processPendingBackendResponses();
         parent.processTimeSync();
+#if PKT_CAPTURE
+        PktCapture_Poll();
+#endif
 
         // 定期检查设备在线状态（只在检测运行时执行）
         if (currentTime - lastDeviceCleanup >= deviceCleanupInterval)
@@ -1345,6 +1425,12 @@ void MasterServer::MainTask::task()
             lastDeviceCleanup = currentTime;
         }
 
+        if (currentTime - lastSysMonSample >= SYS_MON_SAMPLE_MS)
+        {
+            SysMon_Sample();
+            lastSysMonSample = currentTime;
+        }
+
         // 系统堆栈信息打印功能
         if (currentTime - lastStackInfoPrint >= stackInfoPrintInterval)
         {
@@ -1378,6 +1464,28 @@ void MasterServer::printSystemStackInfo() const
     elog_i(TAG, "Free Heap: %lu bytes", (unsigned long)freeHeapSize);
     elog_i(TAG, "Min Ever Free: %lu bytes", (unsigned long)minEverFreeHeapSize);
     elog_i(TAG, "Usage: %lu%%", (unsigned long)usagePercent);
+
+    // 小对象分配池使用情况
+    for (uint32_t i = 0; i < BlockPool_GetClassCount(); i++)
+    {
+        block_pool_stats_t stats;
+        if (BlockPool_GetStats(i, &stats) == 0)
+        {
+            elog_i(TAG, "Pool %4u: %u/%u in use, peak %u, allocs %lu, fallbacks %lu", stats.block_size,
+                   stats.in_use, stats.block_count, stats.peak, (unsigned long)stats.allocs,
+                   (unsigned long)stats.fallbacks);
+        }
+    }
+    elog_i(TAG, "Pool oversize: %lu", (unsigned long)BlockPool_GetOversizeCount());
+
+    // 各任务CPU占用、栈剩余与切换频率，只输出MainTask最近一次采样的快照
+    SysMon_Report();
+#if HEAP_PROFILE
+    HeapProf_Report();
+#endif
+#if CYCLE_PROFILE
+    CycleProf_Report();
+#endif
     elog_i(TAG, "=============================");
 }
 
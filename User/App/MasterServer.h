@@ -8,7 +8,11 @@
 #include "MutexCPP.h"
 #include "S2M_MessageHandlers.h"
 #include "TaskCPP.h"
+#include "ccm_ram.h"
 #include "master_app.h"
+#include "pkt_buf.h"
+#include "rtos_static.h"
+#include "udp_task.h"
 
 class MasterServer
 {
@@ -33,6 +37,9 @@ class MasterServer
     uint32_t lastSyncTime;
     bool initialTimeSyncCompleted; // 标记是否已完成初始时间同步
 
+    // 缓存的后端地址
+    udp_endpoint_t backendEndpoint;
+
     /**
      * 运行主循环
      */
@@ -52,6 +59,13 @@ class MasterServer
      */
     bool sendToBackend(std::vector<uint8_t> &frame);
 
+    /**
+     * 发送缓冲块到后端（零拷贝透传）
+     * @param buf 要发送的缓冲块，调用者保留自己的引用
+     * @return 是否发送成功
+     */
+    bool sendToBackend(pkt_buf_t *buf);
+
     /**
      * 后端到主机数据处理任务类 (处理从后端接收到的数据)
      */
@@ -62,7 +76,6 @@ class MasterServer
 
       private:
         MasterServer &parent;
-        std::vector<uint8_t> recvData;
         void task() override;
         static constexpr const char TAG[] = "SlaveDataProcT";
     };
@@ -77,7 +90,7 @@ class MasterServer
 
       private:
         MasterServer &parent;
-        std::vector<uint8_t> recvData;
+        udp_rx_msg_t rxMsg; // 按最大数据报分配，不放在任务栈上
         void task() override;
         static constexpr const char TAG[] = "BackDataProcT";
     };
@@ -93,14 +106,28 @@ class MasterServer
         static constexpr const char TAG[] = "MainTask";
     };
 
-    // 数据传输任务实例
-    std::unique_ptr<SlaveDataProcT> slaveDataProcessingTask;
-    std::unique_ptr<BackDataProcT> backendDataProcessingTask;
-    std::unique_ptr<MainTask> mainTask;
+    // 数据传输任务实例，静态分配模式下任务对象（含控制块与栈）随MasterServer一起静态存放；
+    // SlaveDataProcT与MainTask的控制块和任务栈只由CPU访问，不论分配模式都放在CCM RAM中
+#if RTOS_STATIC_ALLOC
+    template <typename T> using TaskHolder = StaticObject<T>;
+#else
+    template <typename T> using TaskHolder = std::unique_ptr<T>;
+#endif
+    static CcmSlot<SlaveDataProcT> slaveTaskSlot; // CCM存储槽（MasterServer.cpp），第二个实例的任务从堆分配
+    static CcmSlot<MainTask> mainTaskSlot;
+    CcmObject<SlaveDataProcT> slaveDataProcessingTask{slaveTaskSlot};
+    TaskHolder<BackDataProcT> backendDataProcessingTask;
+    CcmObject<MainTask> mainTask{mainTaskSlot};
 
     // Utility methods
     uint32_t getCurrentTimestamp();
 
+    // 接收路径入口，由SlaveDataProcT/BackDataProcT调用，回放工具（Host/Replay）直接调用以复现现场数据
+    void processSlaveData(pkt_buf_t *buf);
+    void processBackendData(const uint8_t *data, uint16_t len);
+    std::vector<uint8_t> slaveRecvData;   // processSlaveData的解析缓冲
+    std::vector<uint8_t> backendRecvData; // processBackendData的解析缓冲
+
     // Core processing methods
     void processBackend2MasterMessage(const Message &message);
     void processSlave2MasterMessage(uint32_t slaveId, const Message &message);
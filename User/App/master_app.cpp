@@ -1,7 +1,11 @@
 // #include "slave_app.h"
 #include "MasterServer.h"
 #include "cmsis_os2.h"
+#include "cycle_prof.hpp"
 #include "elog.h"
+#include "log_udp.h"
+#include "pkt_buf.h"
+#include "pkt_capture.h"
 #include "udp_task.h"
 #include "uwb_task.h"
 #include <memory>
@@ -11,13 +15,30 @@ using namespace WhtsProtocol;
 extern void UWB_Task_Init(void);
 extern void UDP_Task_Init(void);
 
+#if RTOS_STATIC_ALLOC
+// 静态分配模式下MasterServer及其任务栈不占用FreeRTOS堆
+RTOS_STATIC static StaticObject<MasterServer> masterServerObj;
+#endif
+
 extern "C" int main_app(void)
 {
+#if CYCLE_PROFILE
+    CycleProf_Init(); // 使能DWT周期计数
+#endif
+    PktBuf_Init();   // 初始化UWB/UDP共享报文缓冲池
     UWB_Task_Init(); // 初始化UWB通信任务
     UDP_Task_Init(); // 初始化UDP通信任务
+    LogUdp_Init(LOG_COLLECTOR_IP, LOG_COLLECTOR_PORT); // 日志同时发送到网络采集端
+#if PKT_CAPTURE
+    PktCapture_Init(PKT_CAPTURE_IP, PKT_CAPTURE_PORT); // 接收数据抓包发送到采集端
+#endif
 
+#if RTOS_STATIC_ALLOC
+    MasterServer *masterServer = masterServerObj.create();
+#else
     // 在堆上创建MasterServer对象，避免栈溢出
     auto masterServer = std::make_unique<MasterServer>();
+#endif
     masterServer->run();
 
     for (;;)
@@ -47,8 +47,16 @@
 #define DATA_SEND_TX_QUEUE_TIMEOUT_MS 100     // 数据发送队列超时 (ms)
 
 // ========== NETWORK CONFIGURATIONS ==========
-#define DEFAULT_BACKEND_IP "192.168.0.3" // 默认后端IP地址
+#ifndef DEFAULT_BACKEND_IP
+#define DEFAULT_BACKEND_IP "192.168.0.3" // 默认后端IP地址，本机构建在Host/CMakeLists.txt中覆盖
+#endif
+#ifndef DEFAULT_BACKEND_PORT
 #define DEFAULT_BACKEND_PORT 8080        // 默认后端端口
+#endif
+#define LOG_COLLECTOR_IP DEFAULT_BACKEND_IP // 日志采集端IP地址
+#define LOG_COLLECTOR_PORT 8090             // 日志采集端端口
+#define PKT_CAPTURE_IP DEFAULT_BACKEND_IP   // 抓包采集端IP地址（CMake PKT_CAPTURE）
+#define PKT_CAPTURE_PORT 8091               // 抓包采集端端口
 
 // ========== PROTOCOL CONFIGURATIONS ==========
 #define BROADCAST_SLAVE_ID 0xFFFFFFFF // 广播从机ID
@@ -4,6 +4,7 @@
 #include <cstdarg>
 #include <cstdint>
 #include <cstdio>
+#include <deque>
 #include <functional>
 #include <queue>
 #include <vector>
@@ -12,6 +13,8 @@
 #include "elog.h"
 
 #define UWB_GENERAL_TIMEOUT_MS 2000
+#define UWB_CMD_QUEUE_MAX 16    // 异步命令队列深度
+#define UWB_TX_DONE_TIMEOUT_MS 50    // 命令已应答、未收到TX完成通知时的兜底超时（应答前由命令超时覆盖）
 
 template <class Interface>
 class CX310 {
@@ -42,6 +45,28 @@ class CX310 {
     std::function<bool()> cmd_packer = nullptr;
     bool uwb_tx_done;
 
+   public:
+    // 命令完成回调，参数为命令是否执行成功
+    using CmdCallback = std::function<void(bool)>;
+
+   private:
+    enum CmdSta : uint8_t { CMD_IDLE = 0, CMD_SEND, CMD_WAIT_RSP };
+
+    struct UciCommand {
+        std::function<bool()> packer;
+        std::function<bool(const UciCtrlPacket&)> checker;
+        CmdCallback on_done;
+    };
+
+    std::deque<UciCommand> cmd_queue;    // 待执行命令，队首为当前命令
+    CmdSta cmd_sta = CMD_IDLE;
+    bool cmd_pack_all = false;    // 当前命令的最后一个分段是否已发出
+    uint32_t cmd_start_tick = 0;
+
+    uint8_t tx_inflight = 0;    // 已入队但未收到TX完成通知的数据帧数
+    uint8_t tx_acked = 0;       // 其中命令已应答、正在等待TX完成通知的帧数
+    uint32_t tx_tick = 0;       // 最近一次应答或TX完成通知的时间
+
     /**
      * @brief 初始化
      */
@@ -634,12 +659,17 @@ class CX310 {
             return true;
         }
 
-        cmd_packer = [this, &data]() { return uci_cmd.cx_app_data_tx(data); };
-        check_rsp = [this](const UciCtrlPacket& rsp) {
-            return uci_cmd.check_cx_app_data_tx_rsp(rsp);
-        };
-
-        if (__send_packet()) {
+        bool done = false;
+        bool ret = false;
+        if (data_transmit_async(data, [&done, &ret](bool ok) {
+                ret = ok;
+                done = true;
+            })) {
+            while (!done) {
+                update();
+            }
+        }
+        if (ret) {
             // elog_i(TAG, "data transmit");
             return true;
         }
@@ -790,9 +820,92 @@ class CX310 {
      */
     void update() {
         __listening_ntf();
+        __cmd_state_machine();
         __uwbs_state_machine();
     }
 
+    /**
+     * @brief 异步数据透传，命令入队后立即返回
+     * @param data 发送数据，由命令持有
+     * @param on_done 收到RSP或超时后的回调，可为空
+     * @return 入队成功返回true，未就绪或队列满返回false
+     */
+    bool data_transmit_async(std::vector<uint8_t> data,
+                             CmdCallback on_done = nullptr) {
+        if (!__check_rdy()) {
+            return false;
+        }
+        if (data.size() == 0 || data.size() > CX_APP_DATA_TX_MAX_PAYLOAD_LEN) {
+            return false;
+        }
+        if (!__submit(
+                [this, data = std::move(data)]() {
+                    return uci_cmd.cx_app_data_tx(data);
+                },
+                [this](const UciCtrlPacket& rsp) {
+                    return uci_cmd.check_cx_app_data_tx_rsp(rsp);
+                },
+                [this, on_done = std::move(on_done)](bool ok) {
+                    if (ok) {
+                        // 应答后芯片开始发送，从此刻起等待TX完成通知
+                        if (tx_acked++ == 0) {
+                            tx_tick = interface.get_system_1ms_ticks();
+                        }
+                    } else if (tx_inflight > 0) {
+                        // 命令失败不会再有TX完成通知
+                        tx_inflight--;
+                    }
+                    if (on_done) {
+                        on_done(ok);
+                    }
+                })) {
+            return false;
+        }
+        tx_inflight++;
+        return true;
+    }
+
+    /**
+     * @brief 射频发送是否空闲，用于按TX完成通知调度下一帧
+     */
+    bool is_tx_idle() const { return tx_inflight == 0; }
+
+    /**
+     * @brief 异步设置信道
+     */
+    bool set_channel_async(uint8_t channel, CmdCallback on_done = nullptr) {
+        if (!__check_rdy()) {
+            return false;
+        }
+        return __submit(
+            [this, channel]() mutable {
+                return uci_cmd.core_set_config(PARAM_CHANNEL_NUMBER_ID, 1,
+                                               &channel);
+            },
+            [this](const UciCtrlPacket& rsp) {
+                return uci_cmd.check_core_set_config_rsp(rsp);
+            },
+            std::move(on_done));
+    }
+
+    /**
+     * @brief 异步进入接收模式
+     */
+    bool set_recv_mode_async(CmdCallback on_done = nullptr) {
+        if (!__check_rdy()) {
+            return false;
+        }
+        return __submit([this]() { return uci_cmd.cx_app_data_rx(); },
+                        [this](const UciCtrlPacket& rsp) {
+                            return uci_cmd.check_cx_app_data_rx_rsp(rsp);
+                        },
+                        std::move(on_done));
+    }
+
+    // 队列中(含正在执行)的命令数
+    size_t cmd_pending() const { return cmd_queue.size(); }
+    size_t cmd_free() const { return UWB_CMD_QUEUE_MAX - cmd_queue.size(); }
+
     bool is_init_success() const { return init_success; }
 
     bool init() {
@@ -845,32 +958,6 @@ class CX310 {
 
     void __load_recv_data() { interface.get_recv_data(rx_data_queue); }
 
-    bool __rsp_process(uint32_t timeout_ms) {
-        uint32_t start_tick = interface.get_system_1ms_ticks();
-        while (interface.get_system_1ms_ticks() - start_tick < timeout_ms) {
-            __load_recv_data();
-            while (rx_data_queue.empty() == false) {
-                _data = rx_data_queue.front();
-                // elog_w(TAG, "recv data: %02x", _data);
-                rx_data_queue.pop();
-
-                if (recv_packet.flow_parse(_data)) {
-                    //  Log.r(recv_packet.packet.data(),
-                    //   recv_packet.packet.size());
-                    if (recv_packet.mt == MT_RSP) {
-                        // 接收到响应
-                        return true;
-                    } else if (recv_packet.mt == MT_NTF) {
-                        // 接收到通知
-                        __notify_process();
-                    }
-                }
-            }
-        }
-        elog_e(TAG, "wait rsp timeout");
-        return false;
-    }
-
     void __listening_ntf() {
         __load_recv_data();
         while (rx_data_queue.empty() == false) {
@@ -879,8 +966,8 @@ class CX310 {
             if (recv_packet.flow_parse(_data)) {
                 if (recv_packet.mt == MT_NTF) {
                     __notify_process();
-                } else {
-                    elog_e(TAG, "unexpected rsp packet");
+                } else if (recv_packet.mt == MT_RSP) {
+                    __rsp_process();
                 }
             }
         }
@@ -914,6 +1001,7 @@ class CX310 {
                         STATUS_OK) {
                         elog_e(TAG, "parse data tx ntf fail");
                     }
+                    __tx_done();
                     break;
                 }
                 case CX_APP_DATA_RX_NTF: {
@@ -991,41 +1079,114 @@ class CX310 {
         // __delay_ms(500);
         // reset(3000);
     }
-    bool __send_packet() {
-        if ((cmd_packer == nullptr) || (check_rsp == nullptr)) {
+    bool __submit(std::function<bool()> packer,
+                  std::function<bool(const UciCtrlPacket&)> checker,
+                  CmdCallback on_done) {
+        if (cmd_queue.size() >= UWB_CMD_QUEUE_MAX) {
+            elog_w(TAG, "cmd queue full");
             return false;
         }
-        bool send_flag = true;
-        bool pack_all_payload = false;
-        bool ret = false;
-        uint8_t index = 0;
-        while (1) {
-            if (send_flag) {
-                send_flag = false;
-                pack_all_payload = cmd_packer();
+        cmd_queue.push_back(
+            {std::move(packer), std::move(checker), std::move(on_done)});
+        return true;
+    }
+
+    void __cmd_complete(bool ok) {
+        CmdCallback on_done = std::move(cmd_queue.front().on_done);
+        cmd_queue.pop_front();
+        uci_cmd.reset_packer();
+        cmd_sta = CMD_IDLE;
+        if (on_done) {
+            on_done(ok);
+        }
+    }
+
+    void __cmd_state_machine() {
+        switch (cmd_sta) {
+            case CMD_IDLE: {
+                if (cmd_queue.empty()) {
+                    break;
+                }
+                cmd_sta = CMD_SEND;
+            }
+                // fall through
+            case CMD_SEND: {
+                cmd_pack_all = cmd_queue.front().packer();
                 interface.send(uci_cmd.packet);
-                // Log.r(uci_cmd.packet.data(), uci_cmd.packet.size());
+                cmd_start_tick = interface.get_system_1ms_ticks();
+                cmd_sta = CMD_WAIT_RSP;
+                break;
             }
-            if (__rsp_process(UWB_GENERAL_TIMEOUT_MS)) {
-                if (check_rsp(recv_packet)) {
-                    send_flag = true;
-                    if (pack_all_payload) {
-                        ret = true;
-                        break;
-                    }
-                } else {
-                    elog_e(TAG, "rsp check fail");
-                    ret = false;
-                    break;
+            case CMD_WAIT_RSP: {
+                if (interface.get_system_1ms_ticks() - cmd_start_tick >=
+                    UWB_GENERAL_TIMEOUT_MS) {
+                    elog_e(TAG, "wait rsp timeout");
+                    __cmd_complete(false);
                 }
-            } else {
-                ret = false;
                 break;
             }
         }
-        uci_cmd.reset_packer();
+        // 只对已应答的帧计时，排队和等待应答的帧由命令超时处理
+        if (tx_acked > 0 &&
+            interface.get_system_1ms_ticks() - tx_tick >=
+                UWB_TX_DONE_TIMEOUT_MS) {
+            elog_w(TAG, "tx done ntf lost, %u frames", tx_acked);
+            tx_inflight = tx_inflight > tx_acked ? tx_inflight - tx_acked : 0;
+            tx_acked = 0;
+        }
+    }
+
+    void __tx_done() {
+        if (tx_inflight > 0) {
+            tx_inflight--;
+        }
+        if (tx_acked > 0) {
+            tx_acked--;
+            tx_tick = interface.get_system_1ms_ticks();
+        }
+    }
+
+    void __rsp_process() {
+        if (cmd_sta != CMD_WAIT_RSP) {
+            elog_e(TAG, "unexpected rsp packet");
+            return;
+        }
+        if (!cmd_queue.front().checker(recv_packet)) {
+            elog_e(TAG, "rsp check fail");
+            __cmd_complete(false);
+            return;
+        }
+        if (cmd_pack_all) {
+            __cmd_complete(true);
+        } else {
+            // 分段命令，下一次update发送后续分段
+            cmd_sta = CMD_SEND;
+        }
+    }
+
+    /**
+     * @brief 阻塞发送，命令排在已入队的异步命令之后，等待期间照常处理通知
+     */
+    bool __send_packet() {
+        if ((cmd_packer == nullptr) || (check_rsp == nullptr)) {
+            return false;
+        }
+        bool done = false;
+        bool ret = false;
+        if (!__submit(std::move(cmd_packer), std::move(check_rsp),
+                      [&done, &ret](bool ok) {
+                          ret = ok;
+                          done = true;
+                      })) {
+            cmd_packer = nullptr;
+            check_rsp = nullptr;
+            return false;
+        }
         cmd_packer = nullptr;
         check_rsp = nullptr;
+        while (!done) {
+            update();
+        }
         return ret;
     }
 };
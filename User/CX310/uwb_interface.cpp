@@ -1,5 +1,7 @@
 #include "uwb_interface.hpp"
 
+#include "hptimer/cycle_prof.hpp"
+
 // 全局指针定义
 CX310_SlaveSpiAdapter *g_uwb_adapter = nullptr;
 
@@ -65,6 +67,7 @@ void CX310_SlaveSpiAdapter::turn_of_reset_signal()
 
 bool CX310_SlaveSpiAdapter::send(std::vector<uint8_t> &tx_data)
 {
+    CYCLE_PROF_SCOPE(CYCLE_PROF_UWB_SPI_TX); // 含等待RDY
     taskENTER_CRITICAL();
 
     nss_low();
@@ -86,6 +89,7 @@ bool CX310_SlaveSpiAdapter::get_recv_data(std::queue<uint8_t> &rx_data)
 {
     if (rx_semaphore.take(0))
     {
+        CYCLE_PROF_SCOPE(CYCLE_PROF_UWB_SPI_RX);
 
         nss_low();
         HAL_StatusTypeDef status;
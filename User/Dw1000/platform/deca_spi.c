@@ -15,9 +15,22 @@
 #include "deca_device_api.h"
 #include "port.h"
 #include "stm32f4xx_hal_def.h"
+#include "cmsis_os2.h"
+#include <string.h>
 
 extern  SPI_HandleTypeDef hspi4;    /*clocked from 72MHz*/
 
+/* Bodies at least this long (dwt_readrxdata/dwt_writetxdata sized) go through
+ * DMA, shorter register accesses stay on the polled path */
+#define DECA_SPI_DMA_MIN_LEN        (32)
+#define DECA_SPI_DMA_TIMEOUT_MS     (10)
+
+/* SPI4: RX on DMA2 Stream0 / TX on DMA2 Stream1, channel 4 */
+static DMA_HandleTypeDef hdma_spi4_rx;
+static DMA_HandleTypeDef hdma_spi4_tx;
+static osSemaphoreId_t spi_dma_done = NULL;
+static volatile int spi_dma_error = 0;
+
 /****************************************************************************//**
  *
  *                              DW1000 SPI section
@@ -31,6 +44,55 @@ extern  SPI_HandleTypeDef hspi4;    /*clocked from 72MHz*/
  */
 int openspi(/*SPI_TypeDef* SPIx*/)
 {
+    if (spi_dma_done != NULL)
+    {
+        return 0;
+    }
+
+    __HAL_RCC_DMA2_CLK_ENABLE();
+
+    hdma_spi4_rx.Instance = DMA2_Stream0;
+    hdma_spi4_rx.Init.Channel = DMA_CHANNEL_4;
+    hdma_spi4_rx.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    hdma_spi4_rx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_spi4_rx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_spi4_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_spi4_rx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_spi4_rx.Init.Mode = DMA_NORMAL;
+    hdma_spi4_rx.Init.Priority = DMA_PRIORITY_HIGH;
+    hdma_spi4_rx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&hdma_spi4_rx) != HAL_OK)
+    {
+        return -1;
+    }
+    __HAL_LINKDMA(&hspi4, hdmarx, hdma_spi4_rx);
+
+    hdma_spi4_tx.Instance = DMA2_Stream1;
+    hdma_spi4_tx.Init.Channel = DMA_CHANNEL_4;
+    hdma_spi4_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma_spi4_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_spi4_tx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_spi4_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_spi4_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_spi4_tx.Init.Mode = DMA_NORMAL;
+    hdma_spi4_tx.Init.Priority = DMA_PRIORITY_HIGH;
+    hdma_spi4_tx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&hdma_spi4_tx) != HAL_OK)
+    {
+        return -1;
+    }
+    __HAL_LINKDMA(&hspi4, hdmatx, hdma_spi4_tx);
+
+    HAL_NVIC_SetPriority(DMA2_Stream0_IRQn, 6, 0);
+    HAL_NVIC_EnableIRQ(DMA2_Stream0_IRQn);
+    HAL_NVIC_SetPriority(DMA2_Stream1_IRQn, 6, 0);
+    HAL_NVIC_EnableIRQ(DMA2_Stream1_IRQn);
+
+    spi_dma_done = osSemaphoreNew(1, 0, NULL);
+    if (spi_dma_done == NULL)
+    {
+        return -1;
+    }
     return 0;
 } // end openspi()
 
@@ -45,6 +107,48 @@ int closespi(void)
     return 0;
 } // end closespi()
 
+/*! ------------------------------------------------------------------------------------------------------------------
+ * Function: spi_dma_usable()
+ *
+ * DMA is used only for long bodies, from task context, once openspi() has run.
+ * Everything else (ISR context, pre-scheduler init, register accesses) is polled.
+ */
+static int spi_dma_usable(uint32_t length)
+{
+    return (length >= DECA_SPI_DMA_MIN_LEN) && (spi_dma_done != NULL) && (__get_IPSR() == 0U) &&
+           (osKernelGetState() == osKernelRunning);
+}
+
+/*! ------------------------------------------------------------------------------------------------------------------
+ * Function: spi_dma_prepare()
+ *
+ * Called before each DMA transfer. A completion callback that fires after spi_dma_wait() timed out and aborted
+ * the transfer still gives the semaphore, drain it so the next wait doesn't return before its own transfer ends
+ */
+static void spi_dma_prepare(void)
+{
+    while (osSemaphoreAcquire(spi_dma_done, 0) == osOK)
+    {
+    }
+    spi_dma_error = 0;
+}
+
+/*! ------------------------------------------------------------------------------------------------------------------
+ * Function: spi_dma_wait()
+ *
+ * Block the calling task until the DMA transfer completes
+ * returns 0 for success, or -1 for error/timeout
+ */
+static int spi_dma_wait(void)
+{
+    if (osSemaphoreAcquire(spi_dma_done, DECA_SPI_DMA_TIMEOUT_MS) != osOK)
+    {
+        HAL_SPI_Abort(&hspi4);
+        return -1;
+    }
+    return spi_dma_error ? -1 : 0;
+}
+
 /*! ------------------------------------------------------------------------------------------------------------------
  * Function: writetospi()
  *
@@ -58,6 +162,7 @@ int writetospi(uint16_t headerLength,
                uint32_t bodyLength,
                const    uint8_t *bodyBuffer)
 {
+    int ret = 0;
     decaIrqStatus_t  stat ;
     stat = decamutexon() ;
 
@@ -66,13 +171,30 @@ int writetospi(uint16_t headerLength,
     HAL_GPIO_WritePin(DW_NSS_GPIO_Port, DW_NSS_Pin, GPIO_PIN_RESET); /**< Put chip select line low */
 
     HAL_SPI_Transmit(&hspi4, (uint8_t *)&headerBuffer[0], headerLength, HAL_MAX_DELAY);    /* Send header in polling mode */
-    HAL_SPI_Transmit(&hspi4, (uint8_t *)&bodyBuffer[0], bodyLength, HAL_MAX_DELAY);        /* Send data in polling mode */
+
+    if (spi_dma_usable(bodyLength))
+    {
+        /* Send data by DMA, the task sleeps until completion */
+        spi_dma_prepare();
+        if (HAL_SPI_Transmit_DMA(&hspi4, (uint8_t *)&bodyBuffer[0], bodyLength) == HAL_OK)
+        {
+            ret = spi_dma_wait();
+        }
+        else
+        {
+            ret = -1;
+        }
+    }
+    else
+    {
+        HAL_SPI_Transmit(&hspi4, (uint8_t *)&bodyBuffer[0], bodyLength, HAL_MAX_DELAY);    /* Send data in polling mode */
+    }
 
     HAL_GPIO_WritePin(DW_NSS_GPIO_Port, DW_NSS_Pin, GPIO_PIN_SET); /**< Put chip select line high */
 
     decamutexoff(stat);
 
-    return 0;
+    return ret;
 } // end writetospi()
 
 
@@ -90,7 +212,7 @@ int readfromspi(uint16_t headerLength,
                 uint32_t readlength,
                 uint8_t *readBuffer)
 {
-    int i;
+    int ret = 0;
     decaIrqStatus_t  stat ;
     stat = decamutexon() ;
 
@@ -99,40 +221,98 @@ int readfromspi(uint16_t headerLength,
 
     HAL_GPIO_WritePin(DW_NSS_GPIO_Port, DW_NSS_Pin, GPIO_PIN_RESET); /**< Put chip select line low */
 
-    /* Send header */
-    for(i=0; i<headerLength; i++)
-    {
-        HAL_SPI_Transmit(&hspi4, &headerBuffer[i], 1, HAL_MAX_DELAY); //No timeout
-    }
+    /* Send header in one burst */
+    HAL_SPI_Transmit(&hspi4, (uint8_t *)&headerBuffer[0], headerLength, HAL_MAX_DELAY); //No timeout
 
-    /* for the data buffer use LL functions directly as the HAL SPI read function
-     * has issue reading single bytes */
-    while(readlength-- > 0)
+    if (spi_dma_usable(readlength))
     {
-        /* Wait until TXE flag is set to send data */
-        while(__HAL_SPI_GET_FLAG(&hspi4, SPI_FLAG_TXE) == RESET)
+        /* Full duplex receive clocks the buffer itself out on MOSI,
+         * zero it so the DW1000 sees 0 as with the polled path */
+        memset(readBuffer, 0, readlength);
+        spi_dma_prepare();
+        if (HAL_SPI_Receive_DMA(&hspi4, readBuffer, readlength) == HAL_OK)
         {
+            ret = spi_dma_wait();
         }
-
-        hspi4.Instance->DR = 0; /* set output to 0 (MOSI), this is necessary for
-        e.g. when waking up DW1000 from DEEPSLEEP via dwt_spicswakeup() function.
-        */
-
-        /* Wait until RXNE flag is set to read data */
-        while(__HAL_SPI_GET_FLAG(&hspi4, SPI_FLAG_RXNE) == RESET)
+        else
         {
+            ret = -1;
         }
+    }
+    else
+    {
+        /* for the data buffer use LL functions directly as the HAL SPI read function
+         * has issue reading single bytes */
+
+        while(readlength-- > 0)
+        {
+            /* Wait until TXE flag is set to send data */
+            while(__HAL_SPI_GET_FLAG(&hspi4, SPI_FLAG_TXE) == RESET)
+            {
+            }
 
-        (*readBuffer++) = hspi4.Instance->DR;  //copy data read form (MISO)
+            hspi4.Instance->DR = 0; /* set output to 0 (MOSI), this is necessary for
+            e.g. when waking up DW1000 from DEEPSLEEP via dwt_spicswakeup() function.
+            */
+
+            /* Wait until RXNE flag is set to read data */
+            while(__HAL_SPI_GET_FLAG(&hspi4, SPI_FLAG_RXNE) == RESET)
+            {
+            }
+
+            (*readBuffer++) = hspi4.Instance->DR;  //copy data read form (MISO)
+        }
     }
 
     HAL_GPIO_WritePin(DW_NSS_GPIO_Port, DW_NSS_Pin, GPIO_PIN_SET); /**< Put chip select line high */
 
     decamutexoff(stat);
 
-    return 0;
+    return ret;
 } // end readfromspi()
 
+/*! ------------------------------------------------------------------------------------------------------------------
+ * SPI4 DMA completion, wakes the task blocked in spi_dma_wait()
+ */
+static void spi_dma_complete(SPI_HandleTypeDef *hspi, int error)
+{
+    if ((hspi == &hspi4) && (spi_dma_done != NULL))
+    {
+        spi_dma_error = error;
+        osSemaphoreRelease(spi_dma_done);
+    }
+}
+
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    spi_dma_complete(hspi, 0);
+}
+
+void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    spi_dma_complete(hspi, 0);
+}
+
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    spi_dma_complete(hspi, 0);
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+    spi_dma_complete(hspi, 1);
+}
+
+void DMA2_Stream0_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(&hdma_spi4_rx);
+}
+
+void DMA2_Stream1_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(&hdma_spi4_tx);
+}
+
 /****************************************************************************//**
  *
  *                              END OF DW1000 SPI section
@@ -32,6 +32,9 @@ extern SPI_HandleTypeDef hspi4;
  *******************************************************************************/
 static volatile uint32_t signalResetDone;
 
+/* DW1000 IRQ handler, installed by port_set_deca_isr() */
+port_deca_isr_t port_deca_isr = NULL;
+
 /****************************************************************************//**
  *
  *                              Time section
@@ -201,6 +204,23 @@ void setup_DW1000RSTnIRQ(int enable)
 }
 
 
+/* @fn      setup_DW1000IRQ
+ * @brief   setup the DW_IRQn pin as rising edge EXTI input
+ *          the pin shares EXTI9_5 with the CX310 lines, so the CubeMX
+ *          GPIO setup (UWB_RDY input) is overridden here for DW1000 builds
+ * */
+void setup_DW1000IRQ(void)
+{
+    GPIO_InitTypeDef GPIO_InitStruct;
+
+    GPIO_InitStruct.Pin = DW_IRQn_Pin;
+    GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING;
+    GPIO_InitStruct.Pull = GPIO_PULLDOWN;
+    HAL_GPIO_Init(DW_IRQn_GPIO_Port, &GPIO_InitStruct);
+
+    HAL_NVIC_SetPriority(DECAIRQ_EXTI_IRQn, 6, 0);
+}
+
 /* @fn      port_is_boot1_low
  * @brief   check the BOOT1 pin status.
  * @return  1 if ON and 0 for OFF
@@ -328,10 +348,12 @@ void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
  * @brief   main call-back for processing of DW1000 IRQ
  *          it re-enters the IRQ routing and processes all events.
  *          After processing of all events, DW1000 will clear the IRQ line.
+ *          A handler that defers the work to a task masks the EXT IRQ,
+ *          which also ends this loop; the task re-enables it when done.
  * */
 __INLINE void process_deca_irq(void)
 {
-    while(port_CheckEXT_IRQ() != 0)
+    while((port_CheckEXT_IRQ() != 0) && (port_GetEXT_IRQStatus() != 0) && (port_deca_isr != NULL))
     {
 
         port_deca_isr();
@@ -339,6 +361,16 @@ __INLINE void process_deca_irq(void)
     } //while DW1000 IRQ line active
 }
 
+/* @fn      port_set_deca_isr
+ * @brief   install the DW1000 IRQ handler, the EXT IRQ is masked meanwhile
+ * */
+void port_set_deca_isr(port_deca_isr_t deca_isr)
+{
+    decaIrqStatus_t s = decamutexon();
+    port_deca_isr = deca_isr;
+    decamutexoff(s);
+}
+
 
 /* @fn      port_DisableEXT_IRQ
  * @brief   wrapper to disable DW_IRQ pin IRQ
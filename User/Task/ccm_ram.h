@@ -0,0 +1,88 @@
+#ifndef CCM_RAM_H
+#define CCM_RAM_H
+
+// CCM RAM（0x10000000，64KB）：CPU零等待访问，不经过总线矩阵，不与以太网/SPI DMA争用主SRAM。
+// DMA无法访问CCM，报文缓冲池、日志DMA缓冲区、lwIP内存不能放在这里；
+// .ccmbss段不从Flash加载，由启动代码清零，只能放零初始化的数据。
+// 各模块占用由构建后的Scripts/ccm_report.py根据map文件输出，超出64KB时链接失败（链接脚本ASSERT）
+#define CCM_RAM __attribute__((section(".ccmbss")))
+
+#ifdef __cplusplus
+
+#include <new>
+#include <stdint.h>
+#include <utility>
+
+// CcmObject的存储槽，由使用者以CCM_RAM定义（GCC忽略模板静态成员上的section属性，不能在模板内定义）
+template <typename T> struct CcmSlot
+{
+    alignas(T) uint8_t storage[sizeof(T)];
+    bool used;
+};
+
+// CCM RAM中的对象持有者，用作类成员：对象放在构造时给定的CCM存储槽中，
+// 槽已被其他持有者占用时从堆分配。析构时销毁对象并释放槽或堆内存
+template <typename T> class CcmObject
+{
+  public:
+    explicit CcmObject(CcmSlot<T> &slot) : slot(slot)
+    {
+    }
+    CcmObject(const CcmObject &) = delete;
+    CcmObject &operator=(const CcmObject &) = delete;
+
+    ~CcmObject()
+    {
+        if (object == nullptr)
+        {
+            return;
+        }
+        if (inCcm())
+        {
+            object->~T();
+            slot.used = false;
+        }
+        else
+        {
+            delete object;
+        }
+    }
+
+    template <typename... Args> T *create(Args &&...args)
+    {
+        if (!slot.used)
+        {
+            slot.used = true;
+            object = new (slot.storage) T(std::forward<Args>(args)...);
+        }
+        else
+        {
+            object = new T(std::forward<Args>(args)...);
+        }
+        return object;
+    }
+
+    T *operator->() const
+    {
+        return object;
+    }
+
+    explicit operator bool() const
+    {
+        return object != nullptr;
+    }
+
+    // 对象是否位于CCM存储槽中
+    bool inCcm() const
+    {
+        return object != nullptr && object == reinterpret_cast<const T *>(slot.storage);
+    }
+
+  private:
+    CcmSlot<T> &slot;
+    T *object = nullptr;
+};
+
+#endif // __cplusplus
+
+#endif // CCM_RAM_H
@@ -0,0 +1,112 @@
+#include "log_udp.h"
+
+#include <string.h>
+
+#include "cmsis_os.h"
+#include "udp_batch.h"
+
+// elog_port.c中的批量输出端注册接口
+extern void elog_port_set_net_sink(void (*sink)(const char *log, size_t size));
+
+static const udp_batch_cfg_t batchCfg = {
+    .magic = {'E', 'L'},
+    .flush_ms = LOG_UDP_FLUSH_MS,
+    .pool_reserve = LOG_UDP_POOL_RESERVE,
+    .max_tx_queue = LOG_UDP_MAX_TX_QUEUE,
+};
+static udp_batch_t batch; // 只由elog输出任务访问，dropped单位为字节
+static uint32_t tokens = LOG_UDP_BURST_BYTES;
+static uint32_t tokenTick;
+static log_udp_stats_t stats;
+
+// 令牌桶限速
+static int log_udp_take_tokens(uint32_t len)
+{
+    uint32_t now = osKernelGetTickCount();
+    uint32_t refill = (uint32_t)(((uint64_t)(now - tokenTick) * LOG_UDP_RATE_BYTES) / 1000);
+    if (refill > 0)
+    {
+        tokens = (tokens + refill > LOG_UDP_BURST_BYTES) ? LOG_UDP_BURST_BYTES : tokens + refill;
+        tokenTick = now;
+    }
+
+    if (tokens < len)
+    {
+        return -1;
+    }
+    tokens -= len;
+    return 0;
+}
+
+// 发送当前数据报
+static void log_udp_flush(void)
+{
+    uint32_t payload;
+    pkt_buf_t *buf = UdpBatch_Detach(&batch, &payload);
+    if (buf == NULL)
+    {
+        return;
+    }
+
+    if (log_udp_take_tokens(buf->len) != 0)
+    {
+        stats.rate_drop += payload;
+        UdpBatch_Discard(&batch, buf, payload);
+    }
+    else if (UdpBatch_Send(&batch, buf, payload) == 0)
+    {
+        stats.sent_datagrams++;
+        stats.sent_bytes += payload;
+    }
+    else
+    {
+        stats.busy_drop += payload;
+    }
+}
+
+// elog输出任务调用：log为一批完整的日志行或二进制帧，size为0时只检查超时刷新
+static void log_udp_sink(const char *log, size_t size)
+{
+    if (UdpBatch_Due(&batch) || UdpBatch_Space(&batch) < size)
+    {
+        log_udp_flush();
+    }
+
+    if (size == 0)
+    {
+        return;
+    }
+
+    uint16_t space;
+    uint8_t *dst = (size <= UDP_BATCH_PAYLOAD_MAX) ? UdpBatch_Reserve(&batch, &space) : NULL;
+    if (dst == NULL)
+    {
+        stats.busy_drop += size;
+        UdpBatch_Drop(&batch, size);
+        return;
+    }
+
+    memcpy(dst, log, size);
+    UdpBatch_Commit(&batch, (uint16_t)size, size);
+}
+
+int LogUdp_Init(const char *collector_ip, uint16_t port)
+{
+    int ret = UdpBatch_Init(&batch, &batchCfg, collector_ip, port);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    tokenTick = osKernelGetTickCount();
+    elog_port_set_net_sink(log_udp_sink);
+    return 0;
+}
+
+void LogUdp_GetStats(log_udp_stats_t *out)
+{
+    if (out != NULL)
+    {
+        *out = stats;
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef LOG_UDP_H
+#define LOG_UDP_H
+
+#include <stdint.h>
+
+#include "udp_batch.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define LOG_UDP_FLUSH_MS 500          // 不满一个数据报时的最长等待时间
+#define LOG_UDP_RATE_BYTES 8192       // 限速：每秒最多发送的日志字节数
+#define LOG_UDP_BURST_BYTES 4096      // 限速：令牌桶容量
+#define LOG_UDP_POOL_RESERVE 16       // 缓冲池空闲块少于该值时不发送日志，优先保证数据转发
+#define LOG_UDP_MAX_TX_QUEUE 8        // UDP发送队列中消息数超过该值时不发送日志
+
+    // 日志数据报：udp_batch_hdr_t（magic为'E','L'，dropped为丢弃的日志字节数）后接文本行或elog_bin帧，
+    // 采集端可用Scripts/elog_bin_decode.py --udp解析
+    typedef udp_batch_hdr_t log_udp_hdr_t;
+
+    // 统计计数
+    typedef struct
+    {
+        uint32_t sent_datagrams; // 已发送数据报数
+        uint32_t sent_bytes;     // 已发送日志字节数
+        uint32_t rate_drop;      // 限速丢弃的字节数
+        uint32_t busy_drop;      // 缓冲池或发送队列繁忙丢弃的字节数
+    } log_udp_stats_t;
+
+    // 初始化网络日志输出，注册为elog输出任务的批量输出端
+    // 参数：collector_ip - 日志采集端IP, port - 采集端端口
+    // 返回：0 - 成功, -2 - 无效IP地址
+    int LogUdp_Init(const char *collector_ip, uint16_t port);
+
+    // 获取统计计数
+    void LogUdp_GetStats(log_udp_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LOG_UDP_H */
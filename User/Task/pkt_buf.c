@@ -0,0 +1,71 @@
+#include "pkt_buf.h"
+
+#include "cmsis_os2.h"
+#include "elog.h"
+#include "rtos_static.h"
+
+static osMemoryPoolId_t pktBufPool;
+static volatile uint32_t alloc_fail_count = 0;
+
+RTOS_STATIC_MEMPOOL(pktBufPool, PKT_BUF_POOL_SIZE, sizeof(pkt_buf_t))
+
+int PktBuf_Init(void)
+{
+    if (pktBufPool != NULL)
+    {
+        return 0;
+    }
+
+    pktBufPool = osMemoryPoolNew(PKT_BUF_POOL_SIZE, sizeof(pkt_buf_t), RTOS_STATIC_ATTR(pktBufPool));
+    if (pktBufPool == NULL)
+    {
+        elog_e("pkt_buf", "Failed to create packet buffer pool");
+        return -1;
+    }
+    return 0;
+}
+
+pkt_buf_t *PktBuf_Alloc(uint32_t timeout_ms)
+{
+    pkt_buf_t *buf = (pkt_buf_t *)osMemoryPoolAlloc(pktBufPool, timeout_ms);
+    if (buf == NULL)
+    {
+        __atomic_fetch_add(&alloc_fail_count, 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+    buf->ref = 1;
+    buf->len = 0;
+    return buf;
+}
+
+pkt_buf_t *PktBuf_Ref(pkt_buf_t *buf)
+{
+    if (buf != NULL)
+    {
+        __atomic_fetch_add(&buf->ref, 1, __ATOMIC_RELAXED);
+    }
+    return buf;
+}
+
+void PktBuf_Release(pkt_buf_t *buf)
+{
+    if (buf == NULL)
+    {
+        return;
+    }
+    // 最后一个引用负责归还，osMemoryPoolFree可在中断中调用
+    if (__atomic_sub_fetch(&buf->ref, 1, __ATOMIC_ACQ_REL) == 0)
+    {
+        osMemoryPoolFree(pktBufPool, buf);
+    }
+}
+
+uint32_t PktBuf_GetFreeCount(void)
+{
+    return PKT_BUF_POOL_SIZE - osMemoryPoolGetCount(pktBufPool);
+}
+
+uint32_t PktBuf_GetAllocFailCount(void)
+{
+    return alloc_fail_count;
+}
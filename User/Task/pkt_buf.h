@@ -0,0 +1,45 @@
+#ifndef PKT_BUF_H
+#define PKT_BUF_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define PKT_BUF_DATA_SIZE 1016 // 单个缓冲块数据区大小，与FRAME_LEN_MAX/UDP_BUFFER_SIZE一致
+#define PKT_BUF_POOL_SIZE 64   // 缓冲块数量，UWB与UDP队列共享
+
+    // 报文缓冲块，队列中只传递指向缓冲块的句柄
+    typedef struct
+    {
+        volatile uint16_t ref; // 引用计数，为0时归还缓冲池
+        uint16_t len;          // 有效数据长度
+        uint8_t data[PKT_BUF_DATA_SIZE];
+    } pkt_buf_t;
+
+    // 初始化缓冲池，需在创建UWB/UDP任务之前调用
+    // 返回：0 - 成功, -1 - 创建失败
+    int PktBuf_Init(void);
+
+    // 申请缓冲块，引用计数初始为1
+    // 参数：timeout_ms - 超时时间（毫秒），中断中调用时必须为0
+    // 返回：缓冲块句柄，缓冲池耗尽时返回NULL
+    pkt_buf_t *PktBuf_Alloc(uint32_t timeout_ms);
+
+    // 增加引用计数，返回同一句柄
+    pkt_buf_t *PktBuf_Ref(pkt_buf_t *buf);
+
+    // 释放一次引用，计数归零时归还缓冲池
+    void PktBuf_Release(pkt_buf_t *buf);
+
+    // API函数：获取缓冲池状态
+    uint32_t PktBuf_GetFreeCount(void);  // 当前空闲缓冲块数量
+    uint32_t PktBuf_GetAllocFailCount(void); // 申请失败次数
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PKT_BUF_H */
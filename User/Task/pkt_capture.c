@@ -0,0 +1,163 @@
+#include "pkt_capture.h"
+
+#include <string.h>
+
+#include "cmsis_os.h"
+#include "hptimer.hpp"
+#include "rtos_static.h"
+
+// 一条记录最长为UDP_RX_MAX_DATAGRAM，最多跨3个数据报
+#define PKT_CAPTURE_READY_MAX 3
+
+static const udp_batch_cfg_t batchCfg = {
+    .magic = {'P', 'C'},
+    .flush_ms = PKT_CAPTURE_FLUSH_MS,
+    .pool_reserve = PKT_CAPTURE_POOL_RESERVE,
+    .max_tx_queue = PKT_CAPTURE_MAX_TX_QUEUE,
+};
+static udp_batch_t batch;
+static osMutexId_t captureLock; // SlaveDataProcT、BackDataProcT与MainTask并发记录/刷新
+static osMutexId_t sendLock;    // 按取出顺序发送，拆分记录的各段序号连续
+static volatile int enabled;
+static pkt_capture_stats_t stats;
+
+RTOS_STATIC_MUTEX(captureLock)
+RTOS_STATIC_MUTEX(sendLock)
+
+// 发送已取出的数据报。调用者持有captureLock，先取得sendLock再释放captureLock，
+// 发送时不阻塞其他任务的记录，且各数据报按取出顺序发出
+static void pkt_capture_send(pkt_buf_t *const *bufs, const uint32_t *records, int count)
+{
+    osMutexAcquire(sendLock, osWaitForever);
+    osMutexRelease(captureLock);
+
+    for (int i = 0; i < count; i++)
+    {
+        uint16_t len = bufs[i]->len;
+        int ret = UdpBatch_Send(&batch, bufs[i], records[i]);
+
+        osMutexAcquire(captureLock, osWaitForever);
+        if (ret == 0)
+        {
+            stats.sent_datagrams++;
+            stats.sent_bytes += len;
+        }
+        else
+        {
+            stats.busy_drop += records[i];
+        }
+        osMutexRelease(captureLock);
+    }
+    osMutexRelease(sendLock);
+}
+
+int PktCapture_Init(const char *collector_ip, uint16_t port)
+{
+    int ret = UdpBatch_Init(&batch, &batchCfg, collector_ip, port);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    captureLock = osMutexNew(RTOS_STATIC_ATTR(captureLock));
+    sendLock = osMutexNew(RTOS_STATIC_ATTR(sendLock));
+    if (captureLock == NULL || sendLock == NULL)
+    {
+        return -1;
+    }
+
+    enabled = 1;
+    return 0;
+}
+
+void PktCapture_SetEnabled(int enable)
+{
+    enabled = enable;
+}
+
+void PktCapture_Record(uint8_t source, const uint8_t *data, uint16_t len)
+{
+    pkt_buf_t *ready[PKT_CAPTURE_READY_MAX];
+    uint32_t readyRecords[PKT_CAPTURE_READY_MAX];
+    int readyCount = 0;
+    uint32_t ts = (uint32_t)hal_hptimer_get_us64();
+
+    if (!enabled || captureLock == NULL || data == NULL || len == 0)
+    {
+        return;
+    }
+
+    osMutexAcquire(captureLock, osWaitForever);
+    stats.records++;
+
+    // 超过一个数据报剩余空间的记录拆成多段，除最后一段外都带PKT_CAPTURE_FLAG_MORE
+    uint16_t offset = 0;
+    while (offset < len)
+    {
+        if (UdpBatch_Space(&batch) <= sizeof(pkt_capture_rec_t))
+        {
+            ready[readyCount] = UdpBatch_Detach(&batch, &readyRecords[readyCount]);
+            readyCount++;
+        }
+
+        uint16_t space;
+        uint8_t *dst = (readyCount < PKT_CAPTURE_READY_MAX) ? UdpBatch_Reserve(&batch, &space) : NULL;
+        if (dst == NULL)
+        {
+            // 记录的剩余部分丢失，回放时不完整的记录被丢弃
+            stats.busy_drop++;
+            UdpBatch_Drop(&batch, 1);
+            break;
+        }
+
+        space -= sizeof(pkt_capture_rec_t);
+        uint16_t chunk = (uint16_t)(len - offset) < space ? (uint16_t)(len - offset) : space;
+
+        pkt_capture_rec_t *rec = (pkt_capture_rec_t *)dst;
+        rec->ts_us = ts;
+        rec->len = chunk;
+        rec->source = source;
+        rec->flags = (offset + chunk < len) ? PKT_CAPTURE_FLAG_MORE : 0;
+        memcpy(dst + sizeof(pkt_capture_rec_t), data + offset, chunk);
+        offset += chunk;
+        UdpBatch_Commit(&batch, (uint16_t)(sizeof(pkt_capture_rec_t) + chunk), offset == len ? 1 : 0);
+    }
+
+    if (readyCount > 0)
+    {
+        pkt_capture_send(ready, readyRecords, readyCount);
+    }
+    else
+    {
+        osMutexRelease(captureLock);
+    }
+}
+
+void PktCapture_Poll(void)
+{
+    pkt_buf_t *buf;
+    uint32_t records;
+
+    if (captureLock == NULL)
+    {
+        return;
+    }
+
+    osMutexAcquire(captureLock, osWaitForever);
+    if (UdpBatch_Due(&batch) && (buf = UdpBatch_Detach(&batch, &records)) != NULL)
+    {
+        pkt_capture_send(&buf, &records, 1);
+    }
+    else
+    {
+        osMutexRelease(captureLock);
+    }
+}
+
+void PktCapture_GetStats(pkt_capture_stats_t *out)
+{
+    if (out != NULL)
+    {
+        *out = stats;
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef PKT_CAPTURE_H
+#define PKT_CAPTURE_H
+
+#include <stdint.h>
+
+#include "udp_batch.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define PKT_CAPTURE_FLUSH_MS 100     // 不满一个数据报时的最长等待时间
+#define PKT_CAPTURE_POOL_RESERVE 16  // 缓冲池空闲块少于该值时丢弃记录，优先保证数据转发
+#define PKT_CAPTURE_MAX_TX_QUEUE 8   // UDP发送队列中消息数超过该值时丢弃记录
+
+// 记录来源
+#define PKT_CAPTURE_SRC_UWB 0x00 // UWB接收缓冲（SlaveDataProcT出队）
+#define PKT_CAPTURE_SRC_UDP 0x01 // 后端UDP数据报（BackDataProcT出队）
+#define PKT_CAPTURE_SRC_GAP 0xFF // 只出现在抓包文件中：采集端记录的丢失，数据为u32丢失记录数
+
+// 记录标志
+#define PKT_CAPTURE_FLAG_MORE 0x01 // 记录跨数据报拆分，下一条同来源记录是其后续部分
+
+    // 抓包数据报：udp_batch_hdr_t（magic为'P','C'，dropped为丢弃的记录数）后接若干条记录，
+    // 采集端可用Scripts/pkt_capture.py写入文件
+    typedef udp_batch_hdr_t pkt_capture_hdr_t;
+
+    // 记录头部，后接len字节原始数据
+    typedef struct __attribute__((packed))
+    {
+        uint32_t ts_us;    // hal_hptimer微秒时间戳低32位，小端
+        uint16_t len;      // 数据长度，小端
+        uint8_t source;    // PKT_CAPTURE_SRC_xxx
+        uint8_t flags;     // PKT_CAPTURE_FLAG_xxx
+    } pkt_capture_rec_t;
+
+    // 统计计数
+    typedef struct
+    {
+        uint32_t records;        // 已记录条数
+        uint32_t sent_datagrams; // 已发送数据报数
+        uint32_t sent_bytes;     // 已发送字节数（含头部）
+        uint32_t busy_drop;      // 缓冲池或发送队列繁忙丢弃的记录数
+    } pkt_capture_stats_t;
+
+    // 初始化抓包输出，初始化后即开始记录
+    // 参数：collector_ip - 采集端IP, port - 采集端端口
+    // 返回：0 - 成功, -1 - 创建互斥量失败, -2 - 无效IP地址
+    int PktCapture_Init(const char *collector_ip, uint16_t port);
+
+    // 暂停/恢复记录，暂停时已缓存的记录在下一次PktCapture_Poll时发出
+    void PktCapture_SetEnabled(int enabled);
+
+    // 记录一个接收缓冲，可在任意任务中调用，不可在中断中调用
+    void PktCapture_Record(uint8_t source, const uint8_t *data, uint16_t len);
+
+    // 周期调用（MainTask），发送超过PKT_CAPTURE_FLUSH_MS的未满数据报
+    void PktCapture_Poll(void);
+
+    // 获取统计计数
+    void PktCapture_GetStats(pkt_capture_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PKT_CAPTURE_H */
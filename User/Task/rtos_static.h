@@ -0,0 +1,96 @@
+#ifndef RTOS_STATIC_H
+#define RTOS_STATIC_H
+
+// 静态分配模式（CMake RTOS_STATIC_ALLOC）：任务控制块、栈、队列存储区与信号量全部静态分配，
+// 集中放在链接脚本的.bss.rtos_static段（_srtos_static ~ _ertos_static），占用在map文件中可见；
+// 普通模式下宏展开为空，属性为NULL，对象仍从FreeRTOS堆申请
+
+#include <stdint.h>
+
+#include "cmsis_os2.h"
+
+#if RTOS_STATIC_ALLOC
+
+#include "FreeRTOS.h"
+#include "freertos_mpool.h"
+#include "message_buffer.h"
+
+#define RTOS_STATIC __attribute__((section(".bss.rtos_static"), aligned(8)))
+
+// 任务：定义控制块与栈，RTOS_STATIC_THREAD_ATTR放在osThreadAttr_t初始化的.name与.stack_size之间
+#define RTOS_STATIC_THREAD(id, stack_bytes)    \
+    RTOS_STATIC static StaticTask_t id##_cb;   \
+    RTOS_STATIC static uint64_t id##_stack[(stack_bytes) / sizeof(uint64_t)];
+#define RTOS_STATIC_THREAD_ATTR(id) .cb_mem = &id##_cb, .cb_size = sizeof(id##_cb), .stack_mem = id##_stack,
+
+// 消息队列
+#define RTOS_STATIC_QUEUE(id, count, msg_size)                                                              \
+    RTOS_STATIC static StaticQueue_t id##_cb;                                                               \
+    RTOS_STATIC static uint8_t id##_mem[(count) * (msg_size)];                                              \
+    static const osMessageQueueAttr_t id##_attr = {                                                         \
+        .name = #id, .cb_mem = &id##_cb, .cb_size = sizeof(id##_cb), .mq_mem = id##_mem, .mq_size = sizeof(id##_mem)};
+
+// 信号量与互斥量
+#define RTOS_STATIC_SEMAPHORE(id)              \
+    RTOS_STATIC static StaticSemaphore_t id##_cb; \
+    static const osSemaphoreAttr_t id##_attr = {.name = #id, .cb_mem = &id##_cb, .cb_size = sizeof(id##_cb)};
+#define RTOS_STATIC_MUTEX(id)                  \
+    RTOS_STATIC static StaticSemaphore_t id##_cb; \
+    static const osMutexAttr_t id##_attr = {.name = #id, .cb_mem = &id##_cb, .cb_size = sizeof(id##_cb)};
+
+// 内存池，块大小按CMSIS实现向上取整到4字节
+#define RTOS_STATIC_MEMPOOL(id, count, block_size)                                                          \
+    RTOS_STATIC static MemPool_t id##_cb;                                                                   \
+    RTOS_STATIC static uint8_t id##_mem[MEMPOOL_ARR_SIZE(count, block_size)];                               \
+    static const osMemoryPoolAttr_t id##_attr = {                                                           \
+        .name = #id, .cb_mem = &id##_cb, .cb_size = sizeof(id##_cb), .mp_mem = id##_mem, .mp_size = sizeof(id##_mem)};
+
+// 传给osXxxNew的属性
+#define RTOS_STATIC_ATTR(id) (&id##_attr)
+
+#else
+
+#define RTOS_STATIC
+#define RTOS_STATIC_THREAD(id, stack_bytes)
+#define RTOS_STATIC_THREAD_ATTR(id)
+#define RTOS_STATIC_QUEUE(id, count, msg_size)
+#define RTOS_STATIC_SEMAPHORE(id)
+#define RTOS_STATIC_MUTEX(id)
+#define RTOS_STATIC_MEMPOOL(id, count, block_size)
+#define RTOS_STATIC_ATTR(id) NULL
+
+#endif // RTOS_STATIC_ALLOC
+
+#ifdef __cplusplus
+
+#include <new>
+#include <utility>
+
+// 对象存储区，静态分配模式下代替std::unique_ptr持有长期存在的对象，放在.bss.rtos_static中时不占用堆
+template <typename T> class StaticObject
+{
+  public:
+    template <typename... Args> T *create(Args &&...args)
+    {
+        object = new (storage) T(std::forward<Args>(args)...);
+        return object;
+    }
+
+    T *operator->() const
+    {
+        return object;
+    }
+
+    explicit operator bool() const
+    {
+        return object != nullptr;
+    }
+
+  private:
+    alignas(T) uint8_t storage[sizeof(T)];
+    T *object = nullptr;
+};
+
+#endif // __cplusplus
+
+#endif // RTOS_STATIC_H
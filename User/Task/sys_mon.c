@@ -0,0 +1,138 @@
+#include "sys_mon.h"
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "elog.h"
+#include "task.h"
+
+// 与tasks.c中的默认值一致
+#ifndef configIDLE_TASK_NAME
+#define configIDLE_TASK_NAME "IDLE"
+#endif
+
+// 任务切入次数，由traceTASK_SWITCHED_IN在PendSV中累加
+volatile uint32_t sysMonSwitchCount[SYS_MON_SWITCH_SLOTS];
+
+// 上一次采样时各任务的累计值
+typedef struct
+{
+    UBaseType_t number;
+    uint32_t runtime;
+    uint32_t switches;
+} sys_mon_prev_t;
+
+static TaskStatus_t status[SYS_MON_MAX_TASKS];
+static sys_mon_prev_t prev[SYS_MON_MAX_TASKS];
+static uint32_t prevCount;
+static uint32_t prevTotal;
+static TickType_t prevTick;
+static sys_mon_snapshot_t snapshot;
+static volatile uint8_t snapshotValid;
+
+// 查找任务上一次采样的累计值，新任务返回NULL
+static const sys_mon_prev_t *sys_mon_find_prev(UBaseType_t number)
+{
+    for (uint32_t i = 0; i < prevCount; i++)
+    {
+        if (prev[i].number == number)
+        {
+            return &prev[i];
+        }
+    }
+    return NULL;
+}
+
+void SysMon_Sample(void)
+{
+    static sys_mon_snapshot_t next;
+    static sys_mon_prev_t cur[SYS_MON_MAX_TASKS];
+    uint32_t total;
+
+    UBaseType_t count = uxTaskGetSystemState(status, SYS_MON_MAX_TASKS, &total);
+    TickType_t tick = xTaskGetTickCount();
+
+    // TIM2为32位1MHz计数，采样间隔小于71分钟时差值正确
+    uint32_t elapsed = total - prevTotal;
+    if (elapsed == 0)
+    {
+        elapsed = 1;
+    }
+    uint32_t periodMs = (uint32_t)((tick - prevTick) * portTICK_PERIOD_MS);
+
+    uint32_t idlePermille = 0;
+    memset(&next, 0, sizeof(next));
+    next.period_ms = periodMs;
+    next.task_count = (uint8_t)count;
+    for (UBaseType_t i = 0; i < count; i++)
+    {
+        const TaskStatus_t *ts = &status[i];
+        const sys_mon_prev_t *p = sys_mon_find_prev(ts->xTaskNumber);
+        uint32_t switches = sysMonSwitchCount[ts->xTaskNumber & (SYS_MON_SWITCH_SLOTS - 1)];
+        uint32_t runtime = ts->ulRunTimeCounter - (p ? p->runtime : 0);
+        uint32_t switchDelta = switches - (p ? p->switches : 0);
+
+        sys_mon_task_t *t = &next.tasks[i];
+        strncpy(t->name, ts->pcTaskName, SYS_MON_NAME_LEN - 1);
+        t->priority = (uint8_t)ts->uxCurrentPriority;
+        t->cpu_permille = (uint16_t)(((uint64_t)runtime * 1000) / elapsed);
+        if (t->cpu_permille > 1000)
+        {
+            t->cpu_permille = 1000;
+        }
+        t->stack_free_min = (uint32_t)ts->usStackHighWaterMark * sizeof(StackType_t);
+        t->switches_per_sec = periodMs ? (uint32_t)(((uint64_t)switchDelta * 1000) / periodMs) : 0;
+
+        if (strcmp(ts->pcTaskName, configIDLE_TASK_NAME) == 0)
+        {
+            idlePermille = t->cpu_permille;
+        }
+
+        cur[i].number = ts->xTaskNumber;
+        cur[i].runtime = ts->ulRunTimeCounter;
+        cur[i].switches = switches;
+    }
+    next.cpu_load_permille = (uint16_t)(1000 - idlePermille);
+
+    memcpy(prev, cur, sizeof(cur[0]) * count);
+    prevCount = count;
+    prevTotal = total;
+    prevTick = tick;
+
+    // 其他任务可能正在读取快照
+    vTaskSuspendAll();
+    snapshot = next;
+    snapshotValid = 1;
+    (void)xTaskResumeAll();
+}
+
+int SysMon_GetSnapshot(sys_mon_snapshot_t *out)
+{
+    if (out == NULL || !snapshotValid)
+    {
+        return -1;
+    }
+    vTaskSuspendAll();
+    *out = snapshot;
+    (void)xTaskResumeAll();
+    return 0;
+}
+
+void SysMon_Report(void)
+{
+    static sys_mon_snapshot_t s;
+    if (SysMon_GetSnapshot(&s) != 0)
+    {
+        return;
+    }
+
+    elog_i("SysMon", "CPU load %u.%u%% over %lu ms", s.cpu_load_permille / 10, s.cpu_load_permille % 10,
+           (unsigned long)s.period_ms);
+    for (uint32_t i = 0; i < s.task_count; i++)
+    {
+        const sys_mon_task_t *t = &s.tasks[i];
+        elog_i("SysMon", "%-16s prio %2u cpu %3u.%u%% stack free %5lu B switches %lu/s", t->name, t->priority,
+               t->cpu_permille / 10, t->cpu_permille % 10, (unsigned long)t->stack_free_min,
+               (unsigned long)t->switches_per_sec);
+    }
+}
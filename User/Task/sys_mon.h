@@ -0,0 +1,48 @@
+#ifndef SYS_MON_H
+#define SYS_MON_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define SYS_MON_MAX_TASKS 24    // 最多统计的任务数量
+#define SYS_MON_NAME_LEN 16     // 与configMAX_TASK_NAME_LEN一致
+#define SYS_MON_SAMPLE_MS 1000  // MainTask调用SysMon_Sample的周期
+
+    // 单个任务在上一个采样周期内的统计
+    typedef struct
+    {
+        char name[SYS_MON_NAME_LEN];
+        uint8_t priority;
+        uint16_t cpu_permille;     // CPU占用，千分比
+        uint32_t stack_free_min;   // 栈历史最小剩余字节数
+        uint32_t switches_per_sec; // 每秒切入次数
+    } sys_mon_task_t;
+
+    // 采样快照
+    typedef struct
+    {
+        uint32_t period_ms;          // 采样周期
+        uint16_t cpu_load_permille;  // 除空闲任务外的总CPU占用，千分比
+        uint8_t task_count;
+        sys_mon_task_t tasks[SYS_MON_MAX_TASKS];
+    } sys_mon_snapshot_t;
+
+    // 采样一次，与上一次采样的差值生成新的快照，只能由一个任务周期调用
+    void SysMon_Sample(void);
+
+    // 获取最新快照，可在任意任务中调用
+    // 返回：0 - 成功, -1 - 尚未采样
+    int SysMon_GetSnapshot(sys_mon_snapshot_t *out);
+
+    // 通过elog输出最新快照
+    void SysMon_Report(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SYS_MON_H */
@@ -0,0 +1,116 @@
+#include "udp_batch.h"
+
+#include "cmsis_os.h"
+
+int UdpBatch_Init(udp_batch_t *b, const udp_batch_cfg_t *cfg, const char *collector_ip, uint16_t port)
+{
+    int ret = UDP_ResolveEndpoint(&b->collector, collector_ip, port);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    b->cfg = cfg;
+    b->cur = NULL;
+    b->curUnits = 0;
+    b->seq = 0;
+    b->dropPending = 0;
+    return 0;
+}
+
+// 开始新的数据报，数据转发繁忙时放弃
+static int udp_batch_begin(udp_batch_t *b)
+{
+    if (PktBuf_GetFreeCount() <= b->cfg->pool_reserve || UDP_GetTxQueueCount() >= b->cfg->max_tx_queue)
+    {
+        return -1;
+    }
+
+    b->cur = PktBuf_Alloc(0);
+    if (b->cur == NULL)
+    {
+        return -1;
+    }
+
+    udp_batch_hdr_t *hdr = (udp_batch_hdr_t *)b->cur->data;
+    hdr->magic[0] = b->cfg->magic[0];
+    hdr->magic[1] = b->cfg->magic[1];
+    hdr->version = 1;
+    hdr->reserved = 0;
+    b->cur->len = sizeof(udp_batch_hdr_t);
+    b->curUnits = 0;
+    b->curStartTick = osKernelGetTickCount();
+    return 0;
+}
+
+uint8_t *UdpBatch_Reserve(udp_batch_t *b, uint16_t *space)
+{
+    if (b->cur == NULL && udp_batch_begin(b) != 0)
+    {
+        return NULL;
+    }
+
+    *space = (uint16_t)(PKT_BUF_DATA_SIZE - b->cur->len);
+    return b->cur->data + b->cur->len;
+}
+
+void UdpBatch_Commit(udp_batch_t *b, uint16_t len, uint32_t units)
+{
+    b->cur->len += len;
+    b->curUnits += units;
+}
+
+uint16_t UdpBatch_Space(const udp_batch_t *b)
+{
+    return b->cur != NULL ? (uint16_t)(PKT_BUF_DATA_SIZE - b->cur->len) : (uint16_t)UDP_BATCH_PAYLOAD_MAX;
+}
+
+int UdpBatch_Due(const udp_batch_t *b)
+{
+    return b->cur != NULL && osKernelGetTickCount() - b->curStartTick >= b->cfg->flush_ms;
+}
+
+pkt_buf_t *UdpBatch_Detach(udp_batch_t *b, uint32_t *units)
+{
+    pkt_buf_t *buf = b->cur;
+    if (buf != NULL)
+    {
+        *units = b->curUnits;
+        b->cur = NULL;
+    }
+    return buf;
+}
+
+int UdpBatch_Send(udp_batch_t *b, pkt_buf_t *buf, uint32_t units)
+{
+    // dropPending可能同时被记录任务增加，只减去本数据报上报的部分
+    udp_batch_hdr_t *hdr = (udp_batch_hdr_t *)buf->data;
+    uint32_t dropped = __atomic_load_n(&b->dropPending, __ATOMIC_RELAXED);
+    hdr->seq = b->seq;
+    hdr->dropped = dropped;
+    int ret = UDP_SendBufTo(buf, &b->collector);
+    if (ret == 0)
+    {
+        // 发送失败不占用序号，其中的数量随下一个数据报的dropped上报
+        b->seq++;
+        __atomic_sub_fetch(&b->dropPending, dropped, __ATOMIC_RELAXED);
+    }
+    else
+    {
+        __atomic_add_fetch(&b->dropPending, units, __ATOMIC_RELAXED);
+    }
+
+    PktBuf_Release(buf);
+    return ret;
+}
+
+void UdpBatch_Discard(udp_batch_t *b, pkt_buf_t *buf, uint32_t units)
+{
+    UdpBatch_Drop(b, units);
+    PktBuf_Release(buf);
+}
+
+void UdpBatch_Drop(udp_batch_t *b, uint32_t units)
+{
+    __atomic_add_fetch(&b->dropPending, units, __ATOMIC_RELAXED);
+}
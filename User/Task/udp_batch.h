@@ -0,0 +1,85 @@
+#ifndef UDP_BATCH_H
+#define UDP_BATCH_H
+
+#include <stdint.h>
+
+#include "pkt_buf.h"
+#include "udp_task.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    // 批量数据报头部，后接各输出端自己的负载（log_udp.h的日志行、pkt_capture.h的抓包记录）
+    typedef struct __attribute__((packed))
+    {
+        uint8_t magic[2];  // 由输出端指定，如'E','L'或'P','C'
+        uint8_t version;   // 1
+        uint8_t reserved;
+        uint32_t seq;      // 数据报序号，发送成功才递增，缺口即网络丢包，小端
+        uint32_t dropped;  // 自上一个数据报以来丢弃的数量（单位由输出端定义），小端
+    } udp_batch_hdr_t;
+
+#define UDP_BATCH_PAYLOAD_MAX (PKT_BUF_DATA_SIZE - sizeof(udp_batch_hdr_t)) // 单个数据报最大负载
+
+    // 输出端参数
+    typedef struct
+    {
+        uint8_t magic[2];
+        uint16_t flush_ms;      // 不满一个数据报时的最长等待时间
+        uint16_t pool_reserve;  // 缓冲池空闲块少于该值时不开始新数据报，优先保证数据转发
+        uint16_t max_tx_queue;  // UDP发送队列中消息数超过该值时不开始新数据报
+    } udp_batch_cfg_t;
+
+    // 数据报拼装状态。Reserve/Commit/Detach由调用者串行调用（单任务或调用者的锁），
+    // UdpBatch_Send也由调用者串行调用，可在拼装锁外进行；UdpBatch_Drop可随时调用
+    typedef struct
+    {
+        const udp_batch_cfg_t *cfg;
+        udp_endpoint_t collector;
+        pkt_buf_t *cur;         // 正在拼装的数据报
+        uint32_t curStartTick;  // 当前数据报开始的时间
+        uint32_t curUnits;      // 当前数据报中的数量（丢弃时计入dropped）
+        uint32_t seq;
+        uint32_t dropPending;   // 尚未通过数据报头上报的丢弃数量
+    } udp_batch_t;
+
+    // 初始化，cfg需长期有效
+    // 返回：0 - 成功, -2 - 无效IP地址
+    int UdpBatch_Init(udp_batch_t *b, const udp_batch_cfg_t *cfg, const char *collector_ip, uint16_t port);
+
+    // 获取当前数据报的写入位置，没有数据报时开始一个新的
+    // 参数：space - 返回剩余空间
+    // 返回：写入位置，缓冲池或发送队列繁忙时返回NULL
+    uint8_t *UdpBatch_Reserve(udp_batch_t *b, uint16_t *space);
+
+    // 提交UdpBatch_Reserve之后写入的len字节，units为其中包含的数量
+    void UdpBatch_Commit(udp_batch_t *b, uint16_t len, uint32_t units);
+
+    // 当前数据报的剩余空间，没有数据报时为UDP_BATCH_PAYLOAD_MAX
+    uint16_t UdpBatch_Space(const udp_batch_t *b);
+
+    // 当前数据报是否已超过flush_ms
+    int UdpBatch_Due(const udp_batch_t *b);
+
+    // 取出当前数据报，之后由UdpBatch_Send或UdpBatch_Discard处理
+    // 参数：units - 返回其中包含的数量
+    // 返回：数据报，没有时返回NULL
+    pkt_buf_t *UdpBatch_Detach(udp_batch_t *b, uint32_t *units);
+
+    // 填写头部并发送取出的数据报，之后释放buf；失败时units计入dropped
+    // 返回：0 - 成功, 负数 - UDP_SendBufTo的错误码
+    int UdpBatch_Send(udp_batch_t *b, pkt_buf_t *buf, uint32_t units);
+
+    // 放弃取出的数据报（如限速），units计入dropped并释放buf
+    void UdpBatch_Discard(udp_batch_t *b, pkt_buf_t *buf, uint32_t units);
+
+    // 记录未能写入的数量，随下一个数据报上报
+    void UdpBatch_Drop(udp_batch_t *b, uint32_t units);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDP_BATCH_H */
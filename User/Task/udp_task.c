@@ -1,19 +1,27 @@
 #include "elog.h"
-#include <errno.h>
+#include "elog_rl.h"
 #include <stdio.h>
 #include <string.h>
 
+#include "FreeRTOS.h"
 #include "cmsis_os.h"
+#include "message_buffer.h"
+#include "lwip/api.h"
 #include "lwip/inet.h"
-#include "lwip/netdb.h"
 #include "lwip/sockets.h"
+#include "lwip/tcpip.h"
+#include "lwip/udp.h"
 #include "main.h"
+#include "ccm_ram.h"
+#include "rtos_static.h"
 #include "udp_task.h"
 
 #define UDP_SERVER_PORT 8080
 #define TX_QUEUE_SIZE 2 * 10
-#define RX_QUEUE_SIZE 10 * 10
+#define TX_REF_POOL_SIZE 16 // 同时在以太网DMA中等待发送完成的零拷贝帧数
+#define RX_BUFFER_BYTES 8 * 1024 // 接收消息缓冲区按字节计，记录为变长
 
+#if !UDP_TRANSPORT_RAW
 // 消息类型定义
 typedef enum
 {
@@ -22,211 +30,346 @@ typedef enum
     MSG_TYPE_CONFIG         // 配置信息
 } msg_type_t;
 
-// 发送消息结构体
+// 发送消息结构体，队列持有buf的一次引用
 typedef struct
 {
     msg_type_t type;
-    struct sockaddr_in dest_addr; // 目标地址
-    uint16_t data_len;
-    uint8_t data[UDP_BUFFER_SIZE];
+    udp_endpoint_t dest; // 目标地址
+    pkt_buf_t *buf;
 } tx_msg_t;
+#endif
+
+// 零拷贝发送引用：PBUF_REF类型的自定义pbuf直接指向缓冲块数据，
+// 以太网DMA发送完成后pbuf被释放时才归还缓冲块
+typedef struct
+{
+    struct pbuf_custom pc; // 必须是第一个成员
+    pkt_buf_t *buf;
+} udp_tx_ref_t;
 
 // 全局变量
+#if UDP_TRANSPORT_RAW
+static struct udp_pcb *udpPcb; // 只在持有tcpip内核锁或tcpip线程中访问
+#else
 static osMessageQueueId_t txQueue; // 发送队列
-static osMessageQueueId_t rxQueue; // 接收队列
 static osThreadId_t udpTaskHandle;
+#endif
+static MessageBufferHandle_t rxMsgBuf; // 接收消息缓冲区，单写(UDP任务/tcpip线程)单读(UDP_ReceiveData)
+static volatile uint32_t rxMsgCount;   // 缓冲区中的记录数
+static udp_rx_msg_t rxStaging;         // 接收暂存区，只在写入方中使用
+static osMemoryPoolId_t txRefPool;     // 零拷贝发送引用池
 
 // 接收数据回调函数指针
 typedef void (*udp_rx_callback_t)(const udp_rx_msg_t *msg);
 static udp_rx_callback_t rx_callback = NULL;
 
+// lwIP错误码转换为可读描述
+static const char *udp_err_desc(err_t err)
+{
+    switch (err)
+    {
+    case ERR_MEM:
+    case ERR_BUF:
+        return "No buffer space available";
+    case ERR_IF:
+        return "Network is down";
+    case ERR_RTE:
+        return "Network unreachable";
+    case ERR_CONN:
+    case ERR_CLSD:
+        return "Connection refused";
+    case ERR_VAL:
+        return "Message too large";
+    default:
+        return "Netconn send error";
+    }
+}
+
+// 零拷贝pbuf释放回调，可能在tcpip线程或以太网发送完成路径中调用
+static void udp_tx_ref_free(struct pbuf *p)
+{
+    udp_tx_ref_t *ref = (udp_tx_ref_t *)p;
+    PktBuf_Release(ref->buf);
+    osMemoryPoolFree(txRefPool, ref);
+}
+
+// 为缓冲块创建引用型pbuf，引用池耗尽时退化为拷贝到PBUF_RAM
+static struct pbuf *udp_make_pbuf(pkt_buf_t *buf)
+{
+    udp_tx_ref_t *ref = (udp_tx_ref_t *)osMemoryPoolAlloc(txRefPool, 0);
+    if (ref != NULL)
+    {
+        ref->pc.custom_free_function = udp_tx_ref_free;
+        ref->buf = PktBuf_Ref(buf);
+        return pbuf_alloced_custom(PBUF_RAW, buf->len, PBUF_REF, &ref->pc, buf->data, buf->len);
+    }
+
+    struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, buf->len, PBUF_RAM);
+    if (p != NULL)
+    {
+        memcpy(p->payload, buf->data, buf->len);
+    }
+    return p;
+}
+
+// 投递一条接收记录：先调用回调，再以精确长度写入接收消息缓冲区
+static void udp_rx_deliver(const udp_rx_msg_t *rx_msg)
+{
+    // 记录接收到的字节数
+    elog_i("udp_task", "UDP received %d bytes from %s:%d", rx_msg->len, inet_ntoa(rx_msg->src_addr.sin_addr),
+           ntohs(rx_msg->src_addr.sin_port));
+
+    // 如果有回调函数，调用它
+    if (rx_callback != NULL)
+    {
+        rx_callback(rx_msg);
+    }
+
+    // 将数据写入接收消息缓冲区，只占用头部加实际数据长度
+    size_t record_len = UDP_RX_MSG_HDR_SIZE + rx_msg->len;
+    if (xMessageBufferSend(rxMsgBuf, rx_msg, record_len, 0) != record_len)
+    {
+        elog_rl_w("udp_task", "UDP RX buffer full, dropping packet from %s:%d (%d bytes)",
+                  inet_ntoa(rx_msg->src_addr.sin_addr), ntohs(rx_msg->src_addr.sin_port), rx_msg->len);
+    }
+    else
+    {
+        __atomic_add_fetch(&rxMsgCount, 1, __ATOMIC_RELAXED);
+    }
+}
+
+// 记录源地址
+static void udp_rx_set_src(udp_rx_msg_t *rx_msg, const ip_addr_t *ip, u16_t port)
+{
+    memset(&rx_msg->src_addr, 0, sizeof(rx_msg->src_addr));
+    rx_msg->src_addr.sin_family = AF_INET;
+    rx_msg->src_addr.sin_port = htons(port);
+    rx_msg->src_addr.sin_addr.s_addr = ip4_addr_get_u32(ip_2_ip4(ip));
+}
+
+// 截断超长数据报
+static uint16_t udp_rx_clamp_len(uint16_t recv_len)
+{
+    if (recv_len > UDP_RX_MAX_DATAGRAM)
+    {
+        elog_rl_w("udp_task",
+                  "UDP packet size (%d bytes) > max datagram size (%d bytes), data truncated! "
+                  "Consider increasing UDP_RX_MAX_DATAGRAM if packets exceed this size.",
+                  recv_len, UDP_RX_MAX_DATAGRAM);
+        return UDP_RX_MAX_DATAGRAM;
+    }
+    return recv_len;
+}
+
+#if UDP_TRANSPORT_RAW
+// raw API接收回调，运行在tcpip线程中
+// 单个pbuf时把记录头原地写入已解析完的UDP/IP头部空间，数据只拷贝一次进入接收消息缓冲区
+static void udp_raw_recv(void *arg, struct udp_pcb *pcb, struct pbuf *p, const ip_addr_t *addr, u16_t port)
+{
+    (void)arg;
+    (void)pcb;
+
+    uint16_t recv_len = udp_rx_clamp_len(p->tot_len);
+    if (p->next == NULL && pbuf_add_header_force(p, UDP_RX_MSG_HDR_SIZE) == 0)
+    {
+        if (((uintptr_t)p->payload & (MEM_ALIGNMENT - 1)) == 0)
+        {
+            udp_rx_msg_t *rx_msg = (udp_rx_msg_t *)p->payload;
+            udp_rx_set_src(rx_msg, addr, port);
+            rx_msg->len = recv_len;
+            udp_rx_deliver(rx_msg);
+            pbuf_free(p);
+            return;
+        }
+        pbuf_remove_header(p, UDP_RX_MSG_HDR_SIZE);
+    }
+
+    // 链式pbuf或无法对齐时经暂存区拼接
+    udp_rx_set_src(&rxStaging, addr, port);
+    rxStaging.len = pbuf_copy_partial(p, rxStaging.data, recv_len, 0);
+    pbuf_free(p);
+    udp_rx_deliver(&rxStaging);
+}
+#else
+// 任务事件标志
+#define UDP_EVT_RX 0x01U // netconn收到数据
+#define UDP_EVT_TX 0x02U // 发送队列有新消息
+
+// netconn事件回调，运行在tcpip线程中，只负责唤醒UDP任务
+static void udp_netconn_callback(struct netconn *conn, enum netconn_evt evt, u16_t len)
+{
+    (void)conn;
+    (void)len;
+    if (evt == NETCONN_EVT_RCVPLUS && udpTaskHandle != NULL)
+    {
+        osThreadFlagsSet(udpTaskHandle, UDP_EVT_RX);
+    }
+}
+
+// 发送一条消息，buf的引用由调用者释放
+static void udp_send_msg(struct netconn *conn, const tx_msg_t *tx_msg)
+{
+    err_t err = ERR_MEM;
+    struct netbuf *nb = netbuf_new();
+    if (nb != NULL)
+    {
+        nb->p = udp_make_pbuf(tx_msg->buf);
+        nb->ptr = nb->p;
+        if (nb->p != NULL)
+        {
+            err = netconn_sendto(conn, nb, &tx_msg->dest.ip, tx_msg->dest.port);
+        }
+        // 协议栈仍在使用的pbuf保留自己的引用，此处只释放netbuf持有的一次
+        netbuf_delete(nb);
+    }
+
+    if (err != ERR_OK)
+    {
+        elog_rl_e("udp_task", "UDP sendto failed: %s, target=%s:%d, size=%d", udp_err_desc(err),
+                  ipaddr_ntoa(&tx_msg->dest.ip), tx_msg->dest.port, tx_msg->buf->len);
+    }
+    else
+    {
+        elog_v("udp_task", "UDP sent %d bytes to %s:%d", tx_msg->buf->len, ipaddr_ntoa(&tx_msg->dest.ip),
+               tx_msg->dest.port);
+    }
+}
+
+// 一次取空发送队列
+static void udp_drain_tx(struct netconn *conn)
+{
+    tx_msg_t tx_msg;
+
+    while (osMessageQueueGet(txQueue, &tx_msg, NULL, 0) == osOK)
+    {
+        switch (tx_msg.type)
+        {
+        case MSG_TYPE_SEND_DATA:
+            udp_send_msg(conn, &tx_msg);
+            break;
+
+        case MSG_TYPE_CLOSE_CONN:
+            break;
+
+        case MSG_TYPE_CONFIG:
+            break;
+
+        default:
+            break;
+        }
+        PktBuf_Release(tx_msg.buf);
+    }
+}
+
+// 一次取空netconn接收邮箱，每个数据报以精确长度的记录写入接收消息缓冲区
+static void udp_drain_rx(struct netconn *conn)
+{
+    struct netbuf *nb;
+
+    while (netconn_recv(conn, &nb) == ERR_OK)
+    {
+        uint16_t recv_len = udp_rx_clamp_len(netbuf_len(nb));
+        udp_rx_set_src(&rxStaging, netbuf_fromaddr(nb), netbuf_fromport(nb));
+        rxStaging.len = netbuf_copy(nb, rxStaging.data, recv_len);
+        netbuf_delete(nb);
+
+        udp_rx_deliver(&rxStaging);
+    }
+}
+
 // UDP通信任务
+// 由netconn接收事件或发送队列入队事件唤醒，每次唤醒取空两个方向的数据，空闲时不占CPU
 void udp_comm_task(void *argument)
 {
-    int sockfd;
-    struct sockaddr_in server_addr, client_addr;
-    char buffer[2 * UDP_BUFFER_SIZE];
-    socklen_t client_addr_len = sizeof(client_addr);
-    int recv_len;
-    tx_msg_t tx_msg;
-    udp_rx_msg_t rx_msg;
+    struct netconn *conn;
 
-    // 创建 socket
-    sockfd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-    if (sockfd < 0)
+    // 创建 netconn
+    conn = netconn_new_with_callback(NETCONN_UDP, udp_netconn_callback);
+    if (conn == NULL)
     {
-        elog_e("udp_task", "Failed to create UDP socket");
+        elog_e("udp_task", "Failed to create UDP netconn");
         osThreadExit();
     }
 
-    // 设置服务器地址结构
-    server_addr.sin_family = AF_INET;
-    server_addr.sin_port = htons(UDP_SERVER_PORT);
-    server_addr.sin_addr.s_addr = htonl(INADDR_ANY);
-
-    // 绑定 socket
-    if (bind(sockfd, (struct sockaddr *)&server_addr, sizeof(server_addr)) < 0)
+    // 绑定端口
+    if (netconn_bind(conn, IP_ADDR_ANY, UDP_SERVER_PORT) != ERR_OK)
     {
-        elog_e("udp_task", "Failed to bind UDP socket to port %d", UDP_SERVER_PORT);
-        closesocket(sockfd);
+        elog_e("udp_task", "Failed to bind UDP netconn to port %d", UDP_SERVER_PORT);
+        netconn_delete(conn);
         osThreadExit();
     }
 
+    // 接收改为非阻塞，由事件标志驱动
+    netconn_set_nonblocking(conn, 1);
+
     elog_i("udp_task", "UDP server started on port %d", UDP_SERVER_PORT);
 
     while (1)
     {
-        // 检查是否有发送消息
-        if (osMessageQueueGet(txQueue, &tx_msg, NULL, 0) == osOK)
-        {
-            switch (tx_msg.type)
-            {
-            case MSG_TYPE_SEND_DATA:
-                // 发送数据到指定地址
-                {
-                    int sent_bytes = sendto(sockfd, tx_msg.data, tx_msg.data_len, 0,
-                                            (struct sockaddr *)&tx_msg.dest_addr, sizeof(tx_msg.dest_addr));
-                    if (sent_bytes < 0)
-                    {
-                        // 发送失败，记录错误
-                        const char *error_desc = "Unknown error";
-                        switch (errno)
-                        {
-                        case ENOBUFS:
-                            error_desc = "No buffer space available";
-                            break;
-                        case ENETDOWN:
-                            error_desc = "Network is down";
-                            break;
-                        case ENETUNREACH:
-                            error_desc = "Network unreachable";
-                            break;
-                        case EHOSTUNREACH:
-                            error_desc = "Host unreachable";
-                            break;
-                        case ECONNREFUSED:
-                            error_desc = "Connection refused";
-                            break;
-                        case EMSGSIZE:
-                            error_desc = "Message too large";
-                            break;
-                        default:
-                            error_desc = "Socket send error";
-                            break;
-                        }
-                        elog_e("udp_task", "UDP sendto failed: %s, target=%s:%d, size=%d", error_desc,
-                               inet_ntoa(tx_msg.dest_addr.sin_addr), ntohs(tx_msg.dest_addr.sin_port), tx_msg.data_len);
-                    }
-                    else if (sent_bytes != tx_msg.data_len)
-                    {
-                        // 部分发送
-                        elog_w("udp_task", "UDP partial send: sent=%d, expected=%d", sent_bytes, tx_msg.data_len);
-                    }
-                    else
-                    {
-                        // 发送成功
-                        elog_v("udp_task", "UDP sent %d bytes to %s:%d", sent_bytes,
-                               inet_ntoa(tx_msg.dest_addr.sin_addr), ntohs(tx_msg.dest_addr.sin_port));
-                    }
-                }
-                break;
-
-            case MSG_TYPE_CLOSE_CONN:
-                break;
-
-            case MSG_TYPE_CONFIG:
-                break;
-
-            default:
-                break;
-            }
-        }
-
-        // 非阻塞接收数据
-        recv_len = recvfrom(sockfd, buffer, sizeof(buffer), MSG_DONTWAIT, (struct sockaddr *)&client_addr,
-                            &client_addr_len);
-        if (recv_len > 0)
+        uint32_t flags = osThreadFlagsWait(UDP_EVT_RX | UDP_EVT_TX, osFlagsWaitAny, osWaitForever);
+        if (flags & osFlagsError)
         {
-            // 检查是否可能发生数据截断
-            if (recv_len >= sizeof(buffer))
-            {
-                elog_w("udp_task",
-                       "UDP packet size (%d bytes) >= buffer size (%d bytes), data may be truncated! "
-                       "Consider increasing UDP_BUFFER_SIZE if packets exceed this size.",
-                       recv_len, UDP_BUFFER_SIZE);
-            }
-
-            // 记录接收到的字节数
-            elog_i("udp_task", "UDP received %d bytes from %s:%d", recv_len, inet_ntoa(client_addr.sin_addr),
-                   ntohs(client_addr.sin_port));
-
-            // 构造接收消息 - 如果数据超过缓冲区大小，分多次放入队列
-            rx_msg.src_addr = client_addr;
-            
-            // 计算需要分成多少个包
-            int total_bytes = recv_len;
-            int offset = 0;
-            int chunk_count = 0;
-            int failed_chunks = 0;
-            
-            while (offset < total_bytes)
-            {
-                // 计算本次要复制的数据长度
-                int chunk_size = (total_bytes - offset > UDP_BUFFER_SIZE) ? UDP_BUFFER_SIZE : (total_bytes - offset);
-                rx_msg.data_len = chunk_size;
-                
-                // 复制数据到消息缓冲区
-                for (int i = 0; i < chunk_size; i++)
-                {
-                    rx_msg.data[i] = buffer[offset + i];
-                }
-                
-                // 将数据放入接收队列
-                if (osMessageQueuePut(rxQueue, &rx_msg, 0, 0) != osOK)
-                {
-                    elog_w("udp_task", "UDP RX queue full, dropping chunk %d from %s:%d (%d bytes)",
-                           chunk_count + 1, inet_ntoa(client_addr.sin_addr), ntohs(client_addr.sin_port), chunk_size);
-                    failed_chunks++;
-                }
-                else
-                {
-                    elog_v("udp_task", "UDP chunk %d queued successfully (%d bytes)", chunk_count + 1, chunk_size);
-                    
-                    // 如果有回调函数，调用它
-                    if (rx_callback != NULL)
-                    {
-                        rx_callback(&rx_msg);
-                    }
-                }
-                
-                offset += chunk_size;
-                chunk_count++;
-            }
-            
-            // 如果数据被分成多个包，记录日志
-            if (chunk_count > 1)
-            {
-                elog_i("udp_task", "Large UDP packet split into %d chunks (%d bytes total, %d chunks failed)",
-                       chunk_count, total_bytes, failed_chunks);
-            }
+            continue;
         }
 
-        osDelay(10); // 防止任务占满 CPU
+        // 先发送，转发的从机数据到达后立即发出
+        udp_drain_tx(conn);
+        udp_drain_rx(conn);
     }
 }
 
+#endif
+
+// 接收消息缓冲区只由CPU拷贝读写（UDP任务/tcpip线程写入，BackDataProcT读出），放在CCM中
+CCM_RAM static StaticMessageBuffer_t rxMsgBufCb;
+CCM_RAM static uint8_t rxMsgBufMem[RX_BUFFER_BYTES + 1]; // 流缓冲区存储区需比容量多1字节
+RTOS_STATIC_MEMPOOL(txRefPool, TX_REF_POOL_SIZE, sizeof(udp_tx_ref_t))
+#if !UDP_TRANSPORT_RAW
+RTOS_STATIC_QUEUE(txQueue, TX_QUEUE_SIZE, sizeof(tx_msg_t))
+RTOS_STATIC_THREAD(udpCommTask, 1024 * 16)
+#endif
+
 // 初始化UDP通信任务
 void UDP_Task_Init(void)
 {
-    // 创建消息队列
-    txQueue = osMessageQueueNew(TX_QUEUE_SIZE, sizeof(tx_msg_t), NULL);
-    if (txQueue == NULL)
+    rxMsgBuf = xMessageBufferCreateStatic(RX_BUFFER_BYTES, rxMsgBufMem, &rxMsgBufCb);
+    if (rxMsgBuf == NULL)
     {
         return;
     }
 
-    rxQueue = osMessageQueueNew(RX_QUEUE_SIZE, sizeof(udp_rx_msg_t), NULL);
-    if (rxQueue == NULL)
+    txRefPool = osMemoryPoolNew(TX_REF_POOL_SIZE, sizeof(udp_tx_ref_t), RTOS_STATIC_ATTR(txRefPool));
+    if (txRefPool == NULL)
+    {
+        return;
+    }
+
+#if UDP_TRANSPORT_RAW
+    // raw API直接在tcpip线程中收发，无需UDP任务
+    LOCK_TCPIP_CORE();
+    udpPcb = udp_new();
+    if (udpPcb == NULL)
+    {
+        UNLOCK_TCPIP_CORE();
+        elog_e("udp_task", "Failed to create UDP pcb");
+        return;
+    }
+    if (udp_bind(udpPcb, IP_ADDR_ANY, UDP_SERVER_PORT) != ERR_OK)
+    {
+        udp_remove(udpPcb);
+        udpPcb = NULL;
+        UNLOCK_TCPIP_CORE();
+        elog_e("udp_task", "Failed to bind UDP pcb to port %d", UDP_SERVER_PORT);
+        return;
+    }
+    udp_recv(udpPcb, udp_raw_recv, NULL);
+    UNLOCK_TCPIP_CORE();
+
+    elog_i("udp_task", "UDP raw server started on port %d", UDP_SERVER_PORT);
+#else
+    // 创建消息队列
+    txQueue = osMessageQueueNew(TX_QUEUE_SIZE, sizeof(tx_msg_t), RTOS_STATIC_ATTR(txQueue));
+    if (txQueue == NULL)
     {
         return;
     }
@@ -234,45 +377,136 @@ void UDP_Task_Init(void)
     // 创建UDP通信任务
     const osThreadAttr_t udpTask_attributes = {
         .name = "udpCommTask",
+        RTOS_STATIC_THREAD_ATTR(udpCommTask)
         .stack_size = 1024 * 16,
         .priority = (osPriority_t)osPriorityNormal,
     };
     udpTaskHandle = osThreadNew(udp_comm_task, NULL, &udpTask_attributes);
+#endif
+}
+
+// API函数：解析目标地址，结果可缓存复用
+int UDP_ResolveEndpoint(udp_endpoint_t *ep, const char *ip_addr, uint16_t port)
+{
+    if (ep == NULL || ip_addr == NULL)
+    {
+        return -1;
+    }
+
+    if (ipaddr_aton(ip_addr, &ep->ip) == 0)
+    {
+        return -2; // 无效的IP地址
+    }
+    ep->port = port;
+
+    return 0;
 }
 
-// API函数：发送UDP数据·
+// API函数：发送UDP数据
 int UDP_SendData(const uint8_t *data, uint16_t len, const char *ip_addr, uint16_t port)
 {
-    if (data == NULL || len == 0 || len > UDP_BUFFER_SIZE || ip_addr == NULL)
+    udp_endpoint_t ep;
+    int ret = UDP_ResolveEndpoint(&ep, ip_addr, port);
+    if (ret != 0)
+    {
+        return ret;
+    }
+
+    return UDP_SendDataTo(data, len, &ep);
+}
+
+// API函数：发送UDP数据到已解析的目标地址
+int UDP_SendDataTo(const uint8_t *data, uint16_t len, const udp_endpoint_t *ep)
+{
+    if (data == NULL || len == 0 || len > UDP_BUFFER_SIZE || ep == NULL)
     {
         return -1;
     }
 
-    tx_msg_t msg;
-    msg.type = MSG_TYPE_SEND_DATA;
-    msg.data_len = len;
+    pkt_buf_t *buf = PktBuf_Alloc(0);
+    if (buf == NULL)
+    {
+        return -3; // 缓冲池耗尽
+    }
 
     // use memcpy to copy data
-    memcpy(msg.data, data, len);
+    memcpy(buf->data, data, len);
+    buf->len = len;
 
-    // 设置目标地址
-    msg.dest_addr.sin_family = AF_INET;
-    msg.dest_addr.sin_port = htons(port);
-    if (inet_aton(ip_addr, &msg.dest_addr.sin_addr) == 0)
+    int ret = UDP_SendBufTo(buf, ep);
+    PktBuf_Release(buf);
+    return ret;
+}
+
+// API函数：发送缓冲块中的UDP数据（零拷贝）
+int UDP_SendBuf(pkt_buf_t *buf, const char *ip_addr, uint16_t port)
+{
+    udp_endpoint_t ep;
+    int ret = UDP_ResolveEndpoint(&ep, ip_addr, port);
+    if (ret != 0)
     {
-        return -2; // 无效的IP地址
+        return ret;
     }
 
+    return UDP_SendBufTo(buf, &ep);
+}
+
+// API函数：发送缓冲块中的UDP数据到已解析的目标地址（零拷贝）
+#if UDP_TRANSPORT_RAW
+// 在调用者上下文中持有tcpip内核锁直接发送，不经过队列和tcpip邮箱
+int UDP_SendBufTo(pkt_buf_t *buf, const udp_endpoint_t *ep)
+{
+    if (buf == NULL || buf->len == 0 || buf->len > UDP_BUFFER_SIZE || ep == NULL)
+    {
+        return -1;
+    }
+
+    err_t err = ERR_MEM;
+    LOCK_TCPIP_CORE();
+    struct pbuf *p = (udpPcb != NULL) ? udp_make_pbuf(buf) : NULL;
+    if (p != NULL)
+    {
+        err = udp_sendto(udpPcb, p, &ep->ip, ep->port);
+        pbuf_free(p);
+    }
+    UNLOCK_TCPIP_CORE();
+
+    if (err != ERR_OK)
+    {
+        elog_rl_e("udp_task", "UDP sendto failed: %s, target=%s:%d, size=%d", udp_err_desc(err),
+                  ipaddr_ntoa(&ep->ip), ep->port, buf->len);
+        return -3;
+    }
+
+    return 0; // 成功
+}
+#else
+int UDP_SendBufTo(pkt_buf_t *buf, const udp_endpoint_t *ep)
+{
+    if (buf == NULL || buf->len == 0 || buf->len > UDP_BUFFER_SIZE || ep == NULL)
+    {
+        return -1;
+    }
+
+    tx_msg_t msg;
+    msg.type = MSG_TYPE_SEND_DATA;
+    msg.dest = *ep;
+
     // 发送到队列
+    msg.buf = PktBuf_Ref(buf);
     if (osMessageQueuePut(txQueue, &msg, 0, 100) != osOK)
     {
+        PktBuf_Release(buf);
         return -3; // 队列满或超时
     }
+    osThreadFlagsSet(udpTaskHandle, UDP_EVT_TX);
 
     return 0; // 成功
 }
 
-// API函数：接收UDP数据（非阻塞）
+#endif
+
+// API函数：接收UDP数据
 int UDP_ReceiveData(udp_rx_msg_t *msg, uint32_t timeout_ms)
 {
     if (msg == NULL)
@@ -280,8 +514,11 @@ int UDP_ReceiveData(udp_rx_msg_t *msg, uint32_t timeout_ms)
         return -1;
     }
 
-    if (osMessageQueueGet(rxQueue, msg, NULL, timeout_ms) == osOK)
+    TickType_t ticks = (timeout_ms == osWaitForever) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    size_t record_len = xMessageBufferReceive(rxMsgBuf, msg, sizeof(*msg), ticks);
+    if (record_len >= UDP_RX_MSG_HDR_SIZE)
     {
+        __atomic_sub_fetch(&rxMsgCount, 1, __ATOMIC_RELAXED);
         return 0; // 成功
     }
 
@@ -297,29 +534,36 @@ void UDP_SetRxCallback(udp_rx_callback_t callback)
 // API函数：获取队列状态
 int UDP_GetTxQueueCount(void)
 {
+#if UDP_TRANSPORT_RAW
+    return 0; // raw模式直接发送，没有发送队列
+#else
     return (int)osMessageQueueGetCount(txQueue);
+#endif
 }
 
 int UDP_GetRxQueueCount(void)
 {
-    return (int)osMessageQueueGetCount(rxQueue);
+    return (int)rxMsgCount;
 }
 
 // API函数：清空队列
 void UDP_ClearTxQueue(void)
 {
+#if !UDP_TRANSPORT_RAW
     tx_msg_t msg;
     while (osMessageQueueGet(txQueue, &msg, NULL, 0) == osOK)
     {
         // 清空队列
+        PktBuf_Release(msg.buf);
     }
+#endif
 }
 
 void UDP_ClearRxQueue(void)
 {
-    udp_rx_msg_t msg;
-    while (osMessageQueueGet(rxQueue, &msg, NULL, 0) == osOK)
+    // 只有读写双方都未阻塞时才能复位
+    if (xMessageBufferReset(rxMsgBuf) == pdPASS)
     {
-        // 清空队列
+        rxMsgCount = 0;
     }
 }
\ No newline at end of file
@@ -1,7 +1,10 @@
 #ifndef UDP_TASK_H
 #define UDP_TASK_H
 
+#include "lwip/ip_addr.h"
 #include "lwip/sockets.h"
+#include "pkt_buf.h"
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -10,42 +13,67 @@ extern "C"
 #endif
 
 #define UDP_BUFFER_SIZE 1016
+#define UDP_RX_MAX_DATAGRAM 1472 // 以太网MTU下不分片的最大UDP负载
 
-    // 接收消息结构体
+    // 接收消息结构体，同时也是接收缓冲区中的记录格式
+    // 缓冲区中只保存头部和len字节的数据，调用者提供的结构体需按最大长度分配
     typedef struct
     {
         struct sockaddr_in src_addr; // 源地址
-        uint16_t data_len;
-        uint8_t data[UDP_BUFFER_SIZE];
+        uint16_t len;                // 数据长度
+        uint8_t data[UDP_RX_MAX_DATAGRAM];
     } udp_rx_msg_t;
 
+#define UDP_RX_MSG_HDR_SIZE offsetof(udp_rx_msg_t, data)
+
+    // 已解析的UDP目标地址，可长期缓存以避免每次发送都解析字符串
+    typedef struct
+    {
+        ip_addr_t ip;
+        uint16_t port;
+    } udp_endpoint_t;
+
     // 接收数据回调函数指针
     typedef void (*udp_rx_callback_t)(const udp_rx_msg_t *msg);
 
     // 初始化UDP通信任务
     void UDP_Task_Init(void);
 
+    // API函数：解析目标地址
+    // 参数：ep - 输出的目标地址, ip_addr - 点分十进制IP地址, port - 目标端口
+    // 返回：0 - 成功, -1 - 参数错误, -2 - 无效IP地址
+    int UDP_ResolveEndpoint(udp_endpoint_t *ep, const char *ip_addr, uint16_t port);
+
     // API函数：发送UDP数据
     // 参数：data - 要发送的数据, len - 数据长度, ip_addr - 目标IP地址, port - 目标端口
     // 返回：0 - 成功, -1 - 参数错误, -2 - 无效IP地址, -3 - 队列满或超时
     int UDP_SendData(const uint8_t *data, uint16_t len, const char *ip_addr, uint16_t port);
 
-    // API函数：接收UDP数据（非阻塞）
-    // 参数：msg - 接收消息缓冲区, timeout_ms - 超时时间（毫秒）
+    // API函数：发送缓冲块中的UDP数据（零拷贝），函数内部增加一次引用，调用者仍需释放自己的引用
+    // 返回值同UDP_SendData
+    int UDP_SendBuf(pkt_buf_t *buf, const char *ip_addr, uint16_t port);
+
+    // API函数：发送到已解析的目标地址，返回值同UDP_SendData
+    // 缓冲块以PBUF_REF形式交给以太网DMA，发送完成后才释放内部引用，入队后调用者不得再修改buf
+    int UDP_SendDataTo(const uint8_t *data, uint16_t len, const udp_endpoint_t *ep);
+    int UDP_SendBufTo(pkt_buf_t *buf, const udp_endpoint_t *ep);
+
+    // API函数：接收UDP数据，同一时间只允许一个任务调用
+    // 参数：msg - 接收消息缓冲区, timeout_ms - 超时时间（毫秒），osWaitForever表示一直等待
     // 返回：0 - 成功, -1 - 超时或错误
     int UDP_ReceiveData(udp_rx_msg_t *msg, uint32_t timeout_ms);
 
     // API函数：设置接收回调函数
-    // 参数：callback - 回调函数指针，当接收到数据时自动调用
+    // 参数：callback - 回调函数指针，当接收到数据时在UDP任务中调用，msg只在回调期间有效
     void UDP_SetRxCallback(udp_rx_callback_t callback);
 
     // API函数：获取队列状态
     int UDP_GetTxQueueCount(void); // 获取发送队列中的消息数量
-    int UDP_GetRxQueueCount(void); // 获取接收队列中的消息数量
+    int UDP_GetRxQueueCount(void); // 获取接收缓冲区中的消息数量
 
     // API函数：清空队列
     void UDP_ClearTxQueue(void); // 清空发送队列
-    void UDP_ClearRxQueue(void); // 清空接收队列
+    void UDP_ClearRxQueue(void); // 清空接收缓冲区，有任务阻塞在缓冲区上时不生效
 
 #ifdef __cplusplus
 }
@@ -1,11 +1,13 @@
 #include "uwb_task.h"
 
 #include "cmsis_os2.h"
+#include <cstring>
 #include <memory>
 
 #if UWB_CHIP_TYPE_DW1000
 #include "deca_device_api.h"
 #include "deca_regs.h"
+#include "deca_spi.h"
 #include "port.h"
 #elif UWB_CHIP_TYPE_CX310
 #include "CX310.hpp"
@@ -17,6 +19,9 @@ extern CX310_SlaveSpiAdapter *g_uwb_adapter;
 #endif
 
 #include "elog.h"
+#include "elog_bin.h"
+#include "elog_rl.h"
+#include "rtos_static.h"
 
 #define TX_QUEUE_SIZE 10
 #define RX_QUEUE_SIZE 10
@@ -30,12 +35,12 @@ typedef enum
     UWB_MSG_TYPE_SET_CHANNEL    // 设置信道
 } uwb_msg_type_t;
 
-// UWB发送消息结构体
+// UWB发送消息结构体，数据类消息携带缓冲块句柄，队列持有一次引用
 typedef struct
 {
     uwb_msg_type_t type;
-    uint16_t data_len;
-    uint8_t data[FRAME_LEN_MAX];
+    pkt_buf_t *buf;    // 发送数据，控制类消息为NULL
+    uint8_t param;     // 控制参数（信道号等）
     uint32_t delay_ms; // 发送延迟时间
 } uwb_tx_msg_t;
 
@@ -50,9 +55,15 @@ typedef void (*uwb_rx_callback_t)(const uwb_rx_msg_t *msg);
 static uwb_rx_callback_t uwb_rx_callback = NULL;
 
 #if UWB_CHIP_TYPE_DW1000
-static uint8_t rx_buffer[FRAME_LEN_MAX];
-static uint32_t status_reg = 0;
-static uint16_t frame_len = 0;
+#define UWB_EVT_IRQ 0x01U        // DW1000中断，由EXTI通知
+#define UWB_EVT_TX 0x02U         // 发送队列有新消息
+#define UWB_TX_DONE_MARGIN_MS 2 // 等待TXFRS的兜底超时：本帧空中时间之外的余量
+
+static volatile bool tx_busy = false;    // 已启动发送，等待TX完成回调
+static volatile bool rx_overrun = false; // 双缓冲溢出，需要复位接收器
+static uint32_t tx_start_tick = 0;
+static uint32_t tx_timeout_ms = 0; // 当前帧的TX完成兜底超时
+
 /* Default communication configuration. */
 static dwt_config_t config = {
     5,               // 通道号，推荐5或2，5抗干扰稍强
@@ -67,14 +78,175 @@ static dwt_config_t config = {
     (1025 + 64 - 32) // SFD超时时间：可按 PLEN + margin 设置
 };
 
+// 按当前配置估算一帧（含CRC）的空中时间（us）：前导码+SFD、PHR、数据及RS校验（每330bit数据附加48bit）
+static uint32_t uwb_tx_airtime_us(uint16_t frame_len)
+{
+    uint32_t plen;
+    switch (config.txPreambLength)
+    {
+    case DWT_PLEN_4096:
+        plen = 4096;
+        break;
+    case DWT_PLEN_2048:
+        plen = 2048;
+        break;
+    case DWT_PLEN_1536:
+        plen = 1536;
+        break;
+    case DWT_PLEN_1024:
+        plen = 1024;
+        break;
+    case DWT_PLEN_512:
+        plen = 512;
+        break;
+    case DWT_PLEN_256:
+        plen = 256;
+        break;
+    case DWT_PLEN_128:
+        plen = 128;
+        break;
+    default:
+        plen = 64;
+        break;
+    }
+
+    // 数据速率（kbps）；PHR在6.8M时仍以850k发送，SFD取非标准SFD的最大长度
+    uint32_t kbps = config.dataRate == DWT_BR_110K ? 110 : (config.dataRate == DWT_BR_850K ? 850 : 6800);
+    uint32_t phrKbps = config.dataRate == DWT_BR_110K ? 110 : 850;
+    uint32_t sfd = config.dataRate == DWT_BR_110K ? 64 : 16;
+
+    uint32_t bits = frame_len * 8U;
+    bits += (bits + 329U) / 330U * 48U;
+
+    // 前导码符号长约1.02us（PRF 16M为0.99us），按1.03us估算
+    return (plen + sfd) * 103U / 100U + 21U * 1000U / phrKbps + bits * 1000U / kbps;
+}
+
+// EXTI中断中调用：屏蔽DW1000中断线并通知任务，dwt_isr在任务上下文中执行
+static void uwb_deca_irq_notify(void)
+{
+    port_DisableEXT_IRQ();
+    osThreadFlagsSet(uwbCommTaskHandle, UWB_EVT_IRQ);
+}
+
+// 以下回调由任务中的dwt_isr调用
+static void uwb_rx_ok_cb(const dwt_cb_data_t *cb_data)
+{
+    static constexpr const char TAG[] = "uwb_comm";
+
+    // 双缓冲模式：先让接收器在另一个缓冲区继续接收，再读取当前帧
+    dwt_rxenable(DWT_START_RX_IMMEDIATE | DWT_NO_SYNC_PTRS);
+
+    if (cb_data->status & SYS_STATUS_RXOVRR)
+    {
+        rx_overrun = true;
+    }
+
+    // datalength包含2字节CRC，需要减去CRC长度得到实际数据长度
+    uint16_t frame_len = cb_data->datalength;
+    if (frame_len < 2 || frame_len > FRAME_LEN_MAX)
+    {
+        return;
+    }
+
+    uwb_rx_msg_t rx_msg;
+    rx_msg.buf = PktBuf_Alloc(0);
+    if (rx_msg.buf == NULL)
+    {
+        elog_rl_w(TAG, "Packet buffer pool empty, dropping %d bytes", frame_len - 2);
+        return;
+    }
+
+    // 直接读入缓冲块，只保留用户数据，不包含CRC
+    dwt_readrxdata(rx_msg.buf->data, frame_len - 2, 0);
+    rx_msg.buf->len = frame_len - 2;
+    rx_msg.timestamp = osKernelGetTickCount();
+    rx_msg.status_reg = cb_data->status;
+
+    // 如果有回调函数，调用它
+    if (uwb_rx_callback != NULL)
+    {
+        uwb_rx_callback(&rx_msg);
+    }
+
+    // 将数据放入接收队列，队列满时释放缓冲块
+    if (osMessageQueuePut(uwb_rxQueue, &rx_msg, 0, 0) != osOK)
+    {
+        PktBuf_Release(rx_msg.buf);
+    }
+}
+
+static void uwb_rx_err_cb(const dwt_cb_data_t *cb_data)
+{
+    // dwt_isr已关闭并复位接收器，重新启动接收（同步双缓冲指针）
+    dwt_rxenable(DWT_START_RX_IMMEDIATE);
+}
+
+static void uwb_tx_done_cb(const dwt_cb_data_t *cb_data)
+{
+    tx_busy = false;
+    // 发送完成后重新启动接收
+    dwt_rxenable(DWT_START_RX_IMMEDIATE);
+}
+
+// 发送一条队列消息，数据帧在TX完成回调中恢复接收
+static void uwb_handle_tx_msg(const uwb_tx_msg_t &tx_msg)
+{
+    static constexpr const char TAG[] = "uwb_comm";
+
+    switch (tx_msg.type)
+    {
+    case UWB_MSG_TYPE_SEND_DATA:
+        dwt_forcetrxoff(); // 保证发送前DW1000已空闲
+
+        // 发送UWB数据
+        // DW1000会自动添加2字节CRC，所以实际写入的数据长度是用户数据长度
+        // 但是dwt_writetxfctrl需要包含CRC的总长度
+        dwt_writetxdata(tx_msg.buf->len + 2, tx_msg.buf->data, 0);
+        dwt_writetxfctrl(tx_msg.buf->len + 2, 0, 1);
+        tx_busy = true;
+        tx_start_tick = osKernelGetTickCount();
+        // PLEN1024/850K时最大帧约12ms，固定的短超时会在发送过程中误判中断丢失
+        tx_timeout_ms = (uwb_tx_airtime_us(tx_msg.buf->len + 2) + 999U) / 1000U + UWB_TX_DONE_MARGIN_MS;
+        if (dwt_starttx(DWT_START_TX_IMMEDIATE) != DWT_SUCCESS)
+        {
+            tx_busy = false;
+            dwt_rxenable(DWT_START_RX_IMMEDIATE);
+            elog_e(TAG, "dwt_starttx failed");
+        }
+        PktBuf_Release(tx_msg.buf);
+        // elog_i(TAG, "Sent %d bytes done", tx_msg.buf->len);
+        break;
+
+    case UWB_MSG_TYPE_CONFIG:
+        // 重新配置DW1000
+        dwt_forcetrxoff();
+        dwt_configure(&config);
+        dwt_rxenable(DWT_START_RX_IMMEDIATE);
+        elog_i(TAG, "Config updated");
+        break;
+
+    case UWB_MSG_TYPE_SET_MODE:
+        // 设置工作模式（预留接口）
+        elog_i(TAG, "Mode set");
+        break;
+
+    default:
+        break;
+    }
+}
+
 // UWB通信任务
 static void uwb_comm_task(void *argument)
 {
-    static const char *TAG = "uwb_comm";
+    static constexpr const char TAG[] = "uwb_comm";
     uwb_tx_msg_t tx_msg;
-    uwb_rx_msg_t rx_msg;
 
-    // 初始化DW1000
+    // 初始化DW1000，openspi为大块收发准备SPI DMA
+    if (openspi() != 0)
+    {
+        elog_w(TAG, "SPI DMA init failed, using polled SPI");
+    }
     reset_DW1000();
     port_set_dw1000_slowrate();
     if (dwt_initialise(DWT_LOADNONE) == DWT_ERROR)
@@ -91,121 +263,121 @@ static void uwb_comm_task(void *argument)
     // uint32_t device_id = dwt_readdevid();
     // elog_i(TAG, "device_id: %08X", device_id);
 
+    // 中断驱动：收发事件由dwt_isr分发到回调，接收使用双缓冲
+    setup_DW1000IRQ();
+    dwt_setcallbacks(uwb_tx_done_cb, uwb_rx_ok_cb, uwb_rx_err_cb, uwb_rx_err_cb);
+    dwt_setinterrupt(DWT_INT_TFRS | DWT_INT_RFCG | DWT_INT_RPHE | DWT_INT_RFCE | DWT_INT_RFSL | DWT_INT_RFTO |
+                         DWT_INT_RXPTO | DWT_INT_SFDT | DWT_INT_ARFE,
+                     1);
+    dwt_setdblrxbuffmode(1);
+    port_set_deca_isr(uwb_deca_irq_notify);
+
     // 启动接收模式
     dwt_rxenable(DWT_START_RX_IMMEDIATE);
 
     while (1)
     {
-        // 等待发送信号量，确保队列中有完整的数据
-        if (osSemaphoreAcquire(uwb_txSemaphore, 0) == osOK)
+        // 发送进行中时限时等待，以便TX完成中断丢失时恢复
+        uint32_t flags = osThreadFlagsWait(UWB_EVT_IRQ | UWB_EVT_TX, osFlagsWaitAny,
+                                           tx_busy ? tx_timeout_ms : osWaitForever);
+
+        if (!(flags & osFlagsError) && (flags & UWB_EVT_IRQ))
         {
-            // 从队列获取发送消息
-            if (osMessageQueueGet(uwb_txQueue, &tx_msg, NULL, 0) == osOK)
+            // 处理所有挂起事件直到IRQ线释放，再重新打开中断
+            while (port_CheckEXT_IRQ() != 0)
             {
-                switch (tx_msg.type)
-                {
-                case UWB_MSG_TYPE_SEND_DATA:
-                    dwt_forcetrxoff(); // 保证发送前DW1000已空闲
-
-                    // 发送UWB数据
-                    // DW1000会自动添加2字节CRC，所以实际写入的数据长度是用户数据长度
-                    // 但是dwt_writetxfctrl需要包含CRC的总长度
-                    dwt_writetxdata(tx_msg.data_len + 2, tx_msg.data, 0);
-                    dwt_writetxfctrl(tx_msg.data_len + 2, 0, 1);
-                    dwt_starttx(DWT_START_TX_IMMEDIATE);
-
-                    // 等待发送完成
-                    while (!(dwt_read32bitreg(SYS_STATUS_ID) & SYS_STATUS_TXFRS))
-                    {
-                        osDelay(1);
-                    }
-                    dwt_write32bitreg(SYS_STATUS_ID, SYS_STATUS_TXFRS);
-
-                    // 发送完成后重新启动接收
-                    dwt_rxenable(DWT_START_RX_IMMEDIATE);
-
-                    // elog_i(TAG, "Sent %d bytes done", tx_msg.data_len);
-                    break;
-
-                case UWB_MSG_TYPE_CONFIG:
-                    // 重新配置DW1000
-                    dwt_configure(&config);
-                    dwt_rxenable(DWT_START_RX_IMMEDIATE);
-                    elog_i(TAG, "Config updated");
-                    break;
-
-                case UWB_MSG_TYPE_SET_MODE:
-                    // 设置工作模式（预留接口）
-                    elog_i(TAG, "Mode set");
-                    break;
+                dwt_isr();
+            }
+            port_EnableEXT_IRQ();
 
-                default:
-                    break;
-                }
+            if (rx_overrun)
+            {
+                rx_overrun = false;
+                dwt_forcetrxoff();
+                dwt_rxreset();
+                dwt_rxenable(DWT_START_RX_IMMEDIATE);
+                elog_rl_w(TAG, "RX double buffer overrun");
             }
         }
 
-        // 检查是否有接收数据
-        status_reg = dwt_read32bitreg(SYS_STATUS_ID);
-        if (status_reg & (SYS_STATUS_RXFCG | SYS_STATUS_ALL_RX_ERR))
+        if (tx_busy && osKernelGetTickCount() - tx_start_tick > tx_timeout_ms)
         {
-            // elog_i(TAG, "status_reg: %08X", status_reg);
-            if (status_reg & SYS_STATUS_RXFCG)
-            {
-                // 成功接收到数据
-                frame_len = dwt_read32bitreg(RX_FINFO_ID) & RX_FINFO_RXFL_MASK_1023;
-                // elog_i(TAG, "frame_len: %d", frame_len);
+            tx_busy = false;
+            dwt_rxenable(DWT_START_RX_IMMEDIATE);
+            elog_rl_w(TAG, "TX done interrupt lost (%lu ms)", (unsigned long)tx_timeout_ms);
+        }
 
-                // frame_len包含2字节CRC，需要减去CRC长度得到实际数据长度
-                if (frame_len >= 2 && frame_len <= FRAME_LEN_MAX)
-                {
-                    dwt_readrxdata(rx_buffer, frame_len, 0);
+        // 一次只发送一帧，TX完成回调后再取下一帧
+        if (!tx_busy && osSemaphoreAcquire(uwb_txSemaphore, 0) == osOK)
+        {
+            if (osMessageQueueGet(uwb_txQueue, &tx_msg, NULL, 0) == osOK)
+            {
+                uwb_handle_tx_msg(tx_msg);
+            }
+            // 队列中还有消息时继续处理
+            if (osMessageQueueGetCount(uwb_txQueue) > 0)
+            {
+                osThreadFlagsSet(uwbCommTaskHandle, UWB_EVT_TX);
+            }
+        }
+    }
+}
+#elif UWB_CHIP_TYPE_CX310
 
-                    // 构造接收消息，只包含用户数据，不包含CRC
-                    rx_msg.data_len = frame_len - 2; // 减去2字节CRC
-                    for (int i = 0; i < rx_msg.data_len; i++)
-                    {
-                        rx_msg.data[i] = rx_buffer[i];
-                    }
-                    rx_msg.timestamp = osKernelGetTickCount();
-                    rx_msg.status_reg = status_reg;
+#define UWB_TX_DELAY_MS 0
+#define UWB_TX_AGGREGATION 1 // 多帧聚合：将队列中的多个协议帧拼接到一个cx_app_data_tx载荷中
 
-                    // 将数据放入接收队列
-                    osMessageQueuePut(uwb_rxQueue, &rx_msg, 0, 0);
+// 处理非数据类消息
+static void uwb_handle_ctrl_msg(CX310<CX310_SlaveSpiAdapter> &uwb, const uwb_tx_msg_t &msg)
+{
+    static constexpr const char TAG[] = "uwb_comm";
 
-                    // 如果有回调函数，调用它
-                    if (uwb_rx_callback != NULL)
-                    {
-                        uwb_rx_callback(&rx_msg);
-                    }
+    switch (msg.type)
+    {
+    case UWB_MSG_TYPE_SET_CHANNEL:
+        // 设置UWB信道
+        {
+            uint8_t channel = msg.param;
+            elog_i(TAG, "Setting UWB channel to %d", channel);
+            bool queued = uwb.set_channel_async(channel, [channel](bool ok) {
+                if (ok)
+                {
+                    elog_i(TAG, "UWB channel set to %d successfully", channel);
                 }
-
-                // 清除接收完成标志
-                dwt_write32bitreg(SYS_STATUS_ID, SYS_STATUS_RXFCG);
+                else
+                {
+                    elog_e(TAG, "Failed to set UWB channel to %d", channel);
+                }
+            });
+            if (!queued)
+            {
+                // 芯片未就绪或命令队列已满，信道未改变，接收模式保持不变
+                elog_e(TAG, "Failed to queue UWB channel %d (cmd pending %u)", channel,
+                       (unsigned)uwb.cmd_pending());
+                break;
             }
-            else
+            // 重新启动接收模式
+            if (!uwb.set_recv_mode_async())
             {
-                // 接收错误
-                dwt_write32bitreg(SYS_STATUS_ID, SYS_STATUS_ALL_RX_ERR);
-                elog_e(TAG, "RX error: %08X", status_reg);
+                elog_e(TAG, "Failed to queue UWB recv mode after channel %d", channel);
             }
-
-            // 重新启动接收
-            dwt_rxenable(DWT_START_RX_IMMEDIATE);
         }
+        break;
+    case UWB_MSG_TYPE_CONFIG:
+    case UWB_MSG_TYPE_SET_MODE:
+    default:
+        elog_w(TAG, "Unhandled message type: %d", msg.type);
+        break;
     }
 }
-#elif UWB_CHIP_TYPE_CX310
-
-#define UWB_TX_DELAY_MS 0
-#define UWB_TX_INTERVAL_MS 10 // 从队列提取数据的时间间隔
 
 static void uwb_comm_task(void *argument)
 {
-    static const char *TAG = "uwb_comm";
+    static constexpr const char TAG[] = "uwb_comm";
 
     auto tx_msg = std::make_unique<uwb_tx_msg_t>();
-    auto rx_msg = std::make_unique<uwb_rx_msg_t>();
+    uwb_rx_msg_t rx_msg;
+    bool tx_msg_pending = false; // tx_msg中有已出队但未放入载荷的消息
 
     // 在堆上创建CX310对象，避免栈溢出
     auto uwb = std::make_unique<CX310<CX310_SlaveSpiAdapter>>();
@@ -213,6 +385,8 @@ static void uwb_comm_task(void *argument)
     g_uwb_adapter = &uwb->get_interface();
 
     std::vector<uint8_t> buffer = {0};
+    std::vector<uint8_t> tx_data;
+    tx_data.reserve(CX_APP_DATA_TX_MAX_PAYLOAD_LEN);
 
     if (uwb->init())
     {
@@ -221,75 +395,64 @@ static void uwb_comm_task(void *argument)
     osDelay(3);
     uwb->set_recv_mode();
 
-    // 记录上次从队列提取数据的时间
-    uint32_t last_tx_check_time = osKernelGetTickCount();
-
     for (;;)
     {
-        // 检查是否到了从队列提取数据的时间间隔（10ms）
-        uint32_t current_time = osKernelGetTickCount();
-        uint32_t elapsed_time = current_time - last_tx_check_time;
-
-        // 如果已经过了10ms，尝试从队列提取数据（非阻塞）
-        if (elapsed_time >= UWB_TX_INTERVAL_MS)
+        // 上一帧收到TX完成通知后再取下一批数据，发送节奏跟随芯片而非固定定时器
+        if (uwb->is_tx_idle() && uwb->cmd_free() >= 2)
         {
-            // 等待发送信号量，确保队列中有完整的数据（非阻塞）
-            if (osSemaphoreAcquire(uwb_txSemaphore, 0) == osOK)
+            tx_data.clear();
+            for (;;)
             {
-                // 从队列获取发送消息（非阻塞）
-                if (osMessageQueueGet(uwb_txQueue, tx_msg.get(), NULL, 0) == osOK)
+                if (!tx_msg_pending)
                 {
-                    switch (tx_msg->type)
+                    // 等待发送信号量，确保队列中有完整的数据（非阻塞）
+                    if (osSemaphoreAcquire(uwb_txSemaphore, 0) != osOK)
                     {
-                    case UWB_MSG_TYPE_SEND_DATA:
-                        // 发送UWB数据
-                        {
-                            std::vector<uint8_t> tx_data(tx_msg->data, tx_msg->data + tx_msg->data_len);
-                            elog_i(TAG, "tx begin");
-                            uwb->update();
-                            uwb->data_transmit(tx_data);
-                            // 发送完成后重新启动接收
-                            // uwb.set_recv_mode();
-                        }
-                        break;
-                    case UWB_MSG_TYPE_SET_CHANNEL:
-                        // 设置UWB信道
-                        if (tx_msg->data_len >= 1)
-                        {
-                            uint8_t channel = tx_msg->data[0];
-                            elog_i(TAG, "Setting UWB channel to %d", channel);
-                            uwb->update();
-                            if (uwb->set_channel(channel))
-                            {
-                                elog_i(TAG, "UWB channel set to %d successfully", channel);
-                            }
-                            else
-                            {
-                                elog_e(TAG, "Failed to set UWB channel to %d", channel);
-                            }
-                            // 重新启动接收模式
-                            uwb->set_recv_mode();
-                        }
                         break;
-                    case UWB_MSG_TYPE_CONFIG:
-                    case UWB_MSG_TYPE_SET_MODE:
-                    default:
-                        elog_w(TAG, "Unhandled message type: %d", tx_msg->type);
+                    }
+                    if (osMessageQueueGet(uwb_txQueue, tx_msg.get(), NULL, 0) != osOK)
+                    {
                         break;
                     }
-                    // 更新上次提取数据的时间
-                    last_tx_check_time = current_time;
+                    tx_msg_pending = true;
                 }
-                else
+
+                if (tx_msg->type != UWB_MSG_TYPE_SEND_DATA)
+                {
+                    // 控制消息保持顺序：先发出已聚合的数据
+                    if (tx_data.empty())
+                    {
+                        uwb_handle_ctrl_msg(*uwb, *tx_msg);
+                        tx_msg_pending = false;
+                    }
+                    break;
+                }
+
+                // 载荷装不下时留到下一批
+                if (!tx_data.empty() && tx_data.size() + tx_msg->buf->len > CX_APP_DATA_TX_MAX_PAYLOAD_LEN)
                 {
-                    // 队列为空，但已经过了时间间隔，更新检查时间
-                    last_tx_check_time = current_time;
+                    break;
                 }
+                tx_data.insert(tx_data.end(), tx_msg->buf->data, tx_msg->buf->data + tx_msg->buf->len);
+                PktBuf_Release(tx_msg->buf);
+                tx_msg_pending = false;
+#if !UWB_TX_AGGREGATION
+                break;
+#endif
             }
-            else
+
+            if (!tx_data.empty())
             {
-                // 没有信号量，但已经过了时间间隔，更新检查时间
-                last_tx_check_time = current_time;
+                // 发送UWB数据，命令入队后立即返回，等待RSP期间继续处理接收
+                if (!uwb->data_transmit_async(tx_data, [](bool ok) {
+                        if (!ok)
+                        {
+                            elog_rl_e(TAG, "data transmit fail");
+                        }
+                    }))
+                {
+                    elog_rl_e(TAG, "data transmit enqueue fail");
+                }
             }
         }
 
@@ -297,7 +460,7 @@ static void uwb_comm_task(void *argument)
         if (uwb->get_recv_data(buffer))
         {
             // uwb->set_recv_mode();
-            elog_i(TAG, "uwb rx size: %d", buffer.size());
+            elog_bin_i(TAG, "uwb rx size: %d", buffer.size());
 
             // 获取当前时间戳和状态
             uint32_t timestamp = osKernelGetTickCount();
@@ -313,32 +476,40 @@ static void uwb_comm_task(void *argument)
             {
                 // 计算本次要复制的数据长度
                 size_t chunk_size = (total_bytes - offset > FRAME_LEN_MAX) ? FRAME_LEN_MAX : (total_bytes - offset);
-                rx_msg->data_len = chunk_size;
-
-                // 复制数据到消息缓冲区
-                for (size_t i = 0; i < chunk_size; i++)
-                {
-                    rx_msg->data[i] = buffer[offset + i];
-                }
-
-                // 设置消息的时间戳和状态寄存器
-                rx_msg->timestamp = timestamp;
-                rx_msg->status_reg = status_reg;
 
-                // 将数据放入接收队列
-                if (osMessageQueuePut(uwb_rxQueue, rx_msg.get(), 0, 0) != osOK)
+                rx_msg.buf = PktBuf_Alloc(0);
+                if (rx_msg.buf == NULL)
                 {
-                    elog_w(TAG, "UWB RX queue full, dropping chunk %d (%d bytes)", chunk_count + 1, chunk_size);
+                    elog_rl_w(TAG, "Packet buffer pool empty, dropping chunk %d (%d bytes)", chunk_count + 1,
+                              chunk_size);
                     failed_chunks++;
                 }
                 else
                 {
-                    elog_v(TAG, "UWB chunk %d queued successfully (%d bytes)", chunk_count + 1, chunk_size);
+                    // 复制数据到缓冲块
+                    memcpy(rx_msg.buf->data, buffer.data() + offset, chunk_size);
+                    rx_msg.buf->len = chunk_size;
+
+                    // 设置消息的时间戳和状态寄存器
+                    rx_msg.timestamp = timestamp;
+                    rx_msg.status_reg = status_reg;
 
                     // 如果有回调函数，调用它
                     if (uwb_rx_callback != NULL)
                     {
-                        uwb_rx_callback(rx_msg.get());
+                        uwb_rx_callback(&rx_msg);
+                    }
+
+                    // 将数据放入接收队列
+                    if (osMessageQueuePut(uwb_rxQueue, &rx_msg, 0, 0) != osOK)
+                    {
+                        elog_rl_w(TAG, "UWB RX queue full, dropping chunk %d (%d bytes)", chunk_count + 1, chunk_size);
+                        PktBuf_Release(rx_msg.buf);
+                        failed_chunks++;
+                    }
+                    else
+                    {
+                        elog_v(TAG, "UWB chunk %d queued successfully (%d bytes)", chunk_count + 1, chunk_size);
                     }
                 }
 
@@ -359,22 +530,119 @@ static void uwb_comm_task(void *argument)
         osDelay(1);
     }
 }
+#elif UWB_CHIP_TYPE_HOST
+
+// 本机构建：没有射频芯片，发送数据交给发送钩子，接收数据由UWB_Host_InjectRx注入
+static void (*volatile uwb_host_tx_hook)(const uint8_t *data, uint16_t len) = NULL;
+
+static void uwb_comm_task(void *argument)
+{
+    static constexpr const char TAG[] = "uwb_comm";
+
+    uwb_tx_msg_t tx_msg;
+
+    for (;;)
+    {
+        // 本机没有TX完成节奏，直接阻塞在发送信号量上
+        if (osSemaphoreAcquire(uwb_txSemaphore, osWaitForever) != osOK)
+        {
+            continue;
+        }
+        if (osMessageQueueGet(uwb_txQueue, &tx_msg, NULL, 0) != osOK)
+        {
+            continue;
+        }
+
+        if (tx_msg.type == UWB_MSG_TYPE_SEND_DATA)
+        {
+            auto hook = uwb_host_tx_hook;
+            if (hook != NULL)
+            {
+                hook(tx_msg.buf->data, tx_msg.buf->len);
+            }
+            PktBuf_Release(tx_msg.buf);
+        }
+        else
+        {
+            elog_i(TAG, "Control message %d (param %d) ignored on host", tx_msg.type, tx_msg.param);
+        }
+    }
+}
+
+void UWB_Host_SetTxHook(void (*hook)(const uint8_t *data, uint16_t len))
+{
+    uwb_host_tx_hook = hook;
+}
+
+int UWB_Host_InjectRx(const uint8_t *data, uint16_t len)
+{
+    static constexpr const char TAG[] = "uwb_comm";
+
+    uwb_rx_msg_t rx_msg;
+    uint32_t timestamp = osKernelGetTickCount();
+    int failed_chunks = 0;
+
+    if (data == NULL || len == 0)
+    {
+        return -1;
+    }
+
+    // 与CX310分支相同：超过FRAME_LEN_MAX的数据分块放入接收队列
+    for (uint16_t offset = 0; offset < len;)
+    {
+        uint16_t chunk_size = (len - offset > FRAME_LEN_MAX) ? FRAME_LEN_MAX : (len - offset);
+
+        rx_msg.buf = PktBuf_Alloc(0);
+        if (rx_msg.buf == NULL)
+        {
+            elog_rl_w(TAG, "Packet buffer pool empty, dropping %d bytes", chunk_size);
+            failed_chunks++;
+        }
+        else
+        {
+            memcpy(rx_msg.buf->data, data + offset, chunk_size);
+            rx_msg.buf->len = chunk_size;
+            rx_msg.timestamp = timestamp;
+            rx_msg.status_reg = 0;
+
+            if (uwb_rx_callback != NULL)
+            {
+                uwb_rx_callback(&rx_msg);
+            }
+
+            if (osMessageQueuePut(uwb_rxQueue, &rx_msg, 0, 0) != osOK)
+            {
+                elog_rl_w(TAG, "UWB RX queue full, dropping %d bytes", chunk_size);
+                PktBuf_Release(rx_msg.buf);
+                failed_chunks++;
+            }
+        }
+        offset += chunk_size;
+    }
+
+    return failed_chunks ? -3 : 0;
+}
 #endif
 
+RTOS_STATIC_QUEUE(uwb_txQueue, TX_QUEUE_SIZE, sizeof(uwb_tx_msg_t))
+RTOS_STATIC_QUEUE(uwb_rxQueue, RX_QUEUE_SIZE, sizeof(uwb_rx_msg_t))
+RTOS_STATIC_SEMAPHORE(uwb_txSemaphore)
+RTOS_STATIC_THREAD(uwbCommTask, 8 * 1024)
+
 // 初始化UWB通信任务
 void UWB_Task_Init(void)
 {
-    static const char *TAG = "uwb_init";
+    static constexpr const char TAG[] = "uwb_init";
 
     // 创建消息队列
-    uwb_txQueue = osMessageQueueNew(TX_QUEUE_SIZE, sizeof(uwb_tx_msg_t), NULL);
+    uwb_txQueue = osMessageQueueNew(TX_QUEUE_SIZE, sizeof(uwb_tx_msg_t), RTOS_STATIC_ATTR(uwb_txQueue));
     if (uwb_txQueue == NULL)
     {
         elog_e(TAG, "Failed to create UWB TX queue");
         return;
     }
 
-    uwb_rxQueue = osMessageQueueNew(RX_QUEUE_SIZE, sizeof(uwb_rx_msg_t), NULL);
+    uwb_rxQueue = osMessageQueueNew(RX_QUEUE_SIZE, sizeof(uwb_rx_msg_t), RTOS_STATIC_ATTR(uwb_rxQueue));
     if (uwb_rxQueue == NULL)
     {
         elog_e(TAG, "Failed to create UWB RX queue");
@@ -382,7 +650,7 @@ void UWB_Task_Init(void)
     }
 
     // 创建发送信号量（计数信号量，初始值为0）
-    uwb_txSemaphore = osSemaphoreNew(TX_QUEUE_SIZE, 0, NULL);
+    uwb_txSemaphore = osSemaphoreNew(TX_QUEUE_SIZE, 0, RTOS_STATIC_ATTR(uwb_txSemaphore));
     if (uwb_txSemaphore == NULL)
     {
         elog_e(TAG, "Failed to create UWB TX semaphore");
@@ -391,6 +659,7 @@ void UWB_Task_Init(void)
     // 创建UWB通信任务
     const osThreadAttr_t uwbTask_attributes = {
         .name = "uwbCommTask",
+        RTOS_STATIC_THREAD_ATTR(uwbCommTask)
         .stack_size = 8 * 1024,
         .priority = (osPriority_t)osPriorityRealtime7, // 最高优先级
     };
@@ -406,6 +675,15 @@ void UWB_Task_Init(void)
     }
 }
 
+// 消息放入发送队列后，释放信号量并唤醒通信任务
+static void uwb_notify_tx(void)
+{
+    osSemaphoreRelease(uwb_txSemaphore);
+#if UWB_CHIP_TYPE_DW1000
+    osThreadFlagsSet(uwbCommTaskHandle, UWB_EVT_TX);
+#endif
+}
+
 // API函数：发送UWB数据
 int UWB_SendData(const uint8_t *data, uint16_t len, uint32_t delay_ms)
 {
@@ -414,25 +692,44 @@ int UWB_SendData(const uint8_t *data, uint16_t len, uint32_t delay_ms)
         return -1;
     }
 
-    uwb_tx_msg_t msg;
-    msg.type = UWB_MSG_TYPE_SEND_DATA;
-    msg.data_len = len;
-    msg.delay_ms = delay_ms;
+    pkt_buf_t *buf = PktBuf_Alloc(0);
+    if (buf == NULL)
+    {
+        return -3; // 缓冲池耗尽
+    }
 
-    // 复制数据到消息结构体
-    for (uint16_t i = 0; i < len; i++)
+    // 复制数据到缓冲块，之后各级队列只传递句柄
+    memcpy(buf->data, data, len);
+    buf->len = len;
+
+    int ret = UWB_SendBuf(buf, delay_ms);
+    PktBuf_Release(buf);
+    return ret;
+}
+
+// API函数：发送缓冲块中的UWB数据（零拷贝）
+int UWB_SendBuf(pkt_buf_t *buf, uint32_t delay_ms)
+{
+    if (buf == NULL || buf->len == 0 || buf->len > FRAME_LEN_MAX)
     {
-        msg.data[i] = data[i];
+        return -1;
     }
 
+    uwb_tx_msg_t msg;
+    msg.type = UWB_MSG_TYPE_SEND_DATA;
+    msg.buf = PktBuf_Ref(buf);
+    msg.param = 0;
+    msg.delay_ms = delay_ms;
+
     // 发送到队列
     if (osMessageQueuePut(uwb_txQueue, &msg, 0, 100) != osOK)
     {
+        PktBuf_Release(buf);
         return -3; // 队列满或超时
     }
 
     // 队列数据放入成功后，释放信号量通知通信任务
-    osSemaphoreRelease(uwb_txSemaphore);
+    uwb_notify_tx();
 
     return 0; // 成功
 }
@@ -477,6 +774,7 @@ void UWB_ClearTxQueue(void)
     while (osMessageQueueGet(uwb_txQueue, &msg, NULL, 0) == osOK)
     {
         // 清空队列
+        PktBuf_Release(msg.buf);
     }
 }
 
@@ -486,6 +784,7 @@ void UWB_ClearRxQueue(void)
     while (osMessageQueueGet(uwb_rxQueue, &msg, NULL, 0) == osOK)
     {
         // 清空队列
+        PktBuf_Release(msg.buf);
     }
 }
 
@@ -494,7 +793,9 @@ int UWB_Reconfigure(void)
 {
     uwb_tx_msg_t msg;
     msg.type = UWB_MSG_TYPE_CONFIG;
-    msg.data_len = 0;
+    msg.buf = NULL;
+    msg.param = 0;
+    msg.delay_ms = 0;
 
     if (osMessageQueuePut(uwb_txQueue, &msg, 0, 100) != osOK)
     {
@@ -502,7 +803,7 @@ int UWB_Reconfigure(void)
     }
 
     // 配置消息放入队列后，释放信号量通知通信任务
-    osSemaphoreRelease(uwb_txSemaphore);
+    uwb_notify_tx();
 
     return 0; // 成功
 }
@@ -518,8 +819,8 @@ int UWB_SetChannel(uint8_t channel)
 
     uwb_tx_msg_t msg;
     msg.type = UWB_MSG_TYPE_SET_CHANNEL;
-    msg.data_len = 1;
-    msg.data[0] = channel;
+    msg.buf = NULL;
+    msg.param = channel;
     msg.delay_ms = 0;
 
     if (osMessageQueuePut(uwb_txQueue, &msg, 0, 100) != osOK)
@@ -528,7 +829,7 @@ int UWB_SetChannel(uint8_t channel)
     }
 
     // 配置消息放入队列后，释放信号量通知通信任务
-    osSemaphoreRelease(uwb_txSemaphore);
+    uwb_notify_tx();
 
     return 0; // 成功
 }
\ No newline at end of file
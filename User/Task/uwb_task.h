@@ -1,6 +1,7 @@
 #ifndef UWB_TASK_H
 #define UWB_TASK_H
 
+#include "pkt_buf.h"
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -10,11 +11,11 @@ extern "C"
 
 #define FRAME_LEN_MAX 1016
 
-    // UWB接收消息结构体
+    // UWB接收消息结构体，数据位于buf中，buf->len为数据长度
+    // 通过UWB_ReceiveData取得后由调用者负责PktBuf_Release(msg.buf)
     typedef struct
     {
-        uint16_t data_len;
-        uint8_t data[FRAME_LEN_MAX];
+        pkt_buf_t *buf;
         uint32_t timestamp;  // 接收时间戳
         uint32_t status_reg; // 状态寄存器值
     } uwb_rx_msg_t;
@@ -30,13 +31,18 @@ extern "C"
     // 返回：0 - 成功, -1 - 参数错误, -3 - 队列满或超时
     int UWB_SendData(const uint8_t *data, uint16_t len, uint32_t delay_ms);
 
+    // API函数：发送缓冲块中的UWB数据（零拷贝），函数内部增加一次引用，调用者仍需释放自己的引用
+    // 参数：buf - 缓冲块句柄, delay_ms - 发送延迟时间（毫秒）
+    // 返回：0 - 成功, -1 - 参数错误, -3 - 队列满或超时
+    int UWB_SendBuf(pkt_buf_t *buf, uint32_t delay_ms);
+
     // API函数：接收UWB数据（非阻塞）
     // 参数：msg - 接收消息缓冲区, timeout_ms - 超时时间（毫秒）
     // 返回：0 - 成功, -1 - 超时或错误
     int UWB_ReceiveData(uwb_rx_msg_t *msg, uint32_t timeout_ms);
 
     // API函数：设置接收回调函数
-    // 参数：callback - 回调函数指针，当接收到数据时自动调用
+    // 参数：callback - 回调函数指针，当接收到数据时自动调用，回调中不得释放msg->buf
     void UWB_SetRxCallback(uwb_rx_callback_t callback);
 
     // API函数：获取队列状态
@@ -56,6 +62,15 @@ extern "C"
     // 返回：0 - 成功, -1 - 参数错误, -2 - 设置失败
     int UWB_SetChannel(uint8_t channel);
 
+#if UWB_CHIP_TYPE_HOST
+    // 本机构建：设置发送钩子，在UWB任务中以每个待发送的数据帧调用，NULL表示丢弃
+    void UWB_Host_SetTxHook(void (*hook)(const uint8_t *data, uint16_t len));
+
+    // 本机构建：模拟射频接收，数据按FRAME_LEN_MAX分块放入接收队列，可在任意线程调用
+    // 返回：0 - 成功, -1 - 参数错误, -3 - 缓冲池耗尽或队列满（部分数据被丢弃）
+    int UWB_Host_InjectRx(const uint8_t *data, uint16_t len);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,190 @@
+/**
+ * @file block_pool.c
+ * @brief Size-class block allocator used by the C++ new/delete operators
+ *
+ * Every class is a lock-free stack of free block indexes. The head holds a
+ * 16-bit ABA tag and the 1-based index of the top block, the free block itself
+ * stores the index of the next one, so push and pop are a single CAS.
+ */
+
+#include "block_pool.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdbool.h>
+
+#define HEAD_INDEX(head) ((head) & 0xFFFFUL)
+#define HEAD_MAKE(head, index) ((((head) + 0x10000UL) & 0xFFFF0000UL) | (index))
+
+typedef struct
+{
+    uint16_t block_size;
+    uint16_t block_count;
+    uint8_t *base;
+    volatile uint32_t head; // ABA标记(高16位) | 栈顶块序号+1(低16位)，0表示空
+    volatile uint16_t in_use;
+    volatile uint16_t peak;
+    volatile uint32_t allocs;
+    volatile uint32_t fallbacks;
+} block_class_t;
+
+#define BLOCK_CLASS_INIT(size, count) {size, count, NULL, 0, 0, 0, 0, 0},
+static block_class_t classes[] = {BLOCK_POOL_CLASSES(BLOCK_CLASS_INIT)};
+
+#define CLASS_COUNT (sizeof(classes) / sizeof(classes[0]))
+#define BLOCK_CLASS_BYTES(size, count) +((size) * (count))
+#define ARENA_SIZE (0 BLOCK_POOL_CLASSES(BLOCK_CLASS_BYTES))
+
+static uint8_t *arena;
+static volatile uint8_t initState; // 0 - 未初始化, 1 - 已划分, 2 - 划分失败
+static volatile uint32_t oversizeCount;
+
+static uint16_t *block_next(block_class_t *cls, uint32_t index)
+{
+    return (uint16_t *)(cls->base + (index - 1) * cls->block_size);
+}
+
+int BlockPool_Init(void)
+{
+    if (initState != 0)
+    {
+        return initState == 1 ? 0 : -1;
+    }
+
+    // 调度器启动前后都可能是第一次分配，挂起调度器保证只划分一次
+    vTaskSuspendAll();
+    if (initState == 0)
+    {
+        arena = (uint8_t *)pvPortMalloc(ARENA_SIZE);
+        if (arena == NULL)
+        {
+            initState = 2;
+        }
+        else
+        {
+            uint8_t *base = arena;
+            for (uint32_t i = 0; i < CLASS_COUNT; i++)
+            {
+                block_class_t *cls = &classes[i];
+                cls->base = base;
+                // 所有块串成空闲链，序号从1开始
+                for (uint32_t index = 1; index <= cls->block_count; index++)
+                {
+                    *block_next(cls, index) = (index < cls->block_count) ? (uint16_t)(index + 1) : 0;
+                }
+                cls->head = cls->block_count ? 1 : 0;
+                base += (uint32_t)cls->block_size * cls->block_count;
+            }
+            __atomic_store_n(&initState, 1, __ATOMIC_RELEASE);
+        }
+    }
+    (void)xTaskResumeAll();
+
+    return initState == 1 ? 0 : -1;
+}
+
+void *BlockPool_Alloc(size_t size)
+{
+    if (__atomic_load_n(&initState, __ATOMIC_ACQUIRE) != 1 && BlockPool_Init() != 0)
+    {
+        return pvPortMalloc(size);
+    }
+
+    for (uint32_t i = 0; i < CLASS_COUNT; i++)
+    {
+        block_class_t *cls = &classes[i];
+        if (size > cls->block_size)
+        {
+            continue;
+        }
+
+        uint32_t head = __atomic_load_n(&cls->head, __ATOMIC_ACQUIRE);
+        while (HEAD_INDEX(head) != 0)
+        {
+            // 读到的next可能已被其他任务改写，此时ABA标记已变化，CAS必然失败
+            uint32_t next = *block_next(cls, HEAD_INDEX(head));
+            if (__atomic_compare_exchange_n(&cls->head, &head, HEAD_MAKE(head, next), true, __ATOMIC_ACQUIRE,
+                                            __ATOMIC_ACQUIRE))
+            {
+                uint16_t inUse = __atomic_add_fetch(&cls->in_use, 1, __ATOMIC_RELAXED);
+                // CAS取最大值，并发分配时较小的值不会覆盖较大的值
+                uint16_t peak = __atomic_load_n(&cls->peak, __ATOMIC_RELAXED);
+                while (inUse > peak && !__atomic_compare_exchange_n(&cls->peak, &peak, inUse, true,
+                                                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                {
+                }
+                __atomic_add_fetch(&cls->allocs, 1, __ATOMIC_RELAXED);
+                return block_next(cls, HEAD_INDEX(head));
+            }
+        }
+
+        // 本等级耗尽，交给heap_4
+        __atomic_add_fetch(&cls->fallbacks, 1, __ATOMIC_RELAXED);
+        return pvPortMalloc(size);
+    }
+
+    __atomic_add_fetch(&oversizeCount, 1, __ATOMIC_RELAXED);
+    return pvPortMalloc(size);
+}
+
+void BlockPool_Free(void *ptr)
+{
+    uint8_t *p = (uint8_t *)ptr;
+    if (p == NULL)
+    {
+        return;
+    }
+
+    if (arena == NULL || p < arena || p >= arena + ARENA_SIZE)
+    {
+        vPortFree(ptr);
+        return;
+    }
+
+    for (uint32_t i = CLASS_COUNT; i-- > 0;)
+    {
+        block_class_t *cls = &classes[i];
+        if (p < cls->base)
+        {
+            continue;
+        }
+
+        uint32_t index = (uint32_t)(p - cls->base) / cls->block_size + 1;
+        // 先减计数再入栈，in_use不会超过块数量
+        __atomic_sub_fetch(&cls->in_use, 1, __ATOMIC_RELAXED);
+        uint32_t head = __atomic_load_n(&cls->head, __ATOMIC_RELAXED);
+        do
+        {
+            *block_next(cls, index) = (uint16_t)HEAD_INDEX(head);
+        } while (!__atomic_compare_exchange_n(&cls->head, &head, HEAD_MAKE(head, index), true, __ATOMIC_RELEASE,
+                                              __ATOMIC_RELAXED));
+        return;
+    }
+}
+
+uint32_t BlockPool_GetClassCount(void)
+{
+    return CLASS_COUNT;
+}
+
+int BlockPool_GetStats(uint32_t index, block_pool_stats_t *stats)
+{
+    if (index >= CLASS_COUNT || stats == NULL)
+    {
+        return -1;
+    }
+
+    const block_class_t *cls = &classes[index];
+    stats->block_size = cls->block_size;
+    stats->block_count = cls->block_count;
+    stats->in_use = cls->in_use;
+    stats->peak = cls->peak;
+    stats->allocs = cls->allocs;
+    stats->fallbacks = cls->fallbacks;
+    return 0;
+}
+
+uint32_t BlockPool_GetOversizeCount(void)
+{
+    return oversizeCount;
+}
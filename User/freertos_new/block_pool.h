@@ -0,0 +1,68 @@
+/**
+ * @file block_pool.h
+ * @brief Size-class block allocator used by the C++ new/delete operators
+ *
+ * Small allocations are served from fixed-size block free lists carved out of
+ * the FreeRTOS heap once at boot. Allocation and release are O(1) and lock-free,
+ * so short-lived protocol objects no longer fragment heap_4. Requests larger than
+ * the biggest class, or made while their class is exhausted, fall back to
+ * pvPortMalloc.
+ */
+
+#ifndef BLOCK_POOL_H
+#define BLOCK_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// 尺寸等级：块大小 x 块数量，总计约56KB
+#define BLOCK_POOL_CLASSES(X) \
+    X(16, 256)                \
+    X(32, 256)                \
+    X(64, 128)                \
+    X(128, 64)                \
+    X(256, 32)                \
+    X(512, 16)                \
+    X(1024, 8)
+
+    // 单个尺寸等级的统计计数
+    typedef struct
+    {
+        uint16_t block_size;  // 块大小
+        uint16_t block_count; // 块数量
+        uint16_t in_use;      // 当前使用数量
+        uint16_t peak;        // 历史最大使用数量
+        uint32_t allocs;      // 累计分配次数
+        uint32_t fallbacks;   // 本等级耗尽后转由heap_4分配的次数
+    } block_pool_stats_t;
+
+    // 从FreeRTOS堆划分各等级的块，首次分配时自动调用
+    // 返回：0 - 成功, -1 - 堆空间不足（此后所有分配都走heap_4）
+    int BlockPool_Init(void);
+
+    // 分配至少size字节，失败返回NULL
+    void *BlockPool_Alloc(size_t size);
+
+    // 释放BlockPool_Alloc返回的内存，ptr可以为NULL
+    void BlockPool_Free(void *ptr);
+
+    // 尺寸等级数量
+    uint32_t BlockPool_GetClassCount(void);
+
+    // 获取指定等级的统计计数
+    // 返回：0 - 成功, -1 - 等级无效
+    int BlockPool_GetStats(uint32_t index, block_pool_stats_t *stats);
+
+    // 超过最大等级直接由heap_4分配的次数
+    uint32_t BlockPool_GetOversizeCount(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BLOCK_POOL_H
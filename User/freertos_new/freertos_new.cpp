@@ -2,6 +2,8 @@
  * @file freertos_new.cpp
  * @brief Implementation of C++ new/delete operators using FreeRTOS memory management
  *
+ * Small objects come from the size-class pools of block_pool.c, larger ones from pvPortMalloc.
+ *
  * Note: This implementation does not throw exceptions, suitable for embedded systems.
  * All new operators return nullptr on allocation failure.
  */
@@ -10,92 +12,121 @@
 
 #ifdef __cplusplus
 
-#include "FreeRTOS.h"
+#include "block_pool.h"
+#include "heap_prof.h"
 #include <cstdlib>
 #include <new>
 
 /**
- * @brief Override global operator new to use FreeRTOS pvPortMalloc
+ * @brief Allocate for operator new, with a profiling header in HEAP_PROFILE builds
+ *
+ * @param size Size requested by the caller
+ * @param site Return address of operator new, i.e. the allocation call site
+ */
+static inline void *new_alloc(std::size_t size, void *site)
+{
+#if HEAP_PROFILE
+    auto *hdr = static_cast<heap_prof_hdr_t *>(BlockPool_Alloc(size + sizeof(heap_prof_hdr_t)));
+    if (hdr == nullptr)
+    {
+        return nullptr;
+    }
+    HeapProf_OnNew(hdr, size, site);
+    return hdr + 1;
+#else
+    (void)site;
+    return BlockPool_Alloc(size);
+#endif
+}
+
+/**
+ * @brief Release memory returned by new_alloc
+ */
+static inline void new_free(void *ptr)
+{
+#if HEAP_PROFILE
+    if (ptr == nullptr)
+    {
+        return;
+    }
+    auto *hdr = static_cast<heap_prof_hdr_t *>(ptr) - 1;
+    HeapProf_OnDelete(hdr);
+    BlockPool_Free(hdr);
+#else
+    BlockPool_Free(ptr);
+#endif
+}
+
+/**
+ * @brief Override global operator new to use the size-class block pools
  *
  * Note: Returns nullptr on failure (no exceptions thrown, suitable for embedded systems)
  */
 void *operator new(std::size_t size)
 {
-    return pvPortMalloc(size);
+    return new_alloc(size, __builtin_return_address(0));
 }
 
 /**
- * @brief Override global operator new[] to use FreeRTOS pvPortMalloc
+ * @brief Override global operator new[] to use the size-class block pools
  *
  * Note: Returns nullptr on failure (no exceptions thrown, suitable for embedded systems)
  */
 void *operator new[](std::size_t size)
 {
-    return pvPortMalloc(size);
+    return new_alloc(size, __builtin_return_address(0));
 }
 
 /**
- * @brief Override global operator new (nothrow version) to use FreeRTOS pvPortMalloc
+ * @brief Override global operator new (nothrow version) to use the size-class block pools
  */
 void *operator new(std::size_t size, const std::nothrow_t &nothrow_tag) noexcept
 {
     (void)nothrow_tag; // Unused parameter
-    return pvPortMalloc(size);
+    return new_alloc(size, __builtin_return_address(0));
 }
 
 /**
- * @brief Override global operator new[] (nothrow version) to use FreeRTOS pvPortMalloc
+ * @brief Override global operator new[] (nothrow version) to use the size-class block pools
  */
 void *operator new[](std::size_t size, const std::nothrow_t &nothrow_tag) noexcept
 {
     (void)nothrow_tag; // Unused parameter
-    return pvPortMalloc(size);
+    return new_alloc(size, __builtin_return_address(0));
 }
 
 /**
- * @brief Override global operator delete to use FreeRTOS vPortFree
+ * @brief Override global operator delete to use the size-class block pools
  */
 void operator delete(void *ptr) noexcept
 {
-    if (ptr != nullptr)
-    {
-        vPortFree(ptr);
-    }
+    new_free(ptr);
 }
 
 /**
- * @brief Override global operator delete[] to use FreeRTOS vPortFree
+ * @brief Override global operator delete[] to use the size-class block pools
  */
 void operator delete[](void *ptr) noexcept
 {
-    if (ptr != nullptr)
-    {
-        vPortFree(ptr);
-    }
+    new_free(ptr);
 }
 
 /**
- * @brief Override global operator delete (size version) to use FreeRTOS vPortFree
+ * @brief Override global operator delete (size version) to use the size-class block pools
  */
 void operator delete(void *ptr, std::size_t size) noexcept
 {
-    (void)size; // Unused parameter, FreeRTOS doesn't need size for deallocation
-    if (ptr != nullptr)
-    {
-        vPortFree(ptr);
-    }
+    (void)size; // Unused parameter, the block class is found by address
+    new_free(ptr);
 }
 
 /**
- * @brief Override global operator delete[] (size version) to use FreeRTOS vPortFree
+ * @brief Override global operator delete[] (size version) to use the size-class block pools
  */
 void operator delete[](void *ptr, std::size_t size) noexcept
 {
-    (void)size; // Unused parameter, FreeRTOS doesn't need size for deallocation
-    if (ptr != nullptr)
-    {
-        vPortFree(ptr);
-    }
+    (void)size; // Unused parameter, the block class is found by address
+    new_free(ptr);
 }
 
 #endif // __cplusplus
@@ -2,9 +2,11 @@
  * @file freertos_new.h
  * @brief C++ new/delete operators overridden to use FreeRTOS memory management
  *
- * This file provides global operator new/delete overloads that use FreeRTOS
- * heap management functions (pvPortMalloc/vPortFree) instead of the standard
- * C++ library memory management.
+ * This file provides global operator new/delete overloads that replace the
+ * standard C++ library memory management. Small objects are served in O(1)
+ * from the size-class pools of block_pool.h; requests larger than the biggest
+ * class, or made while their class is exhausted, fall back to the heap_4
+ * pvPortMalloc/vPortFree.
  *
  * Usage: Simply include this header file in your main source file or in a
  * common header that is included early in the compilation.
@@ -19,16 +21,17 @@
 #include <new>
 
 /**
- * @brief Override global operator new to use FreeRTOS pvPortMalloc
+ * @brief Override global operator new to use the size-class block pools
  *
  * @param size Size of memory to allocate in bytes
  * @return Pointer to allocated memory, or nullptr if allocation fails
- * @note Does not throw exceptions (suitable for embedded systems)
+ * @note Does not throw exceptions (suitable for embedded systems). Sizes above
+ *       the largest block class, or an exhausted class, go to pvPortMalloc.
  */
 void *operator new(std::size_t size);
 
 /**
- * @brief Override global operator new[] to use FreeRTOS pvPortMalloc
+ * @brief Override global operator new[] to use the size-class block pools
  *
  * @param size Size of memory to allocate in bytes
  * @return Pointer to allocated memory, or nullptr if allocation fails
@@ -37,7 +40,7 @@ void *operator new(std::size_t size);
 void *operator new[](std::size_t size);
 
 /**
- * @brief Override global operator new (nothrow version) to use FreeRTOS pvPortMalloc
+ * @brief Override global operator new (nothrow version) to use the size-class block pools
  *
  * @param size Size of memory to allocate in bytes
  * @param nothrow_tag std::nothrow tag
@@ -46,7 +49,7 @@ void *operator new[](std::size_t size);
 void *operator new(std::size_t size, const std::nothrow_t &nothrow_tag) noexcept;
 
 /**
- * @brief Override global operator new[] (nothrow version) to use FreeRTOS pvPortMalloc
+ * @brief Override global operator new[] (nothrow version) to use the size-class block pools
  *
  * @param size Size of memory to allocate in bytes
  * @param nothrow_tag std::nothrow tag
@@ -55,21 +58,23 @@ void *operator new(std::size_t size, const std::nothrow_t &nothrow_tag) noexcept
 void *operator new[](std::size_t size, const std::nothrow_t &nothrow_tag) noexcept;
 
 /**
- * @brief Override global operator delete to use FreeRTOS vPortFree
+ * @brief Override global operator delete to use the size-class block pools
  *
  * @param ptr Pointer to memory to deallocate
+ * @note Pool blocks are recognised by address and returned to their class,
+ *       anything else goes to vPortFree.
  */
 void operator delete(void *ptr) noexcept;
 
 /**
- * @brief Override global operator delete[] to use FreeRTOS vPortFree
+ * @brief Override global operator delete[] to use the size-class block pools
  *
  * @param ptr Pointer to memory to deallocate
  */
 void operator delete[](void *ptr) noexcept;
 
 /**
- * @brief Override global operator delete (size version) to use FreeRTOS vPortFree
+ * @brief Override global operator delete (size version) to use the size-class block pools
  *
  * @param ptr Pointer to memory to deallocate
  * @param size Size of memory block (unused, kept for compatibility)
@@ -77,7 +82,7 @@ void operator delete[](void *ptr) noexcept;
 void operator delete(void *ptr, std::size_t size) noexcept;
 
 /**
- * @brief Override global operator delete[] (size version) to use FreeRTOS vPortFree
+ * @brief Override global operator delete[] (size version) to use the size-class block pools
  *
  * @param ptr Pointer to memory to deallocate
  * @param size Size of memory block (unused, kept for compatibility)
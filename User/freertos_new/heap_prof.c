@@ -0,0 +1,251 @@
+/**
+ * @file heap_prof.c
+ * @brief Heap allocation profiler (CMake HEAP_PROFILE)
+ *
+ * All tables are updated with atomics only, the hooks run inside operator new,
+ * and inside heap_4 with the scheduler suspended.
+ */
+
+#include "heap_prof.h"
+
+#if HEAP_PROFILE
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "elog.h"
+#include "task.h"
+
+#define HEAP_PROF_MAGIC 0xA7
+
+typedef struct
+{
+    volatile uint32_t addr; // 返回地址，0表示空闲
+    volatile uint32_t samples;
+    volatile uint32_t bytes;
+} heap_prof_site_t;
+
+static heap_prof_task_t tasks[HEAP_PROF_MAX_TASKS];
+static volatile uint32_t hist[HEAP_PROF_HIST_BUCKETS];
+static heap_prof_site_t sites[HEAP_PROF_SITES];
+static volatile uint32_t sampleTick;
+static volatile uint32_t siteOverflow; // 调用点表已满丢弃的采样数
+static volatile uint32_t heapFrees;
+static volatile uint32_t heapFreeBytes;
+
+// 查找或登记当前任务，表满时合并到最后一项
+static uint32_t prof_task_slot(void)
+{
+    void *self = NULL;
+    if (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)
+    {
+        self = xTaskGetCurrentTaskHandle();
+    }
+
+    // 第0项固定为调度器启动前
+    if (self == NULL)
+    {
+        return 0;
+    }
+
+    for (uint32_t i = 1; i < HEAP_PROF_MAX_TASKS; i++)
+    {
+        void *owner = __atomic_load_n(&tasks[i].task, __ATOMIC_ACQUIRE);
+        if (owner == self)
+        {
+            return i;
+        }
+        if (owner == NULL)
+        {
+            void *expected = NULL;
+            if (__atomic_compare_exchange_n(&tasks[i].task, &expected, self, false, __ATOMIC_ACQ_REL,
+                                            __ATOMIC_ACQUIRE))
+            {
+                strncpy(tasks[i].name, pcTaskGetName((TaskHandle_t)self), HEAP_PROF_NAME_LEN - 1);
+                return i;
+            }
+            if (expected == self)
+            {
+                return i;
+            }
+        }
+    }
+    return HEAP_PROF_MAX_TASKS - 1;
+}
+
+static uint32_t prof_hist_bucket(size_t size)
+{
+    uint32_t bucket = 0;
+    size_t limit = 16;
+    while (size > limit && bucket < HEAP_PROF_HIST_BUCKETS - 1)
+    {
+        limit <<= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+static void prof_record_site(void *site, size_t size)
+{
+    uint32_t addr = (uint32_t)(uintptr_t)site;
+    uint32_t start = (addr >> 1) % HEAP_PROF_SITES;
+
+    for (uint32_t n = 0; n < HEAP_PROF_SITES; n++)
+    {
+        heap_prof_site_t *entry = &sites[(start + n) % HEAP_PROF_SITES];
+        uint32_t cur = __atomic_load_n(&entry->addr, __ATOMIC_RELAXED);
+        if (cur == 0)
+        {
+            uint32_t expected = 0;
+            if (__atomic_compare_exchange_n(&entry->addr, &expected, addr, false, __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED))
+            {
+                cur = addr;
+            }
+            else
+            {
+                cur = expected;
+            }
+        }
+        if (cur == addr)
+        {
+            __atomic_add_fetch(&entry->samples, 1, __ATOMIC_RELAXED);
+            __atomic_add_fetch(&entry->bytes, size, __ATOMIC_RELAXED);
+            return;
+        }
+    }
+    __atomic_add_fetch(&siteOverflow, 1, __ATOMIC_RELAXED);
+}
+
+void HeapProf_OnNew(heap_prof_hdr_t *hdr, size_t size, void *site)
+{
+    uint32_t slot = prof_task_slot();
+    heap_prof_task_t *t = &tasks[slot];
+
+    hdr->size = size;
+    hdr->task = (uint8_t)slot;
+    hdr->magic = HEAP_PROF_MAGIC;
+
+    __atomic_add_fetch(&t->news, 1, __ATOMIC_RELAXED);
+    uint32_t outstanding = __atomic_add_fetch(&t->outstanding, size, __ATOMIC_RELAXED);
+    // 最后一项由超出数量的任务共用，CAS取最大值，避免并发时较小的值覆盖较大的值
+    uint32_t peak = __atomic_load_n(&t->peak, __ATOMIC_RELAXED);
+    while (outstanding > peak && !__atomic_compare_exchange_n(&t->peak, &peak, outstanding, true,
+                                                              __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+    __atomic_add_fetch(&hist[prof_hist_bucket(size)], 1, __ATOMIC_RELAXED);
+
+    if (__atomic_add_fetch(&sampleTick, 1, __ATOMIC_RELAXED) % HEAP_PROF_SAMPLE_EVERY == 0)
+    {
+        prof_record_site(site, size);
+    }
+}
+
+void HeapProf_OnDelete(heap_prof_hdr_t *hdr)
+{
+    if (hdr->magic != HEAP_PROF_MAGIC || hdr->task >= HEAP_PROF_MAX_TASKS)
+    {
+        return;
+    }
+    heap_prof_task_t *t = &tasks[hdr->task];
+    __atomic_add_fetch(&t->deletes, 1, __ATOMIC_RELAXED);
+    __atomic_sub_fetch(&t->outstanding, hdr->size, __ATOMIC_RELAXED);
+    hdr->magic = 0;
+}
+
+void HeapProf_OnMalloc(void *ptr, size_t size)
+{
+    if (ptr == NULL)
+    {
+        return;
+    }
+    heap_prof_task_t *t = &tasks[prof_task_slot()];
+    __atomic_add_fetch(&t->heap_allocs, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&t->heap_bytes, size, __ATOMIC_RELAXED);
+}
+
+void HeapProf_OnFree(void *ptr, size_t size)
+{
+    (void)ptr;
+    __atomic_add_fetch(&heapFrees, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&heapFreeBytes, size, __ATOMIC_RELAXED);
+}
+
+int HeapProf_GetTask(uint32_t index, heap_prof_task_t *stats)
+{
+    if (index >= HEAP_PROF_MAX_TASKS || stats == NULL || (index > 0 && tasks[index].task == NULL))
+    {
+        return -1;
+    }
+    *stats = tasks[index];
+    if (index == 0)
+    {
+        strcpy(stats->name, "<boot>");
+    }
+    return 0;
+}
+
+void HeapProf_Report(void)
+{
+    heap_prof_task_t t;
+    heap_prof_site_t top[HEAP_PROF_TOP_SITES];
+    uint32_t topCount = 0;
+
+    elog_i("HeapProf", "=== Heap Profile ===");
+    for (uint32_t i = 0; i < HEAP_PROF_MAX_TASKS; i++)
+    {
+        if (HeapProf_GetTask(i, &t) == 0 && (t.news || t.heap_allocs))
+        {
+            elog_i("HeapProf", "%-16s new %lu delete %lu outstanding %lu (peak %lu) heap %lu/%lu bytes", t.name,
+                   (unsigned long)t.news, (unsigned long)t.deletes, (unsigned long)t.outstanding,
+                   (unsigned long)t.peak, (unsigned long)t.heap_allocs, (unsigned long)t.heap_bytes);
+        }
+    }
+    elog_i("HeapProf", "heap frees %lu/%lu bytes", (unsigned long)heapFrees, (unsigned long)heapFreeBytes);
+
+    for (uint32_t b = 0; b < HEAP_PROF_HIST_BUCKETS; b++)
+    {
+        if (hist[b])
+        {
+            elog_i("HeapProf", "size %s%5lu: %lu", b == HEAP_PROF_HIST_BUCKETS - 1 ? ">" : "<=",
+                   (unsigned long)(16UL << (b == HEAP_PROF_HIST_BUCKETS - 1 ? b - 1 : b)), (unsigned long)hist[b]);
+        }
+    }
+
+    // 按采样次数选出前几个调用点
+    for (uint32_t i = 0; i < HEAP_PROF_SITES; i++)
+    {
+        heap_prof_site_t s = {sites[i].addr, sites[i].samples, sites[i].bytes};
+        if (s.addr == 0)
+        {
+            continue;
+        }
+        uint32_t pos = topCount < HEAP_PROF_TOP_SITES ? topCount++ : HEAP_PROF_TOP_SITES;
+        while (pos > 0 && top[pos - 1].samples < s.samples)
+        {
+            if (pos < HEAP_PROF_TOP_SITES)
+            {
+                top[pos] = top[pos - 1];
+            }
+            pos--;
+        }
+        if (pos < HEAP_PROF_TOP_SITES)
+        {
+            top[pos] = s;
+        }
+    }
+    for (uint32_t i = 0; i < topCount; i++)
+    {
+        // 地址用addr2line -e firmware.elf解析，计数为采样值，实际约乘以HEAP_PROF_SAMPLE_EVERY
+        elog_i("HeapProf", "site 0x%08lx: %lu samples, %lu bytes", (unsigned long)top[i].addr,
+               (unsigned long)top[i].samples, (unsigned long)top[i].bytes);
+    }
+    if (siteOverflow)
+    {
+        elog_i("HeapProf", "site table full, %lu samples dropped", (unsigned long)siteOverflow);
+    }
+}
+
+#endif // HEAP_PROFILE
@@ -0,0 +1,71 @@
+/**
+ * @file heap_prof.h
+ * @brief Heap allocation profiler (CMake HEAP_PROFILE)
+ *
+ * C++ new/delete carry a small header with the owner task and size, so the
+ * outstanding bytes of every task are exact. Every allocation also feeds a
+ * size histogram, every HEAP_PROF_SAMPLE_EVERY-th one records its call site.
+ * The heap_4 trace hooks count the raw pvPortMalloc/vPortFree traffic per task.
+ */
+
+#ifndef HEAP_PROF_H
+#define HEAP_PROF_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#if HEAP_PROFILE
+
+#define HEAP_PROF_MAX_TASKS 16     // 统计的任务数量，超出的任务合并到最后一项
+#define HEAP_PROF_SITES 32         // 调用点表大小
+#define HEAP_PROF_SAMPLE_EVERY 8   // 每N次分配采样一次调用点
+#define HEAP_PROF_TOP_SITES 8      // 报告中输出的调用点数量
+#define HEAP_PROF_HIST_BUCKETS 9   // 尺寸直方图：<=16, 32, ... 2048, >2048
+#define HEAP_PROF_NAME_LEN 16      // 与configMAX_TASK_NAME_LEN一致
+
+    // new返回的内存之前的头部，保持8字节对齐
+    typedef struct
+    {
+        uint32_t size;     // 申请大小
+        uint8_t task;      // 分配任务在统计表中的序号
+        uint8_t magic;     // HEAP_PROF_MAGIC
+        uint16_t reserved;
+    } heap_prof_hdr_t;
+
+    // 单个任务的统计
+    typedef struct
+    {
+        void *task;                          // 任务句柄，NULL表示调度器启动前
+        char name[HEAP_PROF_NAME_LEN];       // 任务名
+        uint32_t news;                       // new次数
+        uint32_t deletes;                    // 释放本任务分配内存的次数
+        uint32_t outstanding;                // 尚未释放的字节数
+        uint32_t peak;                       // 尚未释放字节数的峰值
+        uint32_t heap_allocs;                // 本任务调用pvPortMalloc的次数
+        uint32_t heap_bytes;                 // 本任务通过pvPortMalloc申请的总字节数
+    } heap_prof_task_t;
+
+    // new调用：hdr为实际分配的内存，size为用户申请大小，site为调用点返回地址
+    void HeapProf_OnNew(heap_prof_hdr_t *hdr, size_t size, void *site);
+
+    // delete调用：hdr为实际分配的内存
+    void HeapProf_OnDelete(heap_prof_hdr_t *hdr);
+
+    // 获取任务统计，返回：0 - 成功, -1 - 序号无效或未使用
+    int HeapProf_GetTask(uint32_t index, heap_prof_task_t *stats);
+
+    // 通过elog输出统计报告（UART，以及注册的网络日志采集端）
+    void HeapProf_Report(void);
+
+#endif // HEAP_PROFILE
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HEAP_PROF_H
@@ -0,0 +1,159 @@
+#include "cycle_prof.hpp"
+
+#if CYCLE_PROFILE
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "elog.h"
+#include "task.h"
+
+typedef struct
+{
+    const char *name;
+    uint16_t budget_permille; // 占TDMA时隙间隔的千分比
+} cycle_prof_probe_t;
+
+// 顺序与CycleProfId一致；一个时隙内UWB接收、帧提取与透传需依次完成，单项预算留出余量
+static const cycle_prof_probe_t probes[CYCLE_PROF_COUNT] = {
+    {"processFrame", 100},
+    {"slaveFrames", 300},
+    {"backendFrames", 200},
+    {"buildSync", 500},
+    {"uwbSpiTx", 100},
+    {"uwbSpiRx", 100},
+};
+
+static cycle_prof_stats_t stats[CYCLE_PROF_COUNT];
+static uint32_t budget[CYCLE_PROF_COUNT];
+static uint32_t slotUs;
+
+void CycleProf_Init(void)
+{
+#if defined(__arm__)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    CycleProf_Reset();
+}
+
+uint32_t CycleProf_GetClockHz(void)
+{
+#if defined(__arm__)
+    return SystemCoreClock;
+#else
+    return 1000000000U;
+#endif
+}
+
+void CycleProf_Record(CycleProfId id, uint32_t cycles)
+{
+    if (id >= CYCLE_PROF_COUNT)
+    {
+        return;
+    }
+
+    uint32_t bucket = cycles > 1 ? 31U - (uint32_t)__builtin_clz(cycles) : 0;
+    if (bucket >= CYCLE_PROF_HIST_BUCKETS)
+    {
+        bucket = CYCLE_PROF_HIST_BUCKETS - 1;
+    }
+
+    // 同一探针可能在多个任务中执行（processFrame），更新放在临界区内，只有十几条指令
+    cycle_prof_stats_t *s = &stats[id];
+    taskENTER_CRITICAL();
+    if (s->count == 0 || cycles < s->min)
+    {
+        s->min = cycles;
+    }
+    if (cycles > s->max)
+    {
+        s->max = cycles;
+    }
+    s->count++;
+    s->total += cycles;
+    s->hist[bucket]++;
+    if (budget[id] != 0 && cycles > budget[id])
+    {
+        s->over_budget++;
+    }
+    taskEXIT_CRITICAL();
+}
+
+void CycleProf_SetSlotUs(uint32_t us)
+{
+    if (us == slotUs)
+    {
+        return;
+    }
+
+    uint64_t slotCycles = (uint64_t)us * CycleProf_GetClockHz() / 1000000U;
+    for (uint32_t i = 0; i < CYCLE_PROF_COUNT; i++)
+    {
+        uint64_t cycles = slotCycles * probes[i].budget_permille / 1000U;
+        budget[i] = cycles > UINT32_MAX ? UINT32_MAX : (uint32_t)cycles;
+    }
+    slotUs = us;
+}
+
+int CycleProf_Get(CycleProfId id, cycle_prof_stats_t *out, int reset)
+{
+    if (id >= CYCLE_PROF_COUNT || out == NULL)
+    {
+        return -1;
+    }
+
+    taskENTER_CRITICAL();
+    *out = stats[id];
+    if (reset)
+    {
+        memset(&stats[id], 0, sizeof(stats[id]));
+    }
+    taskEXIT_CRITICAL();
+    return 0;
+}
+
+void CycleProf_Reset(void)
+{
+    taskENTER_CRITICAL();
+    memset(stats, 0, sizeof(stats));
+    taskEXIT_CRITICAL();
+}
+
+const char *CycleProf_GetName(CycleProfId id)
+{
+    return id < CYCLE_PROF_COUNT ? probes[id].name : "";
+}
+
+uint32_t CycleProf_GetBudget(CycleProfId id)
+{
+    return id < CYCLE_PROF_COUNT ? budget[id] : 0;
+}
+
+uint32_t CycleProf_GetSlotUs(void)
+{
+    return slotUs;
+}
+
+void CycleProf_Report(void)
+{
+    uint32_t perUs = CycleProf_GetClockHz() / 1000000U;
+    cycle_prof_stats_t s;
+
+    elog_i("CycleProf", "=== Cycle Profile (slot %lu us, %lu cycles/us) ===", (unsigned long)slotUs,
+           (unsigned long)perUs);
+    for (uint32_t i = 0; i < CYCLE_PROF_COUNT; i++)
+    {
+        if (CycleProf_Get((CycleProfId)i, &s, 0) != 0 || s.count == 0)
+        {
+            continue;
+        }
+        elog_i("CycleProf", "%-14s n %lu avg %lu min %lu max %lu cycles (max %lu us), budget %lu, over %lu",
+               probes[i].name, (unsigned long)s.count, (unsigned long)(s.total / s.count), (unsigned long)s.min,
+               (unsigned long)s.max, (unsigned long)(s.max / perUs), (unsigned long)budget[i],
+               (unsigned long)s.over_budget);
+    }
+}
+
+#endif // CYCLE_PROFILE
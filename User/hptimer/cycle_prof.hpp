@@ -0,0 +1,109 @@
+#pragma once
+
+#include <stdint.h>
+
+// 作用域周期计数（CMake CYCLE_PROFILE）：CYCLE_PROF_SCOPE(id)在作用域结束时把耗时累加到静态统计表，
+// 目标板计数为DWT CYCCNT（内核时钟周期），主机构建为steady_clock纳秒。关闭时宏展开为空，不产生代码
+// 每个探针有一个以TDMA时隙间隔千分比表示的预算，超出预算的次数单独计数，可通过后端CYCLE_PROF_REQ_MSG查询
+
+#define CYCLE_PROF_HIST_BUCKETS 24 // log2直方图：第i项为[2^i, 2^(i+1))个周期，最后一项包含更大的值
+#define CYCLE_PROF_NAME_LEN 16
+
+// 探针编号，名称与预算在cycle_prof.cpp的表中，顺序一致
+enum CycleProfId : uint8_t
+{
+    CYCLE_PROF_PROCESS_FRAME,     // MasterServer::processFrame
+    CYCLE_PROF_SLAVE_FRAMES,      // MasterServer::processSlaveData：帧扫描、透传或解析，含其中的processFrame
+    CYCLE_PROF_BACKEND_FRAMES,    // 后端数据的帧提取与重组（extractCompleteFrames）
+    CYCLE_PROF_BUILD_SYNC,        // MasterServer::buildSlaveConfigsForSync
+    CYCLE_PROF_UWB_SPI_TX,        // CX310 SPI发送
+    CYCLE_PROF_UWB_SPI_RX,        // CX310 SPI接收
+    CYCLE_PROF_COUNT
+};
+
+// 单个探针的统计
+typedef struct
+{
+    uint32_t count;
+    uint32_t over_budget; // 超出预算的次数
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint32_t hist[CYCLE_PROF_HIST_BUCKETS];
+} cycle_prof_stats_t;
+
+#if CYCLE_PROFILE
+
+#if defined(__arm__)
+#include "main.h"
+
+// DWT CYCCNT，需先调用CycleProf_Init使能
+static inline uint32_t CycleProf_Now(void)
+{
+    return DWT->CYCCNT;
+}
+#else
+#include <chrono>
+
+static inline uint32_t CycleProf_Now(void)
+{
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+#endif
+
+// 使能计数器（目标板DWT）并清零统计，在创建使用探针的任务前调用；主机构建可不调用
+void CycleProf_Init(void);
+
+// 累加一次测量，可在任意任务中调用，不可在中断中调用
+void CycleProf_Record(CycleProfId id, uint32_t cycles);
+
+// 设置TDMA时隙间隔，各探针预算按其千分比重新计算
+void CycleProf_SetSlotUs(uint32_t slotUs);
+
+// 读取统计，reset非0时读取后清零
+// 返回：0 - 成功, -1 - 编号无效
+int CycleProf_Get(CycleProfId id, cycle_prof_stats_t *stats, int reset);
+
+// 清零全部统计
+void CycleProf_Reset(void);
+
+const char *CycleProf_GetName(CycleProfId id);
+uint32_t CycleProf_GetBudget(CycleProfId id); // 当前预算（周期），时隙间隔未设置时为0
+uint32_t CycleProf_GetSlotUs(void);
+uint32_t CycleProf_GetClockHz(void); // 计数频率
+
+// 通过elog输出统计报告
+void CycleProf_Report(void);
+
+// 作用域探针，析构时记录
+class CycleProfScope
+{
+  public:
+    explicit CycleProfScope(CycleProfId id) : id(id), start(CycleProf_Now())
+    {
+    }
+    ~CycleProfScope()
+    {
+        CycleProf_Record(id, CycleProf_Now() - start);
+    }
+    CycleProfScope(const CycleProfScope &) = delete;
+    CycleProfScope &operator=(const CycleProfScope &) = delete;
+
+  private:
+    CycleProfId id;
+    uint32_t start;
+};
+
+#define CYCLE_PROF_CONCAT_(a, b) a##b
+#define CYCLE_PROF_CONCAT(a, b) CYCLE_PROF_CONCAT_(a, b)
+#define CYCLE_PROF_SCOPE(id) CycleProfScope CYCLE_PROF_CONCAT(cycleProfScope_, __LINE__)(id)
+#define CYCLE_PROF_SET_SLOT_US(us) CycleProf_SetSlotUs(us)
+
+#else
+
+#define CYCLE_PROF_SCOPE(id) ((void)0)
+#define CYCLE_PROF_SET_SLOT_US(us) ((void)0)
+
+#endif // CYCLE_PROFILE
@@ -1,3 +1,4 @@
+#ifndef HPTIMER_FAKE_COUNTER
 #include "tim.h"
 
 #ifdef __cplusplus
@@ -6,30 +7,110 @@ extern "C"
 #endif
 
 #include "FreeRTOS.h"
-#include "hptimer.hpp"
 #include "task.h"
 
 #ifdef __cplusplus
 }
 #endif
+#endif
+
+#include "hptimer.hpp"
+
+#ifdef HPTIMER_FAKE_COUNTER
+// 主机测试：计数器与溢出标志由测试代码提供，溢出处理由测试代码调用 hal_hptimer_overflow_isr()
+extern "C" uint32_t hptimer_fake_counter(void);
+extern "C" bool hptimer_fake_overflow_pending(void);
+extern "C" void hptimer_fake_clear_overflow(void);
+#define HPTIMER_HW_COUNTER() hptimer_fake_counter()
+#define HPTIMER_HW_OVERFLOW_PENDING() hptimer_fake_overflow_pending()
+#define HPTIMER_HW_CLEAR_OVERFLOW() hptimer_fake_clear_overflow()
+#define taskYIELD()
+#else
+#define HPTIMER_HW_COUNTER() __HAL_TIM_GET_COUNTER(&htim2)
+#define HPTIMER_HW_OVERFLOW_PENDING() (__HAL_TIM_GET_FLAG(&htim2, TIM_FLAG_UPDATE) != RESET)
+#define HPTIMER_HW_CLEAR_OVERFLOW() __HAL_TIM_CLEAR_FLAG(&htim2, TIM_FLAG_UPDATE)
+#endif
+
+// 单核 Cortex-M4 上只需阻止编译器重排
+#define HPTIMER_BARRIER() __asm volatile("" ::: "memory")
 
 static volatile bool s_initialized = false;
 
+// TIM2 溢出次数（64 位时间的高 32 位），只在溢出中断中修改
+// s_seq 为奇数表示正在更新，读者需重试
+static volatile uint32_t s_seq = 0;
+static volatile uint32_t s_epoch = 0;
+
 static uint32_t hal_hptimer_get_us(void)
 {
-    return __HAL_TIM_GET_COUNTER(&htim2);
+    return HPTIMER_HW_COUNTER();
 }
 
+void hal_hptimer_init(void)
+{
+#ifndef HPTIMER_FAKE_COUNTER
+    // HAL_TIM_Base_Init 产生的 UG 事件会置位 UIF，启动前清除
+    __HAL_TIM_SET_COUNTER(&htim2, 0);
+    HPTIMER_HW_CLEAR_OVERFLOW();
+    // 最高优先级：读者不会抢占正在更新的写者，seqlock 不会自旋
+    HAL_NVIC_SetPriority(TIM2_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(TIM2_IRQn);
+    HAL_TIM_Base_Start_IT(&htim2);
+#endif
+    s_epoch = 0;
+    s_initialized = true;
+}
+
+void hal_hptimer_overflow_isr(void)
+{
+    if (!HPTIMER_HW_OVERFLOW_PENDING())
+    {
+        return;
+    }
+    s_seq = s_seq + 1;
+    HPTIMER_BARRIER();
+    s_epoch = s_epoch + 1;
+    HPTIMER_HW_CLEAR_OVERFLOW();
+    HPTIMER_BARRIER();
+    s_seq = s_seq + 1;
+}
+
+#ifndef HPTIMER_FAKE_COUNTER
+extern "C" void TIM2_IRQHandler(void)
+{
+    hal_hptimer_overflow_isr();
+}
+#endif
+
 uint32_t hal_hptimer_get_ms(void)
 {
-    return hal_hptimer_get_us64() / 1000;
+    return (uint32_t)(hal_hptimer_get_us64() / 1000ULL);
 }
 
 uint64_t hal_hptimer_get_us64(void)
 {
-    TickType_t tick_count = xTaskGetTickCount(); // FreeRTOS 毫秒
-    uint32_t us_counter = hal_hptimer_get_us();  // 当前微秒（0~999）
-    return (uint64_t)tick_count * 1000ULL + (us_counter % 1000);
+    uint32_t seq;
+    uint32_t epoch;
+    uint32_t counter;
+    bool pending;
+
+    do
+    {
+        seq = s_seq;
+        HPTIMER_BARRIER();
+        epoch = s_epoch;
+        counter = HPTIMER_HW_COUNTER();
+        pending = HPTIMER_HW_OVERFLOW_PENDING();
+        HPTIMER_BARRIER();
+    } while ((seq & 1U) || (seq != s_seq));
+
+    // 已溢出但中断尚未处理（关中断期间或同优先级中断中读取）
+    // 计数器先于标志读取，计数值较小说明读到的是溢出之后的值
+    if (pending && counter < 0x80000000U)
+    {
+        epoch++;
+    }
+    return ((uint64_t)epoch << 32) | counter;
 }
 
 uint32_t hal_hptimer_elapsed_us(uint32_t ref_time)
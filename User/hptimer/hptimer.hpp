@@ -14,6 +14,18 @@ extern "C" {
 //  */
 // uint32_t hal_hptimer_get_us(void);
 
+/**
+ * @brief 初始化高精度定时器：清除溢出标志，开启 TIM2 溢出中断并启动计数
+ * @note 在 MX_TIM2_Init() 之后、调度器启动之前调用
+ */
+void hal_hptimer_init(void);
+
+/**
+ * @brief TIM2 溢出处理，累加 64 位时间的高 32 位
+ * @note 由 TIM2_IRQHandler 调用；主机测试定义 HPTIMER_FAKE_COUNTER 后可直接调用
+ */
+void hal_hptimer_overflow_isr(void);
+
 /**
  * @brief 获取当前时间（单位：毫秒）
  * @return 以毫秒为单位的时间
@@ -22,7 +34,7 @@ uint32_t hal_hptimer_get_ms(void);
 
 /**
  * @brief 获取当前时间（单位：微秒，64位）
- * @return 高精度时间戳（μs），结合 FreeRTOS tick 和定时器
+ * @return 单调递增的时间戳（μs），TIM2 计数值扩展溢出次数，任务与中断中均可调用
  */
 uint64_t hal_hptimer_get_us64(void);
 
@@ -283,6 +283,7 @@ void elog_flush(void);
 void elog_async_enabled(bool enabled);
 size_t elog_async_get_log(char *log, size_t size);
 size_t elog_async_get_line_log(char *log, size_t size);
+uint32_t elog_async_get_drop_count(uint32_t *bytes);
 
 /* elog_utils.c */
 size_t elog_strcpy(size_t cur_len, char *dst, const char *src);
@@ -293,4 +294,9 @@ void *elog_memcpy(void *dst, const void *src, size_t count);
 }
 #endif
 
+/* compile-time per-tag log level filter for C++ */
+#if defined(__cplusplus) && defined(ELOG_OUTPUT_ENABLE) && defined(ELOG_TAG_LVL_ENABLE)
+#include "elog_tag.h"
+#endif
+
 #endif /* __ELOG_H__ */
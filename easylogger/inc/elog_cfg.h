@@ -45,6 +45,8 @@
  #define ELOG_FILTER_KW_MAX_LEN                   16
  /* output filter's tag level max num */
  #define ELOG_FILTER_TAG_LVL_MAX_NUM              5
+ /* enable compile-time per-tag log level filter for C++, levels in elog_tag_cfg.h */
+ #define ELOG_TAG_LVL_ENABLE
  /* output newline sign */
  #define ELOG_NEWLINE_SIGN                        "\r\n"
  /*---------------------------------------------------------------------------*/
@@ -58,17 +60,34 @@
  #define ELOG_COLOR_DEBUG                         (F_GREEN B_NULL S_NORMAL)
  #define ELOG_COLOR_VERBOSE                       (F_BLUE B_NULL S_NORMAL)
  /*---------------------------------------------------------------------------*/
+ /* native builds (port/elog_port_posix.c) output synchronously, without the output task */
+ #ifndef ELOG_PORT_POSIX
  /* enable asynchronous output mode */
  #define ELOG_ASYNC_OUTPUT_ENABLE
  /* the highest output level for async mode, other level will sync output */
- #define ELOG_ASYNC_OUTPUT_LVL                    ELOG_LVL_VERBOSE
+ #define ELOG_ASYNC_OUTPUT_LVL                    ELOG_LVL_ASSERT
  /* buffer size for asynchronous output mode */
  #define ELOG_ASYNC_OUTPUT_BUF_SIZE               (ELOG_LINE_BUF_SIZE * 30)
+ /* placement of the asynchronous output ring buffer, it's only accessed by CPU so keep it in CCM-RAM */
+ #define ELOG_ASYNC_OUTPUT_BUF_ATTR               __attribute__((section(".ccmbss")))
  /* each asynchronous output's log which must end with newline sign */
  #define ELOG_ASYNC_LINE_OUTPUT
  /* asynchronous output mode using POSIX pthread implementation */
  //#define ELOG_ASYNC_OUTPUT_USING_PTHREAD
  /*---------------------------------------------------------------------------*/
+ /* enable binary deferred log mode, see plugins/bin/elog_bin.h */
+ #define ELOG_BIN_ENABLE
+ /* binary log ring size in 32-bit words, must be power of 2 */
+ #define ELOG_BIN_RING_WORDS                      1024
+ /* max delay in ms before binary records are flushed to output */
+ #define ELOG_BIN_FLUSH_MS                        10
+ #endif /* ELOG_PORT_POSIX */
+ /*---------------------------------------------------------------------------*/
+ /* default budget of rate limited log sites, see plugins/ratelimit/elog_rl.h */
+ #define ELOG_RL_BURST                            5
+ /* one more log is allowed every interval */
+ #define ELOG_RL_INTERVAL_MS                      1000
+ /*---------------------------------------------------------------------------*/
  /* enable buffered output mode */
  //#define ELOG_BUF_OUTPUT_ENABLE
  /* buffer size for buffered output mode */
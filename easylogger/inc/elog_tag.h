@@ -0,0 +1,108 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Function: Compile-time per-tag log level filter for C++ translation units.
+ *           The tag of every log site is looked up in the constexpr registry of elog_tag_cfg.h, sites above the
+ *           tag's level are discarded by if constexpr together with their arguments. Enabled sites check a one
+ *           byte runtime level per tag which can be lowered with elog_tag::set_level().
+ *           Tags must be constant expressions: string literals or constexpr char arrays/pointers.
+ */
+
+#ifndef __ELOG_TAG_H__
+#define __ELOG_TAG_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace elog_tag {
+
+struct Entry {
+    const char *tag;
+    uint8_t level;
+};
+
+inline constexpr Entry registry[] = {
+#define ELOG_TAG_ENTRY(tag, level) {tag, level},
+#include "elog_tag_cfg.h"
+#undef ELOG_TAG_ENTRY
+};
+
+inline constexpr size_t count = sizeof(registry) / sizeof(registry[0]);
+
+constexpr bool equal(const char *a, const char *b) {
+    while (*a != '\0' && *a == *b) {
+        ++a;
+        ++b;
+    }
+    return *a == *b;
+}
+
+/* registry index of tag, count for unlisted tags */
+constexpr size_t index(const char *tag) {
+    for (size_t i = 0; i < count; i++) {
+        if (equal(registry[i].tag, tag)) {
+            return i;
+        }
+    }
+    return count;
+}
+
+constexpr uint8_t static_level(size_t idx) {
+    return idx < count ? registry[idx].level : ELOG_OUTPUT_LVL;
+}
+
+/* runtime levels, the last slot is shared by all unlisted tags */
+inline volatile uint8_t runtime_level[count + 1] = {
+#define ELOG_TAG_ENTRY(tag, level) level,
+#include "elog_tag_cfg.h"
+#undef ELOG_TAG_ENTRY
+    ELOG_OUTPUT_LVL};
+
+/**
+ * set runtime level of a tag, levels above the compile-time level of the tag have no effect
+ *
+ * @param tag tag, nullptr for all unlisted tags
+ * @param level level
+ *
+ * @return false if the tag isn't in the registry
+ */
+inline bool set_level(const char *tag, uint8_t level) {
+    if (tag == nullptr) {
+        runtime_level[count] = level;
+        return true;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(registry[i].tag, tag) == 0) {
+            runtime_level[i] = level;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace elog_tag
+
+#define ELOG_TAG_OUTPUT(level, tag, ...)                                                        \
+    do {                                                                                        \
+        constexpr size_t _elog_tag_idx = ::elog_tag::index(tag);                                \
+        if constexpr ((level) <= ::elog_tag::static_level(_elog_tag_idx)) {                     \
+            if ((level) <= ::elog_tag::runtime_level[_elog_tag_idx]) {                          \
+                elog_output(level, tag, ELOG_OUTPUT_DIR, ELOG_OUTPUT_FUNC, ELOG_OUTPUT_LINE,    \
+                            __VA_ARGS__);                                                       \
+            }                                                                                   \
+        }                                                                                       \
+    } while (0)
+
+#undef elog_e
+#undef elog_w
+#undef elog_i
+#undef elog_d
+#undef elog_v
+#define elog_e(tag, ...)     ELOG_TAG_OUTPUT(ELOG_LVL_ERROR, tag, __VA_ARGS__)
+#define elog_w(tag, ...)     ELOG_TAG_OUTPUT(ELOG_LVL_WARN, tag, __VA_ARGS__)
+#define elog_i(tag, ...)     ELOG_TAG_OUTPUT(ELOG_LVL_INFO, tag, __VA_ARGS__)
+#define elog_d(tag, ...)     ELOG_TAG_OUTPUT(ELOG_LVL_DEBUG, tag, __VA_ARGS__)
+#define elog_v(tag, ...)     ELOG_TAG_OUTPUT(ELOG_LVL_VERBOSE, tag, __VA_ARGS__)
+
+#endif /* __ELOG_TAG_H__ */
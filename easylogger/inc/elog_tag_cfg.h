@@ -0,0 +1,18 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Function: Per-tag compile-time log levels, used by elog_tag.h in C++ translation units.
+ *           Log sites of a listed tag above its level are compiled away, unlisted tags use ELOG_OUTPUT_LVL.
+ *           The level may be higher than ELOG_OUTPUT_LVL to enable verbose output for one module only.
+ */
+
+/* ELOG_TAG_ENTRY(tag, compile-time level) */
+ELOG_TAG_ENTRY("ProtocolProcessor",         ELOG_LVL_INFO)
+ELOG_TAG_ENTRY("MasterServer",              ELOG_LVL_DEBUG)
+ELOG_TAG_ENTRY("SlaveDataProcT",            ELOG_LVL_DEBUG)
+ELOG_TAG_ENTRY("BackDataProcT",             ELOG_LVL_DEBUG)
+ELOG_TAG_ENTRY("MainTask",                  ELOG_LVL_DEBUG)
+ELOG_TAG_ENTRY("DeviceManager",             ELOG_LVL_DEBUG)
+ELOG_TAG_ENTRY("CX310",                     ELOG_LVL_DEBUG)
+ELOG_TAG_ENTRY("uwb_comm",                  ELOG_LVL_DEBUG)
+ELOG_TAG_ENTRY("uwb_init",                  ELOG_LVL_DEBUG)
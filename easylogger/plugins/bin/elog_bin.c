@@ -0,0 +1,147 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Function:  Binary deferred log plugin. Multi-producer single-consumer lock-free ring of 32-bit words.
+ *            Producers reserve space with a CAS on the head index and publish the record by writing its header
+ *            word last, the consumer (elog output task) frames committed records for the output port.
+ */
+
+#include <elog_bin.h>
+#include <string.h>
+
+#ifdef ELOG_BIN_ENABLE
+
+#if (ELOG_BIN_RING_WORDS & (ELOG_BIN_RING_WORDS - 1)) != 0
+#error "ELOG_BIN_RING_WORDS must be power of 2"
+#endif
+
+#define RING_MASK                           (ELOG_BIN_RING_WORDS - 1)
+#define HDR_IS_VALID(hdr)                   (((hdr) & 0xFF000000UL) == ELOG_BIN_HDR_MARK)
+#define HDR_NARGS(hdr)                      ((hdr) & 0xFFUL)
+
+/* ring buffer, unused words are always zero so that an uncommitted header reads as invalid */
+static uint32_t ring[ELOG_BIN_RING_WORDS];
+/* free running word indexes */
+static volatile uint32_t ring_head = 0;
+static volatile uint32_t ring_tail = 0;
+/* records dropped because the ring was full */
+static volatile uint32_t drop_count = 0;
+/* drop count already reported in the output stream, only used by consumer */
+static uint32_t drop_reported = 0;
+
+/**
+ * write a binary log record, it's safe to call from any task or interrupt
+ *
+ * @param level level
+ * @param tag tag address, must be a constant string
+ * @param format format string address, must be a string literal
+ * @param args raw arguments
+ * @param nargs arguments number
+ */
+void elog_bin_write(uint8_t level, const char *tag, const char *format, const uint32_t *args, uint8_t nargs) {
+    uint32_t words, head, i;
+
+    if (nargs > ELOG_BIN_MAX_ARGS) {
+        nargs = ELOG_BIN_MAX_ARGS;
+    }
+    words = ELOG_BIN_REC_HDR_WORDS + nargs;
+
+    /* reserve space */
+    head = __atomic_load_n(&ring_head, __ATOMIC_RELAXED);
+    do {
+        if (head + words - __atomic_load_n(&ring_tail, __ATOMIC_ACQUIRE) > ELOG_BIN_RING_WORDS) {
+            __atomic_add_fetch(&drop_count, 1, __ATOMIC_RELAXED);
+            return;
+        }
+    } while (!__atomic_compare_exchange_n(&ring_head, &head, head + words, true, __ATOMIC_ACQUIRE,
+                                          __ATOMIC_RELAXED));
+
+    /* fill body, then publish by header */
+    ring[(head + 1) & RING_MASK] = elog_bin_port_get_us();
+    ring[(head + 2) & RING_MASK] = (uint32_t)(uintptr_t)format;
+    ring[(head + 3) & RING_MASK] = (uint32_t)(uintptr_t)tag;
+    for (i = 0; i < nargs; i++) {
+        ring[(head + ELOG_BIN_REC_HDR_WORDS + i) & RING_MASK] = args[i];
+    }
+    __atomic_store_n(&ring[head & RING_MASK], ELOG_BIN_HDR_MARK | ((uint32_t)level << 8) | nargs,
+                     __ATOMIC_RELEASE);
+}
+
+/**
+ * encode words as an output frame
+ *
+ * @return frame size
+ */
+static size_t bin_encode_frame(uint8_t *frame, const uint32_t *words, uint32_t count) {
+    size_t len = 0;
+    uint8_t sum = 0;
+    uint32_t i, j;
+
+    frame[len++] = ELOG_BIN_SYNC0;
+    frame[len++] = ELOG_BIN_SYNC1;
+    frame[len++] = (uint8_t)count;
+    for (i = 0; i < count; i++) {
+        for (j = 0; j < 4; j++) {
+            uint8_t byte = (uint8_t)(words[i] >> (8 * j));
+            frame[len++] = byte;
+            sum ^= byte;
+        }
+    }
+    frame[len++] = sum;
+
+    return len;
+}
+
+/**
+ * get the next committed record as an output frame, only the elog output task can call it
+ *
+ * @param frame output frame buffer
+ * @param size buffer size, must be at least ELOG_BIN_FRAME_MAX_SIZE
+ *
+ * @return frame size, 0 if no committed record
+ */
+size_t elog_bin_get_frame(uint8_t *frame, size_t size) {
+    uint32_t words[ELOG_BIN_REC_HDR_WORDS + ELOG_BIN_MAX_ARGS];
+    uint32_t tail, hdr, count, drops, i;
+
+    if (size < ELOG_BIN_FRAME_MAX_SIZE) {
+        return 0;
+    }
+
+    /* report lost records as a record with null format */
+    drops = drop_count;
+    if (drops != drop_reported) {
+        words[0] = ELOG_BIN_HDR_MARK | ((uint32_t)ELOG_LVL_WARN << 8) | 1;
+        words[1] = elog_bin_port_get_us();
+        words[2] = 0;
+        words[3] = 0;
+        words[4] = drops - drop_reported;
+        drop_reported = drops;
+        return bin_encode_frame(frame, words, ELOG_BIN_REC_HDR_WORDS + 1);
+    }
+
+    tail = ring_tail;
+    hdr = __atomic_load_n(&ring[tail & RING_MASK], __ATOMIC_ACQUIRE);
+    if (!HDR_IS_VALID(hdr)) {
+        /* empty or the producer hasn't committed yet */
+        return 0;
+    }
+
+    count = ELOG_BIN_REC_HDR_WORDS + HDR_NARGS(hdr);
+    for (i = 0; i < count; i++) {
+        words[i] = ring[(tail + i) & RING_MASK];
+        ring[(tail + i) & RING_MASK] = 0;
+    }
+    __atomic_store_n(&ring_tail, tail + count, __ATOMIC_RELEASE);
+
+    return bin_encode_frame(frame, words, count);
+}
+
+/**
+ * get the number of records dropped since boot
+ */
+uint32_t elog_bin_get_drop_count(void) {
+    return drop_count;
+}
+
+#endif /* ELOG_BIN_ENABLE */
@@ -0,0 +1,94 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Function:  Binary deferred log plugin. Each call site stores the format string address, a us timestamp and the
+ *            raw 32-bit arguments into a lock-free ring, the formatting is done offline by
+ *            Scripts/elog_bin_decode.py with the firmware ELF.
+ */
+
+#ifndef __ELOG_BIN_H__
+#define __ELOG_BIN_H__
+
+#include <elog.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef ELOG_BIN_ENABLE
+
+/* record layout in 32-bit words: header, timestamp(us), format address, tag address, arguments */
+#define ELOG_BIN_REC_HDR_WORDS              4
+#define ELOG_BIN_MAX_ARGS                   8
+#define ELOG_BIN_HDR_MARK                   0xB1000000UL
+/* frame on the output stream: sync(2) + word count(1) + words + xor checksum(1) */
+#define ELOG_BIN_SYNC0                      0xA5
+#define ELOG_BIN_SYNC1                      0x5A
+#define ELOG_BIN_FRAME_MAX_SIZE             (3 + (ELOG_BIN_REC_HDR_WORDS + ELOG_BIN_MAX_ARGS) * 4 + 1)
+
+/* elog_bin.c */
+void elog_bin_write(uint8_t level, const char *tag, const char *format, const uint32_t *args, uint8_t nargs);
+size_t elog_bin_get_frame(uint8_t *frame, size_t size);
+uint32_t elog_bin_get_drop_count(void);
+
+/* elog_port.c, low 32 bits of a free running us counter */
+uint32_t elog_bin_port_get_us(void);
+
+/* argument counting and conversion, the first argument is the format, every other one takes a 32-bit word */
+#define ELOG_BIN_NARGS(...)                 ELOG_BIN_NARGS_(__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0, ~)
+#define ELOG_BIN_NARGS_(_f, _1, _2, _3, _4, _5, _6, _7, _8, n, ...) n
+#define ELOG_BIN_FORMAT(...)                ELOG_BIN_FORMAT_(__VA_ARGS__, ~)
+#define ELOG_BIN_FORMAT_(f, ...)            f
+#define ELOG_BIN_CAST(x)                    ((uint32_t)(uintptr_t)(x))
+#define ELOG_BIN_MAP_0(f)
+#define ELOG_BIN_MAP_1(f, a)                ELOG_BIN_CAST(a)
+#define ELOG_BIN_MAP_2(f, a, ...)           ELOG_BIN_CAST(a), ELOG_BIN_MAP_1(f, __VA_ARGS__)
+#define ELOG_BIN_MAP_3(f, a, ...)           ELOG_BIN_CAST(a), ELOG_BIN_MAP_2(f, __VA_ARGS__)
+#define ELOG_BIN_MAP_4(f, a, ...)           ELOG_BIN_CAST(a), ELOG_BIN_MAP_3(f, __VA_ARGS__)
+#define ELOG_BIN_MAP_5(f, a, ...)           ELOG_BIN_CAST(a), ELOG_BIN_MAP_4(f, __VA_ARGS__)
+#define ELOG_BIN_MAP_6(f, a, ...)           ELOG_BIN_CAST(a), ELOG_BIN_MAP_5(f, __VA_ARGS__)
+#define ELOG_BIN_MAP_7(f, a, ...)           ELOG_BIN_CAST(a), ELOG_BIN_MAP_6(f, __VA_ARGS__)
+#define ELOG_BIN_MAP_8(f, a, ...)           ELOG_BIN_CAST(a), ELOG_BIN_MAP_7(f, __VA_ARGS__)
+#define ELOG_BIN_MAP_N(n)                   ELOG_BIN_MAP_##n
+#define ELOG_BIN_MAP_(n)                    ELOG_BIN_MAP_N(n)
+#define ELOG_BIN_MAP(...)                   ELOG_BIN_MAP_(ELOG_BIN_NARGS(__VA_ARGS__))(__VA_ARGS__)
+
+/*
+ * format must be a string literal and %s arguments must point to constant strings in flash,
+ * 64-bit and floating point arguments are truncated to 32 bits
+ */
+#define elog_bin_output(level, tag, ...)                                                        \
+    do {                                                                                        \
+        if ((level) <= ELOG_OUTPUT_LVL) {                                                       \
+            const uint32_t _elog_bin_args[] = {0, ELOG_BIN_MAP(__VA_ARGS__)};                   \
+            elog_bin_write(level, tag, ELOG_BIN_FORMAT(__VA_ARGS__), &_elog_bin_args[1],        \
+                           ELOG_BIN_NARGS(__VA_ARGS__));                                        \
+        }                                                                                       \
+    } while (0)
+
+#define elog_bin_a(tag, ...)                elog_bin_output(ELOG_LVL_ASSERT, tag, __VA_ARGS__)
+#define elog_bin_e(tag, ...)                elog_bin_output(ELOG_LVL_ERROR, tag, __VA_ARGS__)
+#define elog_bin_w(tag, ...)                elog_bin_output(ELOG_LVL_WARN, tag, __VA_ARGS__)
+#define elog_bin_i(tag, ...)                elog_bin_output(ELOG_LVL_INFO, tag, __VA_ARGS__)
+#define elog_bin_d(tag, ...)                elog_bin_output(ELOG_LVL_DEBUG, tag, __VA_ARGS__)
+#define elog_bin_v(tag, ...)                elog_bin_output(ELOG_LVL_VERBOSE, tag, __VA_ARGS__)
+
+#else
+
+/* binary mode disabled, fall back to normal formatted output */
+#define elog_bin_a(tag, ...)                elog_a(tag, __VA_ARGS__)
+#define elog_bin_e(tag, ...)                elog_e(tag, __VA_ARGS__)
+#define elog_bin_w(tag, ...)                elog_w(tag, __VA_ARGS__)
+#define elog_bin_i(tag, ...)                elog_i(tag, __VA_ARGS__)
+#define elog_bin_d(tag, ...)                elog_d(tag, __VA_ARGS__)
+#define elog_bin_v(tag, ...)                elog_v(tag, __VA_ARGS__)
+
+#endif /* ELOG_BIN_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ELOG_BIN_H__ */
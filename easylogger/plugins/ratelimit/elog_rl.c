@@ -0,0 +1,42 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Function:  Per call site log rate limit. The token bucket is kept as a single theoretical arrival time, so one
+ *            CAS updates it and it's safe to call from any task or interrupt.
+ */
+
+#include <elog_rl.h>
+#include <stdbool.h>
+
+/**
+ * check whether a log of the call site may be output
+ *
+ * @param rl call site state
+ * @param interval_ms one token is refilled every interval_ms
+ * @param burst bucket size
+ * @param suppressed logs suppressed since the last allowed one, only valid when allowed
+ *
+ * @return 1: allowed, 0: suppressed
+ */
+int elog_rl_allow(elog_rl_t *rl, uint32_t interval_ms, uint32_t burst, uint32_t *suppressed) {
+    uint32_t now = elog_rl_port_get_ms();
+    uint32_t old, tat;
+
+    old = __atomic_load_n(&rl->tat, __ATOMIC_RELAXED);
+    do {
+        tat = old;
+        /* the bucket is full after a long enough idle time */
+        if ((int32_t)(now - tat) > 0) {
+            tat = now;
+        }
+        /* allowed while the next arrival stays within the burst window */
+        if ((int32_t)(tat - now) > (int32_t)((burst - 1) * interval_ms)) {
+            __atomic_add_fetch(&rl->suppressed, 1, __ATOMIC_RELAXED);
+            return 0;
+        }
+    } while (!__atomic_compare_exchange_n(&rl->tat, &old, tat + interval_ms, true, __ATOMIC_RELAXED,
+                                          __ATOMIC_RELAXED));
+
+    *suppressed = __atomic_exchange_n(&rl->suppressed, 0, __ATOMIC_RELAXED);
+    return 1;
+}
@@ -0,0 +1,56 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Function:  Per call site log rate limit. Every call site owns a static token bucket, logs over the budget are
+ *            counted and reported as "suppressed N messages" by the next log that passes.
+ */
+
+#ifndef __ELOG_RL_H__
+#define __ELOG_RL_H__
+
+#include <elog.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* call site state, must be zero initialized */
+typedef struct {
+    /* theoretical arrival time of the next log in ms (GCRA form of the token bucket) */
+    volatile uint32_t tat;
+    /* logs suppressed since the last one that passed */
+    volatile uint32_t suppressed;
+} elog_rl_t;
+
+/* elog_rl.c */
+int elog_rl_allow(elog_rl_t *rl, uint32_t interval_ms, uint32_t burst, uint32_t *suppressed);
+
+/* elog_port.c, free running ms counter */
+uint32_t elog_rl_port_get_ms(void);
+
+/*
+ * allow a burst of logs, then one log every interval_ms, the count of suppressed logs is reported at the same
+ * level before the next log that passes
+ */
+#define elog_rl_output(log, interval_ms, burst, tag, ...)                                       \
+    do {                                                                                        \
+        static elog_rl_t _elog_rl;                                                              \
+        uint32_t _elog_rl_suppressed;                                                           \
+        if (elog_rl_allow(&_elog_rl, interval_ms, burst, &_elog_rl_suppressed)) {               \
+            if (_elog_rl_suppressed) {                                                          \
+                log(tag, "suppressed %lu messages", (unsigned long)_elog_rl_suppressed);        \
+            }                                                                                   \
+            log(tag, __VA_ARGS__);                                                              \
+        }                                                                                       \
+    } while (0)
+
+#define elog_rl_e(tag, ...)                 elog_rl_output(elog_e, ELOG_RL_INTERVAL_MS, ELOG_RL_BURST, tag, __VA_ARGS__)
+#define elog_rl_w(tag, ...)                 elog_rl_output(elog_w, ELOG_RL_INTERVAL_MS, ELOG_RL_BURST, tag, __VA_ARGS__)
+#define elog_rl_i(tag, ...)                 elog_rl_output(elog_i, ELOG_RL_INTERVAL_MS, ELOG_RL_BURST, tag, __VA_ARGS__)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ELOG_RL_H__ */
@@ -27,14 +27,17 @@
  */
 
 #include <elog.h>
+#include <elog_bin.h>
+#include <elog_rl.h>
 #include <stdio.h>
+#include <string.h>
 
+#include "FreeRTOS.h"
 #include "cmsis_os2.h"
 #include "usart.h"
 
 extern osSemaphoreId_t elog_lockHandle;
 extern osSemaphoreId_t elog_asyncHandle;
-extern osSemaphoreId_t elog_dma_lockHandle;
 
 /**
  * EasyLogger port initialize
@@ -55,6 +58,115 @@ ElogErrCode elog_port_init(void) {
  */
 void elog_port_deinit(void) {}
 
+/* double buffered DMA output: one buffer is transferred while the other is filled, queued buffers are
+ * chained back to back from the DMA complete interrupt */
+#define ELOG_PORT_DMA_BUF_SIZE (ELOG_LINE_BUF_SIZE * 4)
+#define ELOG_PORT_NET_SINK_TICK_MS 100
+
+static char dma_buf[2][ELOG_PORT_DMA_BUF_SIZE];
+static size_t dma_len[2];
+/* submitted buffers in transfer order, the head one is on the wire */
+static volatile uint8_t dma_queue[2];
+static volatile uint8_t dma_queue_count = 0;
+/* buffers that are neither being filled nor queued, bit n for dma_buf[n]; set in the complete interrupt, so
+ * only changed with interrupts disabled. dma_free_sem counts the set bits */
+static volatile uint8_t dma_free_mask = 0x03;
+/* bytes lost because the UART refused a transfer */
+static volatile uint32_t dma_drop_bytes = 0;
+static osSemaphoreId_t dma_free_sem = NULL;
+#if RTOS_STATIC_ALLOC
+/* control blocks of the objects above, see User/Task/rtos_static.h */
+static StaticSemaphore_t dma_free_sem_cb __attribute__((section(".bss.rtos_static")));
+static const osSemaphoreAttr_t dma_free_sem_attr = {
+    .name = "elog_dma_free", .cb_mem = &dma_free_sem_cb, .cb_size = sizeof(dma_free_sem_cb)};
+#define DMA_FREE_SEM_ATTR (&dma_free_sem_attr)
+#else
+#define DMA_FREE_SEM_ATTR NULL
+#endif
+
+/**
+ * return a buffer to the free set, called with interrupts disabled
+ */
+static void elog_port_dma_free(uint8_t idx) {
+    dma_free_mask |= (uint8_t)(1U << idx);
+    osSemaphoreRelease(dma_free_sem);
+}
+
+/**
+ * start the transfer of the head buffer, called with interrupts disabled
+ */
+static void elog_port_dma_start(void) {
+    while (dma_queue_count) {
+        uint8_t idx = dma_queue[0];
+        if (HAL_UART_Transmit_DMA(&huart8, (uint8_t *)dma_buf[idx], dma_len[idx]) == HAL_OK) {
+            return;
+        }
+        /* refused, drop the buffer so that the chain doesn't stall */
+        dma_drop_bytes += dma_len[idx];
+        dma_queue[0] = dma_queue[1];
+        dma_queue_count--;
+        elog_port_dma_free(idx);
+    }
+}
+
+/**
+ * reserve a free DMA buffer, blocks while both buffers are being filled or in flight. The synchronous output path
+ * and the log task reserve concurrently and buffers complete in any order, so the free one is taken from
+ * dma_free_mask rather than alternated
+ *
+ * @return buffer index
+ */
+static uint8_t elog_port_dma_reserve(void) {
+    uint32_t primask;
+    uint8_t idx;
+
+    osSemaphoreAcquire(dma_free_sem, osWaitForever);
+    primask = __get_PRIMASK();
+    __disable_irq();
+    idx = (dma_free_mask & 0x01) ? 0 : 1;
+    dma_free_mask &= (uint8_t)~(1U << idx);
+    __set_PRIMASK(primask);
+
+    return idx;
+}
+
+/**
+ * queue a filled buffer, it's transferred at once if the UART is idle
+ */
+static void elog_port_dma_submit(uint8_t idx, size_t len) {
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    if (len == 0) {
+        elog_port_dma_free(idx);
+        __set_PRIMASK(primask);
+        return;
+    }
+    dma_len[idx] = len;
+    dma_queue[dma_queue_count++] = idx;
+    if (dma_queue_count == 1) {
+        elog_port_dma_start();
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * UART8 DMA transfer complete, called from HAL_UART_TxCpltCallback
+ */
+void elog_port_dma_tx_cplt(void) {
+    uint8_t idx;
+
+    if (dma_queue_count == 0) {
+        return;
+    }
+    idx = dma_queue[0];
+    dma_queue[0] = dma_queue[1];
+    dma_queue_count--;
+    elog_port_dma_free(idx);
+    /* chain the next buffer right away */
+    elog_port_dma_start();
+}
+
 /**
  * output log port interface
  *
@@ -62,8 +174,23 @@ void elog_port_deinit(void) {}
  * @param size log size
  */
 void elog_port_output(const char *log, size_t size) {
-    HAL_UART_Transmit_DMA(&huart8, (uint8_t *)log, size);
-    osSemaphoreAcquire(elog_dma_lockHandle, osWaitForever);
+    size_t len;
+    uint8_t idx;
+
+    /* the DMA chain is set up by the log task, output synchronously before that */
+    if (dma_free_sem == NULL || osKernelGetState() != osKernelRunning) {
+        HAL_UART_Transmit(&huart8, (uint8_t *)log, size, HAL_MAX_DELAY);
+        return;
+    }
+
+    while (size) {
+        len = size < ELOG_PORT_DMA_BUF_SIZE ? size : ELOG_PORT_DMA_BUF_SIZE;
+        idx = elog_port_dma_reserve();
+        memcpy(dma_buf[idx], log, len);
+        elog_port_dma_submit(idx, len);
+        log += len;
+        size -= len;
+    }
 }
 
 /**
@@ -105,31 +232,124 @@ const char *elog_port_get_t_info(void) { return ""; }
 
 void elog_async_output_notice(void) { osSemaphoreRelease(elog_asyncHandle); }
 
-void elog_entry(void *para) {
-    size_t get_log_size = 0;
+#ifdef ELOG_BIN_ENABLE
+/**
+ * get binary log timestamp, TIM2 is the free running 32-bit 1MHz counter of hptimer
+ *
+ * @return current us
+ */
+uint32_t elog_bin_port_get_us(void) { return TIM2->CNT; }
+
+#endif
+
+/**
+ * get rate limit time base
+ *
+ * @return current ms
+ */
+uint32_t elog_rl_port_get_ms(void) { return osKernelGetTickCount(); }
+
+/**
+ * append a notice when logs were dropped since the last report
+ *
+ * @return appended size
+ */
+static size_t elog_port_drop_notice(char *buf, size_t size) {
+    static uint32_t reported_count = 0, reported_bytes = 0, reported_dma = 0;
+    uint32_t count, bytes, dma;
+    int len;
+
+    count = elog_async_get_drop_count(&bytes);
+    dma = dma_drop_bytes;
+    if (count == reported_count && dma == reported_dma) {
+        return 0;
+    }
+    len = snprintf(buf, size, "elog: dropped %lu logs (%lu bytes), %lu bytes refused by uart" ELOG_NEWLINE_SIGN,
+                   (unsigned long)(count - reported_count), (unsigned long)(bytes - reported_bytes),
+                   (unsigned long)(dma - reported_dma));
+    if (len <= 0 || (size_t)len >= size) {
+        return 0;
+    }
+    reported_count = count;
+    reported_bytes = bytes;
+    reported_dma = dma;
+
+    return (size_t)len;
+}
+
+/**
+ * gather as many complete lines (and binary frames) as fit into one DMA buffer
+ *
+ * @return gathered size
+ */
+static size_t elog_port_gather(char *buf, size_t size) {
+    size_t len = 0, get_size;
+
+    len += elog_port_drop_notice(buf, size);
+    /* only whole lines, so that a line is never split by a binary frame */
+    while (size - len >= ELOG_LINE_BUF_SIZE) {
 #ifdef ELOG_ASYNC_LINE_OUTPUT
-    static char poll_get_buf[ELOG_LINE_BUF_SIZE - 4];
+        get_size = elog_async_get_line_log(buf + len, ELOG_LINE_BUF_SIZE);
 #else
-    static char poll_get_buf[ELOG_ASYNC_OUTPUT_BUF_SIZE - 4];
+        get_size = elog_async_get_log(buf + len, ELOG_LINE_BUF_SIZE);
 #endif
+        if (get_size == 0) {
+            break;
+        }
+        len += get_size;
+    }
+#ifdef ELOG_BIN_ENABLE
+    /* text drained, fill the rest with binary frames */
+    if (size - len >= ELOG_LINE_BUF_SIZE) {
+        while (size - len >= ELOG_BIN_FRAME_MAX_SIZE) {
+            get_size = elog_bin_get_frame((uint8_t *)buf + len, size - len);
+            if (get_size == 0) {
+                break;
+            }
+            len += get_size;
+        }
+    }
+#endif
+
+    return len;
+}
+
+/* optional network sink, called by the output task with every gathered batch */
+static void (*volatile net_sink)(const char *log, size_t size) = NULL;
+
+/**
+ * register a sink which receives a copy of every batch written to the UART, it's called in the elog output task
+ * context, with a zero size on every wake up so that the sink can flush by time
+ *
+ * @param sink sink function, NULL to remove
+ */
+void elog_port_set_net_sink(void (*sink)(const char *log, size_t size)) { net_sink = sink; }
+
+void elog_entry(void *para) {
+    size_t get_log_size = 0;
+    uint8_t idx;
+    void (*sink)(const char *log, size_t size);
+
+    dma_free_sem = osSemaphoreNew(2, 2, DMA_FREE_SEM_ATTR);
 
     for (;;) {
         /* waiting log */
-        osSemaphoreAcquire(elog_asyncHandle, osWaitForever);
-        /* polling gets and outputs the log */
-        while (1) {
-#ifdef ELOG_ASYNC_LINE_OUTPUT
-            get_log_size =
-                elog_async_get_line_log(poll_get_buf, sizeof(poll_get_buf));
+#ifdef ELOG_BIN_ENABLE
+        /* binary log producers don't notify, poll them periodically */
+        osSemaphoreAcquire(elog_asyncHandle, ELOG_BIN_FLUSH_MS);
 #else
-            get_log_size =
-                elog_async_get_log(poll_get_buf, sizeof(poll_get_buf));
+        /* the network sink flushes by time, wake up periodically while it's registered */
+        osSemaphoreAcquire(elog_asyncHandle, net_sink ? ELOG_PORT_NET_SINK_TICK_MS : osWaitForever);
 #endif
-            if (get_log_size) {
-                elog_port_output(poll_get_buf, get_log_size);
-            } else {
-                break;
+        /* gather batches into the free buffer while the other one is on the wire */
+        do {
+            idx = elog_port_dma_reserve();
+            get_log_size = elog_port_gather(dma_buf[idx], ELOG_PORT_DMA_BUF_SIZE);
+            sink = net_sink;
+            if (sink) {
+                sink(dma_buf[idx], get_log_size);
             }
-        }
+            elog_port_dma_submit(idx, get_log_size);
+        } while (get_log_size);
     }
 }
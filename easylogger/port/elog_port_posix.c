@@ -0,0 +1,118 @@
+/*
+ * This file is part of the EasyLogger Library.
+ *
+ * Copyright (c) 2015, Armink, <armink.ztl@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * 'Software'), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED 'AS IS', WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Function: Portable interface for native (POSIX host) builds, selected with FREERTOSCPP_PORT=POSIX.
+ *           Logs are written synchronously to stdout, async and binary modes are disabled in elog_cfg.h.
+ */
+
+#define _GNU_SOURCE /* pthread_getname_np */
+
+#include <elog.h>
+#include <elog_rl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+static pthread_mutex_t output_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @return ms since an arbitrary point, from the monotonic clock
+ */
+static uint32_t elog_port_get_ms(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000U + (uint64_t)ts.tv_nsec / 1000000U);
+}
+
+/**
+ * EasyLogger port initialize
+ *
+ * @return result
+ */
+ElogErrCode elog_port_init(void) {
+    /* line buffered so that logs of a crashed run aren't lost */
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    return ELOG_NO_ERR;
+}
+
+/**
+ * EasyLogger port deinitialize
+ *
+ */
+void elog_port_deinit(void) { fflush(stdout); }
+
+/**
+ * output log port interface
+ *
+ * @param log output of log
+ * @param size log size
+ */
+void elog_port_output(const char *log, size_t size) { fwrite(log, 1, size, stdout); }
+
+/**
+ * output lock
+ */
+void elog_port_output_lock(void) { pthread_mutex_lock(&output_lock); }
+
+/**
+ * output unlock
+ */
+void elog_port_output_unlock(void) { pthread_mutex_unlock(&output_lock); }
+
+/**
+ * get current time interface
+ *
+ * @return current time
+ */
+const char *elog_port_get_time(void) {
+    static __thread char cur_system_time[16] = "";
+    snprintf(cur_system_time, 16, "%lu", (unsigned long)elog_port_get_ms());
+    return cur_system_time;
+}
+
+/**
+ * get current process name interface
+ *
+ * @return current process name
+ */
+const char *elog_port_get_p_info(void) { return ""; }
+
+/**
+ * get current thread name interface
+ *
+ * @return current thread name
+ */
+const char *elog_port_get_t_info(void) {
+    static __thread char name[16] = "";
+    pthread_getname_np(pthread_self(), name, sizeof(name));
+    return name;
+}
+
+/**
+ * get rate limit time base
+ *
+ * @return current ms
+ */
+uint32_t elog_rl_port_get_ms(void) { return elog_port_get_ms(); }
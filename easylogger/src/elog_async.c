@@ -78,6 +78,10 @@ static pthread_t async_output_thread;
 #define OUTPUT_BUF_SIZE                          (ELOG_LINE_BUF_SIZE * 10)
 #endif /* ELOG_ASYNC_OUTPUT_BUF_SIZE */
 
+#ifndef ELOG_ASYNC_OUTPUT_BUF_ATTR
+#define ELOG_ASYNC_OUTPUT_BUF_ATTR
+#endif /* ELOG_ASYNC_OUTPUT_BUF_ATTR */
+
 /* Initialize OK flag */
 static bool init_ok = false;
 #ifdef ELOG_ASYNC_OUTPUT_USING_PTHREAD
@@ -87,7 +91,7 @@ static bool thread_running = false;
 /* asynchronous output mode enabled flag */
 static bool is_enabled = false;
 /* asynchronous output mode's ring buffer */
-static char log_buf[OUTPUT_BUF_SIZE] = { 0 };
+static char log_buf[OUTPUT_BUF_SIZE] ELOG_ASYNC_OUTPUT_BUF_ATTR = { 0 };
 /* log ring buffer write index */
 static size_t write_index = 0;
 /* log ring buffer read index */
@@ -96,6 +100,9 @@ static size_t read_index = 0;
 static bool buf_is_full = false;
 /* log ring buffer empty flag */
 static bool buf_is_empty = true;
+/* logs and bytes dropped because the ring buffer was full */
+static uint32_t drop_count = 0;
+static uint32_t drop_bytes = 0;
 
 extern void elog_port_output(const char *log, size_t size);
 extern void elog_output_lock(void);
@@ -141,14 +148,14 @@ static size_t async_put_log(const char *log, size_t size) {
     size_t space = 0;
 
     space = async_get_buf_space();
-    /* no space */
-    if (!space) {
+    /* no space for the whole log, drop it so that the output never contains a partial line */
+    if (space < size) {
+        drop_count++;
+        drop_bytes += size;
         size = 0;
         goto __exit;
     }
-    /* drop some log */
-    if (space <= size) {
-        size = space;
+    if (space == size) {
         buf_is_full = true;
     }
 
@@ -264,6 +271,26 @@ __exit:
 }
 #endif /* ELOG_ASYNC_LINE_OUTPUT */
 
+/**
+ * get the number of logs dropped because the asynchronous output buffer was full
+ *
+ * @param bytes dropped bytes, can be NULL
+ *
+ * @return dropped logs
+ */
+uint32_t elog_async_get_drop_count(uint32_t *bytes) {
+    uint32_t count;
+
+    elog_output_lock();
+    count = drop_count;
+    if (bytes) {
+        *bytes = drop_bytes;
+    }
+    elog_output_unlock();
+
+    return count;
+}
+
 void elog_async_output(uint8_t level, const char *log, size_t size) {
     /* this function must be implement by user when ELOG_ASYNC_OUTPUT_USING_PTHREAD is not defined */
     extern void elog_async_output_notice(void);
@@ -45,7 +45,9 @@ enum class Backend2MasterMessageId : uint8_t {
     PING_CTRL_MSG = 0x10,
     DEVICE_LIST_REQ_MSG = 0x11,
     CLEAR_DEVICE_LIST_MSG = 0x12,
-    SET_UWB_CHAN_MSG = 0x13
+    SET_UWB_CHAN_MSG = 0x13,
+    SYS_STATS_REQ_MSG = 0x14,
+    CYCLE_PROF_REQ_MSG = 0x15
 };
 
 // Master2Backend Message ID 枚举
@@ -57,7 +59,9 @@ enum class Master2BackendMessageId : uint8_t {
     PING_RES_MSG = 0x04,
     DEVICE_LIST_RSP_MSG = 0x05,
     INTERVAL_CFG_RSP_MSG = 0x06,
-    SET_UWB_CHAN_RSP_MSG = 0x13
+    SET_UWB_CHAN_RSP_MSG = 0x13,
+    SYS_STATS_RSP_MSG = 0x14,
+    CYCLE_PROF_RSP_MSG = 0x15
 };
 
 // Slave2Backend Message ID 枚举
@@ -231,6 +231,12 @@ std::unique_ptr<Message> ProtocolProcessor::createMessage(PacketId packetId,
                 case Backend2MasterMessageId::SET_UWB_CHAN_MSG:
                     return std::make_unique<
                         Backend2Master::SetUwbChannelMessage>();
+                case Backend2MasterMessageId::SYS_STATS_REQ_MSG:
+                    return std::make_unique<
+                        Backend2Master::SysStatsReqMessage>();
+                case Backend2MasterMessageId::CYCLE_PROF_REQ_MSG:
+                    return std::make_unique<
+                        Backend2Master::CycleProfReqMessage>();
             }
             break;
 
@@ -260,6 +266,12 @@ std::unique_ptr<Message> ProtocolProcessor::createMessage(PacketId packetId,
                 case Master2BackendMessageId::SET_UWB_CHAN_RSP_MSG:
                     return std::make_unique<
                         Master2Backend::SetUwbChannelResponseMessage>();
+                case Master2BackendMessageId::SYS_STATS_RSP_MSG:
+                    return std::make_unique<
+                        Master2Backend::SysStatsResponseMessage>();
+                case Master2BackendMessageId::CYCLE_PROF_RSP_MSG:
+                    return std::make_unique<
+                        Master2Backend::CycleProfResponseMessage>();
             }
             break;
 
@@ -160,6 +160,18 @@ bool DeviceListReqMessage::deserialize(const std::vector<uint8_t> &data) {
     return true;
 }
 
+// CycleProfReqMessage 实现
+std::vector<uint8_t> CycleProfReqMessage::serialize() const {
+    return {reset};
+}
+
+bool CycleProfReqMessage::deserialize(const std::vector<uint8_t> &data) {
+    if (data.size() < 1)
+        return false;
+    reset = data[0];
+    return true;
+}
+
 // ClearDeviceListMessage 实现
 std::vector<uint8_t> ClearDeviceListMessage::serialize() const {
     return {reserve};
@@ -190,5 +202,17 @@ bool SetUwbChannelMessage::deserialize(const std::vector<uint8_t> &data) {
     return true;
 }
 
+// SysStatsReqMessage 实现
+std::vector<uint8_t> SysStatsReqMessage::serialize() const {
+    return {reserve};
+}
+
+bool SysStatsReqMessage::deserialize(const std::vector<uint8_t> &data) {
+    if (data.size() < 1)
+        return false;
+    reserve = data[0];
+    return true;
+}
+
 } // namespace Backend2Master
 } // namespace WhtsProtocol
\ No newline at end of file
@@ -156,6 +156,36 @@ class SetUwbChannelMessage : public Message {
     }
 };
 
+class SysStatsReqMessage : public Message {
+   public:
+    uint8_t reserve;
+
+    std::vector<uint8_t> serialize() const override;
+    bool deserialize(const std::vector<uint8_t> &data) override;
+    uint8_t getMessageId() const override {
+        return static_cast<uint8_t>(
+            Backend2MasterMessageId::SYS_STATS_REQ_MSG);
+    }
+    const char* getMessageTypeName() const override {
+        return "System Stats Request";
+    }
+};
+
+class CycleProfReqMessage : public Message {
+   public:
+    uint8_t reset;  // 1: 读取后清零统计
+
+    std::vector<uint8_t> serialize() const override;
+    bool deserialize(const std::vector<uint8_t> &data) override;
+    uint8_t getMessageId() const override {
+        return static_cast<uint8_t>(
+            Backend2MasterMessageId::CYCLE_PROF_REQ_MSG);
+    }
+    const char* getMessageTypeName() const override {
+        return "Cycle Profile Request";
+    }
+};
+
 }    // namespace Backend2Master
 }    // namespace WhtsProtocol
 
@@ -1,5 +1,7 @@
 #include "Master2Backend.h"
 
+#include <algorithm>
+
 namespace WhtsProtocol {
 namespace Master2Backend {
 
@@ -221,5 +223,122 @@ bool SetUwbChannelResponseMessage::deserialize(const std::vector<uint8_t> &data)
     return true;
 }
 
+// SysStatsResponseMessage 实现
+std::vector<uint8_t> SysStatsResponseMessage::serialize() const {
+    std::vector<uint8_t> result;
+    ByteUtils::writeUint32LE(result, periodMs);
+    ByteUtils::writeUint16LE(result, cpuLoadPermille);
+    ByteUtils::writeUint32LE(result, freeHeap);
+    ByteUtils::writeUint32LE(result, minFreeHeap);
+    result.push_back(taskCount);
+
+    for (const auto &task : tasks) {
+        result.insert(result.end(), task.name, task.name + TASK_NAME_LEN);
+        result.push_back(task.priority);
+        ByteUtils::writeUint16LE(result, task.cpuPermille);
+        ByteUtils::writeUint32LE(result, task.stackFreeMin);
+        ByteUtils::writeUint32LE(result, task.switchesPerSec);
+    }
+
+    return result;
+}
+
+bool SysStatsResponseMessage::deserialize(const std::vector<uint8_t> &data) {
+    if (data.size() < 15)
+        return false;
+
+    periodMs = ByteUtils::readUint32LE(data, 0);
+    cpuLoadPermille = ByteUtils::readUint16LE(data, 4);
+    freeHeap = ByteUtils::readUint32LE(data, 6);
+    minFreeHeap = ByteUtils::readUint32LE(data, 10);
+    taskCount = data[14];
+    tasks.clear();
+
+    size_t offset = 15;
+    for (uint8_t i = 0; i < taskCount; ++i) {
+        if (offset + TASK_NAME_LEN + 11 > data.size())
+            return false; // Each task info is 27 bytes
+
+        TaskInfo task;
+        std::copy(data.begin() + offset, data.begin() + offset + TASK_NAME_LEN, task.name);
+        task.name[TASK_NAME_LEN - 1] = '\0';
+        offset += TASK_NAME_LEN;
+        task.priority = data[offset];
+        task.cpuPermille = ByteUtils::readUint16LE(data, offset + 1);
+        task.stackFreeMin = ByteUtils::readUint32LE(data, offset + 3);
+        task.switchesPerSec = ByteUtils::readUint32LE(data, offset + 7);
+
+        tasks.push_back(task);
+        offset += 11;
+    }
+
+    return true;
+}
+
+// CycleProfResponseMessage 实现
+std::vector<uint8_t> CycleProfResponseMessage::serialize() const {
+    std::vector<uint8_t> result;
+    ByteUtils::writeUint32LE(result, clockHz);
+    ByteUtils::writeUint32LE(result, slotUs);
+    result.push_back(histNum);
+    result.push_back(probeCount);
+
+    for (const auto &probe : probes) {
+        result.insert(result.end(), probe.name, probe.name + PROBE_NAME_LEN);
+        ByteUtils::writeUint32LE(result, probe.budget);
+        ByteUtils::writeUint32LE(result, probe.count);
+        ByteUtils::writeUint32LE(result, probe.overBudget);
+        ByteUtils::writeUint32LE(result, probe.min);
+        ByteUtils::writeUint32LE(result, probe.max);
+        ByteUtils::writeUint32LE(result, static_cast<uint32_t>(probe.total));
+        ByteUtils::writeUint32LE(result, static_cast<uint32_t>(probe.total >> 32));
+        for (uint8_t i = 0; i < histNum; ++i) {
+            ByteUtils::writeUint32LE(result, i < probe.hist.size() ? probe.hist[i] : 0);
+        }
+    }
+
+    return result;
+}
+
+bool CycleProfResponseMessage::deserialize(const std::vector<uint8_t> &data) {
+    if (data.size() < 10)
+        return false;
+
+    clockHz = ByteUtils::readUint32LE(data, 0);
+    slotUs = ByteUtils::readUint32LE(data, 4);
+    histNum = data[8];
+    probeCount = data[9];
+    probes.clear();
+
+    size_t offset = 10;
+    size_t probeSize = PROBE_NAME_LEN + 28 + histNum * 4;
+    for (uint8_t i = 0; i < probeCount; ++i) {
+        if (offset + probeSize > data.size())
+            return false;
+
+        ProbeInfo probe;
+        std::copy(data.begin() + offset, data.begin() + offset + PROBE_NAME_LEN, probe.name);
+        probe.name[PROBE_NAME_LEN - 1] = '\0';
+        offset += PROBE_NAME_LEN;
+        probe.budget = ByteUtils::readUint32LE(data, offset);
+        probe.count = ByteUtils::readUint32LE(data, offset + 4);
+        probe.overBudget = ByteUtils::readUint32LE(data, offset + 8);
+        probe.min = ByteUtils::readUint32LE(data, offset + 12);
+        probe.max = ByteUtils::readUint32LE(data, offset + 16);
+        probe.total = ByteUtils::readUint32LE(data, offset + 20) |
+                      (static_cast<uint64_t>(ByteUtils::readUint32LE(data, offset + 24)) << 32);
+        offset += 28;
+        probe.hist.resize(histNum);
+        for (uint8_t b = 0; b < histNum; ++b) {
+            probe.hist[b] = ByteUtils::readUint32LE(data, offset);
+            offset += 4;
+        }
+
+        probes.push_back(probe);
+    }
+
+    return true;
+}
+
 } // namespace Master2Backend
 } // namespace WhtsProtocol
\ No newline at end of file
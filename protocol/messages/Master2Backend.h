@@ -158,6 +158,68 @@ class SetUwbChannelResponseMessage : public Message {
     }
 };
 
+class SysStatsResponseMessage : public Message {
+  public:
+    static constexpr size_t TASK_NAME_LEN = 16;
+
+    struct TaskInfo {
+        char name[TASK_NAME_LEN];  // 任务名，不足补0
+        uint8_t priority;
+        uint16_t cpuPermille;      // CPU占用，千分比
+        uint32_t stackFreeMin;     // 栈历史最小剩余字节数
+        uint32_t switchesPerSec;   // 每秒切入次数
+    };
+
+    uint32_t periodMs;        // 统计周期
+    uint16_t cpuLoadPermille; // 总CPU占用，千分比
+    uint32_t freeHeap;        // 当前剩余堆
+    uint32_t minFreeHeap;     // 历史最小剩余堆
+    uint8_t taskCount;
+    std::vector<TaskInfo> tasks;
+
+    std::vector<uint8_t> serialize() const override;
+    bool deserialize(const std::vector<uint8_t> &data) override;
+    uint8_t getMessageId() const override {
+        return static_cast<uint8_t>(
+            Master2BackendMessageId::SYS_STATS_RSP_MSG);
+    }
+    const char* getMessageTypeName() const override {
+        return "System Stats Response";
+    }
+};
+
+class CycleProfResponseMessage : public Message {
+  public:
+    static constexpr size_t PROBE_NAME_LEN = 16;
+
+    struct ProbeInfo {
+        char name[PROBE_NAME_LEN];   // 探针名，不足补0
+        uint32_t budget;             // 预算周期数，0表示未设置
+        uint32_t count;
+        uint32_t overBudget;         // 超出预算的次数
+        uint32_t min;                // 周期数
+        uint32_t max;
+        uint64_t total;
+        std::vector<uint32_t> hist;  // log2直方图，长度为histNum
+    };
+
+    uint32_t clockHz;   // 计数频率，0表示固件未开启CYCLE_PROFILE
+    uint32_t slotUs;    // TDMA时隙间隔
+    uint8_t histNum;    // 每个探针的直方图项数
+    uint8_t probeCount;
+    std::vector<ProbeInfo> probes;
+
+    std::vector<uint8_t> serialize() const override;
+    bool deserialize(const std::vector<uint8_t> &data) override;
+    uint8_t getMessageId() const override {
+        return static_cast<uint8_t>(
+            Master2BackendMessageId::CYCLE_PROF_RSP_MSG);
+    }
+    const char* getMessageTypeName() const override {
+        return "Cycle Profile Response";
+    }
+};
+
 } // namespace Master2Backend
 } // namespace WhtsProtocol
 